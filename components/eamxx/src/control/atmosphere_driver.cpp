@@ -8,7 +8,10 @@
 #include "share/atm_process/atmosphere_process_group.hpp"
 #include "share/atm_process/atmosphere_process_dag.hpp"
 #include "share/field/field_utils.hpp"
+#include "share/grid/remap/horiz_interp_remapper_data.hpp"
 #include "share/util/eamxx_time_stamp.hpp"
+#include "share/util/eamxx_runtime_stats.hpp"
+#include "share/util/eamxx_team_policy_tuner.hpp"
 #include "share/util/eamxx_timing.hpp"
 #include "share/util/eamxx_utils.hpp"
 #include "share/io/eamxx_io_utils.hpp"
@@ -149,6 +152,19 @@ init_scorpio(const int atm_id)
   // not be, depending on what scorpio does.
   init_gptl(m_gptl_externally_handled);
 
+  // If requested, trace the timed regions, to be inspected with chrome://tracing or Perfetto
+  const auto& driver_options_pl = m_atm_params.sublist("driver_options");
+  if (driver_options_pl.get<std::string>("event_trace_file","")!="") {
+    init_event_tracer(m_atm_comm,driver_options_pl.get<int>("event_trace_capacity",100000));
+  }
+
+  // Per-step metrics (e.g., memory usage) are reduced and logged at this cadence
+  init_runtime_stats(m_atm_comm,driver_options_pl.get<int>("runtime_stats_frequency",1),m_atm_logger);
+
+  // Launch configs of registered kernels, possibly tuned online and stored across runs
+  init_team_policy_tuner(m_atm_comm,driver_options_pl.get<std::string>("team_policy_tuning","off"),
+                         driver_options_pl.get<std::string>("team_policy_cache_file","eamxx_team_policies.txt"));
+
   m_ad_status |= s_scorpio_inited;
 }
 
@@ -697,6 +713,9 @@ void AtmosphereDriver::create_output_managers () {
 
   auto& io_params = m_atm_params.sublist("scorpio");
 
+  // If set, horiz remappers store the data read from map files, and reuse it in later runs
+  HorizRemapperData::set_cache_dir(io_params.get<std::string>("horiz_remap_cache_dir",""));
+
   ekat::ParameterList checkpoint_params;
   checkpoint_params.set("frequency_units",std::string("never"));
   checkpoint_params.set("frequency",-1);
@@ -782,6 +801,12 @@ void AtmosphereDriver::initialize_output_managers () {
     }
   }
 
+  // If requested, let output managers share diagnostics, remaps, and file flushes
+  auto& io_params = m_atm_params.sublist("scorpio");
+  if (io_params.get("share_output_work",false)) {
+    m_output_coordinator = std::make_shared<OutputCoordinator>();
+  }
+
   // Setup output managers
   for (auto& om : m_output_managers) {
     EKAT_REQUIRE_MSG(not om.is_restart(),
@@ -789,6 +814,9 @@ void AtmosphereDriver::initialize_output_managers () {
                      "output should be setup in m_restart_output_manager./n");
 
     om.set_logger(m_atm_logger);
+    if (m_output_coordinator) {
+      om.set_output_coordinator(m_output_coordinator);
+    }
     om.setup(m_field_mgr,m_grids_manager->get_grid_names());
   }
 
@@ -1669,19 +1697,21 @@ void AtmosphereDriver::run (const int dt) {
   for (auto& out_mgr : m_output_managers) {
     out_mgr.run(m_current_ts);
   }
+  if (m_output_coordinator) {
+    m_output_coordinator->end_step();
+  }
 
 #ifdef SCREAM_HAS_MEMORY_USAGE
-  long long my_mem_usage = get_mem_usage(MB);
-  long long max_mem_usage;
-  m_atm_comm.all_reduce(&my_mem_usage,&max_mem_usage,1,MPI_MAX);
-  m_atm_logger->info("[EAMxx::run] memory usage: " + std::to_string(max_mem_usage) + "MB");
+  record_runtime_stat("[EAMxx::run] memory usage",get_mem_usage(MB),"MB");
 #endif
 
-  // Flush the logger at least once per time step.
+  // Flush the logger at least once per runtime stats window (by default, every step).
   // Without this flush, depending on how much output we are loggin,
   // it might be several time steps before the file is updated.
   // This way, we give the user a chance to follow the log more real-time.
-  m_atm_logger->flush();
+  if (runtime_stats_end_step(m_current_ts.get_num_steps())) {
+    m_atm_logger->flush();
+  }
 
   stop_timer("EAMxx::run");
 }
@@ -1704,6 +1734,7 @@ void AtmosphereDriver::finalize ( /* inputs? */ ) {
     out_mgr.finalize();
   }
   m_output_managers.clear();
+  m_output_coordinator = nullptr;
 
   // Finalize, and then destroy all atmosphere processes
   if (m_atm_process_group.get()) {
@@ -1727,6 +1758,15 @@ void AtmosphereDriver::finalize ( /* inputs? */ ) {
   // Destroy all the fields manager
   m_field_mgr->clean_up();
 
+  // Log the runtime stats not yet reduced
+  finalize_runtime_stats();
+  finalize_team_policy_tuner();
+
+  // Write the event trace (if any) to file
+  if (is_event_tracer_inited()) {
+    finalize_event_tracer(m_atm_params.sublist("driver_options").get<std::string>("event_trace_file"));
+  }
+
   // Write all timers to file, and possibly finalize gptl
   if (not m_gptl_externally_handled) {
     write_timers_to_file (m_atm_comm,"eamxx_timing.txt");
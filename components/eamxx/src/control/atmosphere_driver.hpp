@@ -202,6 +202,9 @@ protected:
   std::shared_ptr<OutputManager>            m_restart_output_manager;
   std::list<OutputManager>                  m_output_managers;
 
+  // Shared by the output managers, to avoid redundant output work (e.g., same diag in two streams)
+  std::shared_ptr<OutputCoordinator>        m_output_coordinator;
+
   std::shared_ptr<ATMBufferManager>         m_memory_buffer;
   std::shared_ptr<SCDataManager>            m_surface_coupling_import_data_manager;
   std::shared_ptr<SCDataManager>            m_surface_coupling_export_data_manager;
@@ -64,12 +64,47 @@ void HorizAvgDiag::initialize_impl(const RunType /*run_type*/) {
 void HorizAvgDiag::compute_diagnostic_impl() {
   const auto &f = get_fields_in().front();
   const auto &d = m_diagnostic_output;
+  const bool masked = f.get_header().has_extra_data("mask_data");
+  if (m_sum_batch) {
+    // Compute the local sums, and let the batch do the global reduction
+    if (masked) {
+      // Sum the masked field and the mask separately, and divide once they are reduced
+      const auto &mask = f.get_header().get_extra_data<Field>("mask_data");
+      horiz_contraction<Real, false>(d, f, m_scaled_area);
+      horiz_contraction<Real, false>(m_dummy_field, mask, m_scaled_area);
+      m_sum_batch->add(d);
+      m_sum_batch->add(m_dummy_field, [this]() { finalize_masked_avg(); });
+    } else {
+      horiz_contraction<Real>(d, f, m_scaled_area);
+      m_sum_batch->add(d);
+    }
+    return;
+  }
+
   // Call the horiz_contraction impl that will take care of everything
-  if (f.get_header().has_extra_data("mask_data")) {
+  if (masked) {
     horiz_contraction<Real>(d, f, m_scaled_area, &m_comm, m_dummy_field);
   } else {
     horiz_contraction<Real>(d, f, m_scaled_area, &m_comm);
   }
 }
 
+void HorizAvgDiag::finalize_masked_avg() {
+  // Same as what horiz_contraction does after the global sums: d = n/w where w!=0
+  const auto &d          = m_diagnostic_output;
+  const int size         = d.get_header().get_identifier().get_layout().size();
+  const Real fill_value  = d.get_header().get_extra_data<Real>("mask_value");
+  const auto &d_mask     = d.get_header().get_extra_data<Field>("mask_data");
+  using view_t = KokkosTypes<DefaultDevice>::view_1d<Real>;
+  view_t v_out (d.get_internal_view_data<Real>(), size);
+  view_t v_mask(d_mask.get_internal_view_data<Real>(), size);
+  view_t v_w   (m_dummy_field.get_internal_view_data<Real>(), size);
+  Kokkos::parallel_for(
+      m_diag_name, Kokkos::RangePolicy<Field::device_t::execution_space>(0, size),
+      KOKKOS_LAMBDA(const int i) {
+        v_out(i)  = v_w(i) != 0 ? v_out(i) / v_w(i) : fill_value;
+        v_mask(i) = v_w(i) != 0 ? 1 : 0;
+      });
+}
+
 }  // namespace scream
@@ -28,6 +28,9 @@ class HorizAvgDiag : public AtmosphereDiagnostic {
 #endif
   void compute_diagnostic_impl();
 
+  // If global sums are batched, finish the masked average once they are done
+  void finalize_masked_avg();
+
  protected:
   void initialize_impl(const RunType /*run_type*/);
 
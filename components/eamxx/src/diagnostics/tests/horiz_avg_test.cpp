@@ -161,6 +161,80 @@ TEST_CASE("horiz_avg") {
   diag3->compute_diagnostic();
   auto diag3_f = diag3->get_diagnostic();
   REQUIRE(views_are_equal(diag3_f, diag3_manual));
+
+  // Batch the global sums of diag2 and diag3, and check we get the same answers
+  randomize(qc2, engine, pdf);
+  diag2->compute_diagnostic();
+  auto diag2_ref = diag2_f.clone();
+  auto diag3_ref = diag3_f.clone();
+  auto batch = std::make_shared<FieldSumBatch>(comm);
+  diag2->set_sum_batch(batch);
+  diag3->set_sum_batch(batch);
+  diag2->compute_diagnostic();
+  diag3->compute_diagnostic();
+  REQUIRE(batch->is_pending(diag2_f));
+  REQUIRE(batch->is_pending(diag3_f));
+  batch->wait();
+  REQUIRE(batch->empty());
+  // MPI may use a different reduction algorithm for the packed buffer than
+  // for the single fields, so the results need not be bit-for-bit
+  auto check_close = [&](const Field &f, const Field &ref) {
+    f.sync_to_host();
+    ref.sync_to_host();
+    const int n = f.get_header().get_identifier().get_layout().size();
+    auto f_h   = f.get_internal_view_data<const Real, Host>();
+    auto ref_h = ref.get_internal_view_data<const Real, Host>();
+    for(int i = 0; i < n; ++i) {
+      REQUIRE_THAT(f_h[i], Catch::Matchers::WithinRel(ref_h[i], tol));
+    }
+  };
+  check_close(diag2_f, diag2_ref);
+  check_close(diag3_f, diag3_ref);
+
+  // Batch the masked avg of qc2: the avg is finalized by the batch callback
+  FieldIdentifier mask_fid("qc_mask", scalar2d_layout, Units::nondimensional(), grid->name());
+  Field qc2_mask(mask_fid);
+  qc2_mask.allocate_view();
+  auto qc2_mask_h = qc2_mask.get_view<Real **, Host>();
+  std::uniform_int_distribution<int> mask_pdf(0, 1);
+  for(int i = 0; i < ngcols; ++i) {
+    for(int k = 0; k < nlevs; ++k) {
+      // Level 0 is masked out everywhere, so its avg is the fill value
+      qc2_mask_h(i, k) = k == 0 ? 0 : mask_pdf(engine);
+    }
+  }
+  qc2_mask.sync_to_dev();
+  const Real fill_value = constants::fill_value<Real>;
+  Field qc2m(qc2_fid);
+  qc2m.allocate_view();
+  qc2m.deep_copy(qc2);
+  qc2m.get_header().get_tracking().update_time_stamp(t0);
+  qc2m.get_header().set_extra_data("mask_data", qc2_mask);
+  qc2m.get_header().set_extra_data("mask_value", fill_value);
+
+  auto diag2m = diag_factory.create("HorizAvgDiag", comm, params);
+  diag2m->set_grids(gm);
+  diag2m->set_required_field(qc2m);
+  diag2m->initialize(t0, RunType::Initial);
+  diag2m->compute_diagnostic();
+  auto diag2m_f    = diag2m->get_diagnostic();
+  auto diag2m_mask = diag2m_f.get_header().get_extra_data<Field>("mask_data");
+  auto diag2m_ref      = diag2m_f.clone();
+  auto diag2m_mask_ref = diag2m_mask.clone();
+
+  diag2m->set_sum_batch(batch);
+  diag2m->compute_diagnostic();
+  REQUIRE(batch->is_pending(diag2m_f));
+  batch->wait();
+  check_close(diag2m_f, diag2m_ref);
+  REQUIRE(views_are_equal(diag2m_mask, diag2m_mask_ref));
+
+  diag2m_f.sync_to_host();
+  diag2m_mask.sync_to_host();
+  auto diag2m_h      = diag2m_f.get_view<const Real *, Host>();
+  auto diag2m_mask_h = diag2m_mask.get_view<const Real *, Host>();
+  REQUIRE(diag2m_h(0) == fill_value);
+  REQUIRE(diag2m_mask_h(0) == 0);
 }
 
 }  // namespace scream
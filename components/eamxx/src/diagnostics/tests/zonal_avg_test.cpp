@@ -197,6 +197,34 @@ TEST_CASE("zonal_avg") {
   diag3->compute_diagnostic();
   auto diag3_field = diag3->get_diagnostic();
   REQUIRE(views_are_equal(diag3_field, diag3m_field));
+
+  // Batch the global sums of diag1 and diag3, and check we get the same answers.
+  // MPI may use a different reduction algorithm for the packed buffer than
+  // for the single fields, so the results need not be bit-for-bit
+  randomize(qc1, engine, pdf);
+  diag1->compute_diagnostic();
+  auto diag1_ref = diag1_field.clone();
+  auto diag3_ref = diag3_field.clone();
+  auto batch = std::make_shared<FieldSumBatch>(comm);
+  diag1->set_sum_batch(batch);
+  diag3->set_sum_batch(batch);
+  diag1->compute_diagnostic();
+  diag3->compute_diagnostic();
+  REQUIRE(batch->is_pending(diag1_field));
+  REQUIRE(batch->is_pending(diag3_field));
+  batch->wait();
+  REQUIRE(batch->empty());
+  for (const auto& [f, ref] : {std::make_pair(diag1_field, diag1_ref),
+                               std::make_pair(diag3_field, diag3_ref)}) {
+    f.sync_to_host();
+    ref.sync_to_host();
+    const int n = f.get_header().get_identifier().get_layout().size();
+    auto f_h    = f.get_internal_view_data<const Real, Host>();
+    auto ref_h  = ref.get_internal_view_data<const Real, Host>();
+    for (int i = 0; i < n; ++i) {
+      REQUIRE_THAT(f_h[i], Catch::Matchers::WithinRel(ref_h[i], tol));
+    }
+  }
 }
 
 } // namespace scream
@@ -186,7 +186,13 @@ void ZonalAvgDiag::initialize_impl(const RunType /*run_type*/) {
 
 void ZonalAvgDiag::compute_diagnostic_impl() {
   const auto &field = get_fields_in().front();
-  compute_zonal_sum(m_diagnostic_output, field, m_scaled_area, m_lat, &m_comm);
+  if (m_sum_batch) {
+    // Compute the local sums, and let the batch do the global reduction
+    compute_zonal_sum(m_diagnostic_output, field, m_scaled_area, m_lat);
+    m_sum_batch->add(m_diagnostic_output);
+  } else {
+    compute_zonal_sum(m_diagnostic_output, field, m_scaled_area, m_lat, &m_comm);
+  }
 }
 
 } // namespace scream
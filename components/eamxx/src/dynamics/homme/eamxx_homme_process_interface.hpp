@@ -3,6 +3,7 @@
 
 #include "share/atm_process/atmosphere_process.hpp"
 #include "share/grid/remap/abstract_remapper.hpp"
+#include "share/util/eamxx_team_policy_tuner.hpp"
 
 #include <ekat_parameter_list.hpp>
 #include <ekat_pack.hpp>
@@ -101,7 +102,7 @@ protected:
 
   // Rayleigh friction functions
   void rayleigh_friction_init ();
-  void rayleigh_friction_apply (const Real dt) const;
+  void rayleigh_friction_apply (const Real dt);
 
 public:
   // Fast boolean function returning whether physics PGN is being used.
@@ -151,6 +152,9 @@ protected:
   // Rayleigh friction decay rate profile
   view_1d<Pack> m_otau;
 
+  // Team policy of the Rayleigh friction kernel (see eamxx_team_policy_tuner.hpp)
+  TunedTeamPolicy<KT::ExeSpace> m_rayleigh_policy;
+
   // Rayleigh friction paramaters
   int m_rayk0;      // Vertical level at which rayleigh friction term is centered.
   Real m_raykrange; // Range of rayleigh friction profile.
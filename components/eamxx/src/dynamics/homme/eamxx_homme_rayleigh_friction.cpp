@@ -51,28 +51,26 @@ void HommeDynamics::rayleigh_friction_init()
     const Pack x = (rayk0 - range_pack)/krange;
     otau(ilev) = otau0*(1.0 + ekat::tanh(x))/2.0;
   });
+
+  // The kernel is elementwise, so answers do not depend on the team config
+  const auto ncols = m_phys_grid->get_num_local_dofs();
+  m_rayleigh_policy = TunedTeamPolicy<KT::ExeSpace>(m_comm, "homme_rayleigh_friction", ncols, npacks);
 }
 
-void HommeDynamics::rayleigh_friction_apply(const Real dt) const
+void HommeDynamics::rayleigh_friction_apply(const Real dt)
 {
   using PF = PhysicsFunctions<DefaultDevice>;
-  using TPF = ekat::TeamPolicyFactory<KT::ExeSpace>;
 
   // If m_raytau0==0, then no Rayleigh friction is applied. Return.
   if (m_raytau0 == 0) return;
 
-  const auto ncols = m_phys_grid->get_num_local_dofs();
-  const auto nlevs = m_phys_grid->get_num_vertical_levels();
-  const auto npacks= ekat::npack<Pack>(nlevs);
-
   const auto horiz_winds_view = get_field_out("horiz_winds").get_view<Pack***>();
   const auto T_mid_view       = get_field_out("T_mid").get_view<Pack**>();
 
   // local for lambda captures to avoid issues on GPU
   auto otau = m_otau;
 
-  const auto policy = TPF::get_default_team_policy(ncols, npacks);
-  Kokkos::parallel_for(policy, KOKKOS_LAMBDA (const KT::MemberType& team) {
+  m_rayleigh_policy.launch("homme_rayleigh_friction", KOKKOS_LAMBDA (const KT::MemberType& team) {
     const int& icol = team.league_rank();
 
     auto u_wind = ekat::subview(horiz_winds_view, icol, 0);
@@ -47,6 +47,11 @@ void P3Microphysics::set_grids(const std::shared_ptr<const GridsManager> grids_m
   infrastructure.kte = m_num_levs-1;
   infrastructure.predictNc = m_params.get<bool>("do_predict_nc",true);
   infrastructure.prescribedCCN = m_params.get<bool>("do_prescribed_ccn",true);
+  if (runtime_options.balance_active_columns) {
+    infrastructure.col_order   = P3F::view_1d<Int>("p3_col_order",m_num_cols);
+    infrastructure.active_cols = P3F::view_1d<Int>("p3_active_cols",m_num_cols);
+    infrastructure.active_rank = P3F::view_1d<Int>("p3_active_rank",m_num_cols);
+  }
 
   // Define the different field layouts that will be used for this process
   using namespace ShortFieldTagsNames;
@@ -519,6 +524,10 @@ void P3Microphysics::initialize_impl (const RunType /* run_type */)
   // Setup WSM for internal local variables
   const auto policy = TPF::get_default_team_policy(m_num_cols, nk_pack);
   workspace_mgr.setup(m_buffer.wsm_data, nk_pack_p1, 52, policy);
+
+  // The pre/post processing kernels are pointwise, so their results do not depend on the policy
+  m_preproc_policy  = TunedTeamPolicy<KT::ExeSpace>(m_comm, "p3_pre_process", m_num_cols, nk_pack);
+  m_postproc_policy = TunedTeamPolicy<KT::ExeSpace>(m_comm, "p3_post_process", m_num_cols, nk_pack);
 }
 
 // =========================================================================================
@@ -4,6 +4,7 @@
 #include "share/atm_process/atmosphere_process.hpp"
 #include "physics/p3/p3_functions.hpp"
 #include "share/util/eamxx_common_physics_functions.hpp"
+#include "share/util/eamxx_team_policy_tuner.hpp"
 
 #include <ekat_parameter_list.hpp>
 
@@ -467,6 +468,10 @@ protected:
   p3_preamble              p3_preproc;
   p3_postamble             p3_postproc;
 
+  // Launch policies of the pre/post processing kernels (autotuned, if requested)
+  TunedTeamPolicy<KT::ExeSpace> m_preproc_policy;
+  TunedTeamPolicy<KT::ExeSpace> m_postproc_policy;
+
   // WSM for internal local variables
   ekat::WorkspaceManager<Spack, KT::Device> workspace_mgr;
 
@@ -1,26 +1,14 @@
 #include "physics/p3/eamxx_p3_process_interface.hpp"
 
-#include <ekat_team_policy_utils.hpp>
-
 namespace scream {
 
 void P3Microphysics::run_impl (const double dt)
 {
-  using TPF = ekat::TeamPolicyFactory<KT::ExeSpace>;
-
   // Set the dt for p3 postprocessing
   p3_postproc.m_dt = dt;
 
-  // Create policy for pre and post process pfor
-  const auto nlev_packs  = ekat::npack<Spack>(m_num_levs);
-  const auto policy = TPF::get_default_team_policy(m_num_cols, nlev_packs);
-
   // Assign values to local arrays used by P3, these are now stored in p3_loc.
-  Kokkos::parallel_for(
-    "p3_pre_process",
-    policy,
-    p3_preproc
-  );
+  m_preproc_policy.launch("p3_pre_process", p3_preproc);
   Kokkos::fence();
 
   // Update the variables in the p3 input structures with local values.
@@ -63,11 +51,7 @@ void P3Microphysics::run_impl (const double dt)
                workspace_mgr, m_num_cols, m_num_levs);
 
   // Conduct the post-processing of the p3_main output.
-  Kokkos::parallel_for(
-    "p3_post_process",
-    policy,
-    p3_postproc
-  );
+  m_postproc_policy.launch("p3_post_process", p3_postproc);
   Kokkos::fence();
 }
 
@@ -152,10 +152,14 @@ void Functions<S,D>
           TableIce tab;
           lookup_ice(qi_incld(pk), ni_incld(pk), qm_incld(pk), rhop, tab, qi_gt_small);
 
-          const auto table_val_ni_fallspd = apply_table_ice(0, ice_table_vals, tab, qi_gt_small);
-          const auto table_val_qi_fallspd = apply_table_ice(1, ice_table_vals, tab, qi_gt_small);
-          const auto table_val_ni_lammax = apply_table_ice(6, ice_table_vals, tab, qi_gt_small);
-          const auto table_val_ni_lammin = apply_table_ice(7, ice_table_vals, tab, qi_gt_small);
+          constexpr int num_ice_procs = 4;
+          const int ice_proc_indices[num_ice_procs] = {0, 1, 6, 7};
+          Spack ice_procs[num_ice_procs];
+          apply_table_ice(ice_proc_indices, num_ice_procs, ice_table_vals, tab, ice_procs, qi_gt_small);
+          const auto& table_val_ni_fallspd = ice_procs[0];
+          const auto& table_val_qi_fallspd = ice_procs[1];
+          const auto& table_val_ni_lammax  = ice_procs[2];
+          const auto& table_val_ni_lammin  = ice_procs[3];
 
           // impose mean ice size bounds (i.e. apply lambda limiters)
           // note that the Nmax and Nmin are normalized and thus need to be multiplied by existing N
@@ -72,6 +72,98 @@ void Functions<S,D>
   team.team_barrier();
 }
 
+template <typename S, typename D>
+void Functions<S,D>
+::get_column_order(
+  const P3PrognosticState& prognostic_state,
+  const P3DiagnosticInputs& diagnostic_inputs,
+  const Int nj,
+  const Int nk,
+  const view_1d<Int>& active,
+  const view_1d<Int>& active_rank,
+  const view_1d<Int>& col_order)
+{
+  using ExeSpace    = typename KT::ExeSpace;
+  using RangePolicy = typename KT::RangePolicy;
+  using TPF         = ekat::TeamPolicyFactory<ExeSpace>;
+  using physics     = scream::physics::Functions<Scalar, Device>;
+
+  constexpr Scalar T_zerodegc = C::T_zerodegc;
+  constexpr Scalar qsmall     = C::QSMALL;
+
+  const Int nk_pack = ekat::npack<Spack>(nk);
+  const auto policy = TPF::get_default_team_policy(nj, nk_pack);
+
+  // Flag the columns where p3_main_part1 will likely find hydrometeors or possible
+  // nucleation. This is only a prediction, which affects performance, not answers.
+  Kokkos::parallel_for(
+    "p3 find active columns",
+    policy,
+    KOKKOS_LAMBDA(const MemberType& team) {
+
+    const Int i = team.league_rank();
+
+    Int num_active_levs = 0;
+    Kokkos::parallel_reduce(
+      Kokkos::TeamVectorRange(team, nk_pack), [&] (Int k, Int& n) {
+
+      const auto range_mask = ekat::range<IntSmallPack>(k*Spack::n) < nk;
+      const auto T_atm = prognostic_state.th(i,k) / diagnostic_inputs.inv_exner(i,k);
+      const auto qv_sat_i = physics::qv_sat_dry(T_atm, diagnostic_inputs.pres(i,k), true, range_mask,
+                                                physics::MurphyKoop, "p3::get_column_order");
+
+      const auto hydrometeors = prognostic_state.qc(i,k) >= qsmall ||
+                                prognostic_state.qr(i,k) >= qsmall ||
+                                prognostic_state.qi(i,k) >= qsmall;
+      const auto nucleation = T_atm < T_zerodegc && prognostic_state.qv(i,k) >= sp(0.95)*qv_sat_i;
+      if ( (range_mask && (hydrometeors || nucleation)).any() ) {
+        ++n;
+      }
+    }, num_active_levs);
+
+    Kokkos::single(Kokkos::PerTeam(team), [&] {
+      active(i) = num_active_levs>0 ? 1 : 0;
+    });
+  });
+
+  // Exclusive scan to get the rank of each active column among the active ones
+  Int nact = 0;
+  Kokkos::parallel_scan(
+    "p3 rank active columns",
+    RangePolicy(0, nj),
+    KOKKOS_LAMBDA(const Int i, Int& n, const bool final) {
+    if (final) {
+      active_rank(i) = n;
+    }
+    n += active(i);
+  }, nact);
+  const Int ninact = nj - nact;
+
+  // Merge active and inactive columns, sorting the k-th active column with key (2k+1)/nact
+  // and the r-th inactive column with key (2r+1)/ninact (active first in case of ties).
+  // This way, any contiguous chunk of the league contains about the same number of
+  // active columns, regardless of how the team policy splits the league among threads.
+  Kokkos::parallel_for(
+    "p3 column order",
+    RangePolicy(0, nj),
+    KOKKOS_LAMBDA(const Int i) {
+
+    Int pos;
+    if (active(i)) {
+      // Number of inactive columns with key smaller than this column's key
+      const Int k = active_rank(i);
+      const Int c = (ninact*(2*k+1) + nact - 1) / nact;
+      pos = k + (c/2 < ninact ? c/2 : ninact);
+    } else {
+      // Number of active columns with key smaller than or equal to this column's key
+      const Int r = i - active_rank(i);
+      const Int f = (nact*(2*r+1)) / ninact;
+      pos = r + ((f+1)/2 < nact ? (f+1)/2 : nact);
+    }
+    col_order(pos) = i;
+  });
+}
+
 template <typename S, typename D>
 Int Functions<S,D>
 ::p3_main_internal(
@@ -106,13 +198,28 @@ Int Functions<S,D>
   // we do not want to measure init stuff
   auto start = std::chrono::steady_clock::now();
 
+  // Columns where no microphysics is needed exit early, so spreading the other
+  // columns evenly across the league improves the load balance
+  const bool reorder_cols = runtime_options.balance_active_columns;
+  view_1d<Int> col_order = infrastructure.col_order;
+  if (reorder_cols) {
+    auto active      = infrastructure.active_cols;
+    auto active_rank = infrastructure.active_rank;
+    if (col_order.extent_int(0)<nj) {
+      col_order   = view_1d<Int>("p3_col_order", nj);
+      active      = view_1d<Int>("p3_active_cols", nj);
+      active_rank = view_1d<Int>("p3_active_rank", nj);
+    }
+    get_column_order(prognostic_state, diagnostic_inputs, nj, nk, active, active_rank, col_order);
+  }
+
   // p3_main loop
   Kokkos::parallel_for(
     "p3 main loop",
     policy,
     KOKKOS_LAMBDA(const MemberType& team) {
 
-    const Int i = team.league_rank();
+    const Int i = reorder_cols ? col_order(team.league_rank()) : team.league_rank();
 
     auto workspace = workspace_mgr.get_workspace(team);
 
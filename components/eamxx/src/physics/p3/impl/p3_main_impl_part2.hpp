@@ -262,13 +262,17 @@ void Functions<S,D>
         lookup_rain(qr_incld(k), nr_incld(k), table_rain, qi_gt_small);
 
         // call to lookup table interpolation subroutines to get process rates
-        table_val_qi_fallspd.set(qi_gt_small, apply_table_ice(1, ice_table_vals, table_ice, qi_gt_small));
-        table_val_ni_self_collect.set(qi_gt_small, apply_table_ice(2, ice_table_vals, table_ice, qi_gt_small));
-        table_val_qc2qi_collect.set(qi_gt_small, apply_table_ice(3, ice_table_vals, table_ice, qi_gt_small));
-        table_val_qi2qr_melting.set(qi_gt_small, apply_table_ice(4, ice_table_vals, table_ice, qi_gt_small));
-        table_val_ni_lammax.set(qi_gt_small, apply_table_ice(6, ice_table_vals, table_ice, qi_gt_small));
-        table_val_ni_lammin.set(qi_gt_small, apply_table_ice(7, ice_table_vals, table_ice, qi_gt_small));
-        table_val_qi2qr_vent_melt.set(qi_gt_small, apply_table_ice(9, ice_table_vals, table_ice, qi_gt_small));
+        constexpr int num_ice_procs = 7;
+        const int ice_proc_indices[num_ice_procs] = {1, 2, 3, 4, 6, 7, 9};
+        Spack ice_procs[num_ice_procs];
+        apply_table_ice(ice_proc_indices, num_ice_procs, ice_table_vals, table_ice, ice_procs, qi_gt_small);
+        table_val_qi_fallspd.set(qi_gt_small, ice_procs[0]);
+        table_val_ni_self_collect.set(qi_gt_small, ice_procs[1]);
+        table_val_qc2qi_collect.set(qi_gt_small, ice_procs[2]);
+        table_val_qi2qr_melting.set(qi_gt_small, ice_procs[3]);
+        table_val_ni_lammax.set(qi_gt_small, ice_procs[4]);
+        table_val_ni_lammin.set(qi_gt_small, ice_procs[5]);
+        table_val_qi2qr_vent_melt.set(qi_gt_small, ice_procs[6]);
 
         // ice-rain collection processes
         const auto qr_gt_small = qr_incld(k) >= qsmall && qi_gt_small;
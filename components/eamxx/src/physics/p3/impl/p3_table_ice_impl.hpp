@@ -160,6 +160,52 @@ typename Functions<S,D>::Spack Functions<S,D>
   return proc;
 }
 
+template <typename S, typename D>
+KOKKOS_FUNCTION
+void Functions<S,D>
+::apply_table_ice(const int* indices, const int num_indices,
+                  const view_ice_table& ice_table_vals, const TableIce& tab,
+                  Spack* procs, const Smask& context)
+{
+  if (!context.any()) return;
+
+  // Strides of the ice table along the size, rime fraction, and density dims.
+  // The quantities of each table node are contiguous in memory, so the
+  // nodes bracketing the input are the same for all quantities
+  constexpr int di  = P3C::ice_table_size;
+  constexpr int dii = P3C::isize*di;
+  constexpr int djj = P3C::rimsize*dii;
+
+  // Offset of the lower corner of the bracketing cell, and interpolation weights
+  const IntSmallPack offset = tab.dumjj*djj + tab.dumii*dii + tab.dumi*di;
+  const Spack w1 = tab.dum1 - Spack(tab.dumi) - 1;
+  const Spack w4 = tab.dum4 - Spack(tab.dumii) - 1;
+  const Spack w5 = tab.dum5 - Spack(tab.dumjj) - 1;
+
+  for (int n=0; n<num_indices; ++n) {
+    const Scalar* vals = ice_table_vals.data() + indices[n];
+    auto& proc = procs[n];
+
+    // Same interpolation steps as the single-quantity apply_table_ice
+    vector_simd
+    for (int s=0; s<Spack::n; ++s) {
+      const Scalar* v = vals + offset[s];
+
+      // Value at current density index
+      auto iproc1 = v[0] + w1[s]*(v[di] - v[0]);
+      auto gproc1 = v[dii] + w1[s]*(v[dii+di] - v[dii]);
+      const auto tmp1 = iproc1 + w4[s]*(gproc1 - iproc1);
+
+      // Value at density index + 1
+      iproc1 = v[djj] + w1[s]*(v[djj+di] - v[djj]);
+      gproc1 = v[djj+dii] + w1[s]*(v[djj+dii+di] - v[djj+dii]);
+      const auto tmp2 = iproc1 + w4[s]*(gproc1 - iproc1);
+
+      proc[s] = tmp1 + w5[s]*(tmp2 - tmp1);
+    }
+  }
+}
+
 template <typename S, typename D>
 KOKKOS_FUNCTION
 typename Functions<S,D>::Spack Functions<S,D>
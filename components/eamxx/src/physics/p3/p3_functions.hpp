@@ -138,6 +138,7 @@ struct Functions
     bool use_hetfrz_classnuc = false;
     bool use_separate_ice_liq_frac = false;
     bool extra_p3_diags = false;
+    bool balance_active_columns = false;
 
     void load_runtime_options_from_file(ekat::ParameterList& params) {
       max_total_ni = params.get<double>("max_total_ni", max_total_ni);
@@ -167,6 +168,7 @@ struct Functions
       use_hetfrz_classnuc = params.get<bool>("use_hetfrz_classnuc", use_hetfrz_classnuc);
       use_separate_ice_liq_frac = params.get<bool>("use_separate_ice_liq_frac", use_separate_ice_liq_frac);
       extra_p3_diags = params.get<bool>("extra_p3_diags", extra_p3_diags);
+      balance_active_columns = params.get<bool>("balance_active_columns", balance_active_columns);
     }
 
   };
@@ -283,6 +285,11 @@ struct Functions
     bool prescribedCCN;
     // Coordinates of columns, nj x 3
     view_2d<const Scalar> col_location;
+    // Work arrays for balance_active_columns, size nj. If not allocated,
+    // p3_main allocates them at each call.
+    view_1d<Int> col_order;
+    view_1d<Int> active_cols;
+    view_1d<Int> active_rank;
   };
 
   // This struct stores tendencies computed by P3 and used by other
@@ -449,6 +456,15 @@ struct Functions
                                const TableIce& tab,
                                const Smask& context = Smask(true) );
 
+  // Same as above, but for num_indices quantities at once, stored in procs. The offsets
+  // of the table nodes bracketing the input and the interpolation weights are computed
+  // once, and each quantity is then gathered lane by lane from the flattened table.
+  KOKKOS_FUNCTION
+  static void apply_table_ice(const int* indices, const int num_indices,
+                              const view_ice_table& ice_table_vals,
+                              const TableIce& tab, Spack* procs,
+                              const Smask& context = Smask(true) );
+
   // Interpolates lookup table values for rain/ice collection processes
   KOKKOS_FUNCTION
   static Spack apply_table_coll(const int& index, const view_collect_table& collect_table_vals,
@@ -1454,6 +1470,18 @@ struct Functions
     Int nj, // number of columns
     Int nk); // number of vertical cells per column
 
+  // Computes a permutation of the columns where the columns likely to need the
+  // full microphysics (active columns) are spread evenly among the others.
+  // The active and active_rank views (size nj) are used as work arrays.
+  static void get_column_order(
+    const P3PrognosticState& prognostic_state,
+    const P3DiagnosticInputs& diagnostic_inputs,
+    const Int nj,
+    const Int nk,
+    const view_1d<Int>& active,
+    const view_1d<Int>& active_rank,
+    const view_1d<Int>& col_order);
+
   static Int p3_main_internal(
     const P3Runtime& runtime_options,
     const P3PrognosticState& prognostic_state,
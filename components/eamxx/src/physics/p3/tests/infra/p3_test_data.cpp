@@ -1285,7 +1285,8 @@ Int p3_main_host(
   Real* precip_ice_surf, Int its, Int ite, Int kts, Int kte, Real* diag_eff_radius_qc,
   Real* diag_eff_radius_qi, Real* diag_eff_radius_qr, Real* rho_qi, bool do_predict_nc, bool do_prescribed_CCN, bool use_hetfrz_classnuc, Real* dpres, Real* inv_exner,
   Real* qv2qi_depos_tend, Real* precip_liq_flux, Real* precip_ice_flux, Real* cld_frac_r, Real* cld_frac_l, Real* cld_frac_i,
-  Real* liq_ice_exchange, Real* vap_liq_exchange, Real* vap_ice_exchange, Real* qv_prev, Real* t_prev)
+  Real* liq_ice_exchange, Real* vap_liq_exchange, Real* vap_ice_exchange, Real* qv_prev, Real* t_prev,
+  bool balance_active_columns)
 {
   using P3F  = Functions<Real, DefaultDevice>;
 
@@ -1498,6 +1499,7 @@ Int p3_main_host(
   // load tables
   auto lookup_tables = P3F::p3_init();
   P3F::P3Runtime runtime_options{740.0e3};
+  runtime_options.balance_active_columns = balance_active_columns;
 
   // Create local workspace
   const auto policy = TPF::get_default_team_policy(nj, nk_pack);
@@ -0,0 +1,91 @@
+// This is a small program to compare the performance of the two ways of interpolating
+// the P3 ice lookup table: one quantity at a time, or all quantities at once.
+// The quantities are the ones used in p3_main_part2.
+// Usage:
+//   p3_ice_table_bench [npacks=100000] [nruns=20]
+
+#include "physics/p3/p3_functions.hpp"
+#include "share/eamxx_session.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <string>
+
+int main(int argc, char** argv) {
+  using namespace scream;
+  using P3F   = p3::Functions<Real, DefaultDevice>;
+  using Spack = P3F::Spack;
+  using KT    = KokkosTypes<DefaultDevice>;
+
+  scream::initialize_eamxx_session(argc, argv);
+  {
+    const int npacks = argc>1 ? std::stoi(argv[1]) : 100000;
+    const int nruns  = argc>2 ? std::stoi(argv[2]) : 20;
+
+    P3F::view_ice_table ice_table_vals;
+    P3F::view_collect_table collect_table_vals;
+    P3F::get_global_ice_lookup_tables(ice_table_vals, collect_table_vals);
+
+    // Random inputs, spanning the table ranges
+    std::mt19937_64 engine(0);
+    std::uniform_real_distribution<Real> log_qi(-12,-2), log_ni(1,8), frac(0,1), rho(50,900);
+    KT::view_2d<Spack> inputs("inputs",4,npacks);
+    auto inputs_h = Kokkos::create_mirror_view(inputs);
+    for (int i=0; i<npacks; ++i) {
+      for (int s=0; s<Spack::n; ++s) {
+        inputs_h(0,i)[s] = std::pow(10,log_qi(engine));
+        inputs_h(1,i)[s] = std::pow(10,log_ni(engine));
+        inputs_h(2,i)[s] = frac(engine)*inputs_h(0,i)[s];
+        inputs_h(3,i)[s] = rho(engine);
+      }
+    }
+    Kokkos::deep_copy(inputs,inputs_h);
+
+    constexpr int nq = 7;
+    KT::view_2d<Spack> outputs("outputs",nq,npacks);
+
+    auto single = KOKKOS_LAMBDA (const int i) {
+      P3F::TableIce tab;
+      P3F::lookup_ice(inputs(0,i),inputs(1,i),inputs(2,i),inputs(3,i),tab);
+      const int indices[nq] = {1, 2, 3, 4, 6, 7, 9};
+      for (int q=0; q<nq; ++q) {
+        outputs(q,i) = P3F::apply_table_ice(indices[q],ice_table_vals,tab);
+      }
+    };
+    auto multi = KOKKOS_LAMBDA (const int i) {
+      P3F::TableIce tab;
+      P3F::lookup_ice(inputs(0,i),inputs(1,i),inputs(2,i),inputs(3,i),tab);
+      const int indices[nq] = {1, 2, 3, 4, 6, 7, 9};
+      Spack procs[nq];
+      P3F::apply_table_ice(indices,nq,ice_table_vals,tab,procs);
+      for (int q=0; q<nq; ++q) {
+        outputs(q,i) = procs[q];
+      }
+    };
+
+    auto time_kernel = [&](const std::string& name, const auto& f) {
+      // Warm up
+      Kokkos::parallel_for(KT::RangePolicy(0,npacks),f);
+      Kokkos::fence();
+
+      auto start = std::chrono::steady_clock::now();
+      for (int irun=0; irun<nruns; ++irun) {
+        Kokkos::parallel_for(KT::RangePolicy(0,npacks),f);
+      }
+      Kokkos::fence();
+      auto finish = std::chrono::steady_clock::now();
+
+      double elapsed = std::chrono::duration<double,std::milli>(finish-start).count() / nruns;
+      std::cout << " " << name << ": avg time " << elapsed << " ms\n";
+    };
+
+    std::cout << " npacks: " << npacks << ", pack size: " << Spack::n << ", nruns: " << nruns << "\n";
+    time_kernel("one quantity at a time",single);
+    time_kernel("all quantities at once",multi);
+  }
+  scream::finalize_eamxx_session();
+
+  return 0;
+}
@@ -10,6 +10,7 @@
 #include <array>
 #include <algorithm>
 #include <random>
+#include <cmath>
 
 namespace scream {
 namespace p3 {
@@ -282,6 +283,70 @@ struct UnitWrap::UnitTest<D>::TestTableIce : public UnitWrap::UnitTest<D>::Base
     }
   }
 
+  // Check that interpolating all quantities at once gives the same
+  // results as interpolating them one at a time
+  void run_multi_index()
+  {
+    constexpr Int nq = Functions::P3C::ice_table_size;
+    constexpr Int npacks = 64;
+    constexpr Int num_pts = npacks*Spack::n;
+
+    view_ice_table ice_table_vals;
+    view_collect_table collect_table_vals;
+    Functions::get_global_ice_lookup_tables(ice_table_vals, collect_table_vals);
+
+    // Inputs spanning (and exceeding) the table ranges
+    std::default_random_engine generator(42);
+    std::uniform_real_distribution<Real> log_qi(-12,-2), log_ni(1,8), frac(0,1), rho(0,1000);
+    view_2d<Real> inputs("inputs",4,num_pts);
+    auto inputs_h = Kokkos::create_mirror_view(inputs);
+    for (Int i=0; i<num_pts; ++i) {
+      inputs_h(0,i) = std::pow(10,log_qi(generator));
+      inputs_h(1,i) = std::pow(10,log_ni(generator));
+      inputs_h(2,i) = frac(generator)*inputs_h(0,i);
+      inputs_h(3,i) = rho(generator);
+    }
+    Kokkos::deep_copy(inputs,inputs_h);
+
+    view_2d<Real> single("single",nq,num_pts), multi("multi",nq,num_pts);
+    Kokkos::parallel_for(npacks, KOKKOS_LAMBDA(const Int& i) {
+      Spack qi, ni, qm, rhop;
+      for (Int s = 0, vs = i*Spack::n; s < Spack::n; ++s, ++vs) {
+        qi[s]   = inputs(0,vs);
+        ni[s]   = inputs(1,vs);
+        qm[s]   = inputs(2,vs);
+        rhop[s] = inputs(3,vs);
+      }
+
+      TableIce ti;
+      Functions::lookup_ice(qi, ni, qm, rhop, ti);
+
+      int indices[nq];
+      Spack procs[nq];
+      for (Int q = 0; q < nq; ++q) {
+        indices[q] = q;
+      }
+      Functions::apply_table_ice(indices, nq, ice_table_vals, ti, procs);
+
+      for (Int q = 0; q < nq; ++q) {
+        const auto proc = Functions::apply_table_ice(q, ice_table_vals, ti);
+        for (Int s = 0, vs = i*Spack::n; s < Spack::n; ++s, ++vs) {
+          single(q,vs) = proc[s];
+          multi(q,vs)  = procs[q][s];
+        }
+      }
+    });
+
+    auto single_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),single);
+    auto multi_h  = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),multi);
+    // Both versions perform the same operations, in the same order
+    for (Int q = 0; q < nq; ++q) {
+      for (Int i = 0; i < num_pts; ++i) {
+        REQUIRE (single_h(q,i) == multi_h(q,i));
+      }
+    }
+  }
+
   void run_phys()
   {
 #if 0
@@ -336,6 +401,7 @@ TEST_CASE("p3_ice_tables", "[p3_functions]")
   T t;
   t.run_phys();
   t.run_bfb();
+  t.run_multi_index();
 }
 
 }
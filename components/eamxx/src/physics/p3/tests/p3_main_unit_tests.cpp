@@ -10,6 +10,8 @@
 #include <array>
 #include <algorithm>
 #include <random>
+#include <cstdlib>
+#include <vector>
 
 namespace scream {
 namespace p3 {
@@ -38,12 +40,79 @@ void run_phys_p3_main()
   // TODO
 }
 
+void run_phys_column_order()
+{
+  using P3PrognosticState  = typename Functions::P3PrognosticState;
+  using P3DiagnosticInputs = typename Functions::P3DiagnosticInputs;
+
+  constexpr Int nj = 37;
+  constexpr Int nk = 10;
+  const Int nk_pack = ekat::npack<Spack>(nk);
+
+  // Give cloud water to a random subset of the columns, so that they are flagged as active.
+  // The other columns are warm and dry, so no nucleation is possible either.
+  auto engine = Base::get_engine();
+  std::uniform_int_distribution<int> coin(0,1);
+
+  view_2d<Spack> qc("qc",nj,nk_pack), qr("qr",nj,nk_pack), qi("qi",nj,nk_pack), qv("qv",nj,nk_pack);
+  view_2d<Spack> th("th",nj,nk_pack), pres("pres",nj,nk_pack), inv_exner("inv_exner",nj,nk_pack);
+  auto qc_h        = Kokkos::create_mirror_view(qc);
+  auto th_h        = Kokkos::create_mirror_view(th);
+  auto pres_h      = Kokkos::create_mirror_view(pres);
+  auto inv_exner_h = Kokkos::create_mirror_view(inv_exner);
+
+  std::vector<bool> active(nj);
+  for (Int i = 0; i < nj; ++i) {
+    active[i] = coin(engine)==1;
+    for (Int k = 0; k < nk_pack; ++k) {
+      qc_h(i,k)        = active[i] ? 1e-4 : 0;
+      th_h(i,k)        = 300;
+      pres_h(i,k)      = 1e5;
+      inv_exner_h(i,k) = 1;
+    }
+  }
+  Kokkos::deep_copy(qc,qc_h);
+  Kokkos::deep_copy(th,th_h);
+  Kokkos::deep_copy(pres,pres_h);
+  Kokkos::deep_copy(inv_exner,inv_exner_h);
+
+  P3PrognosticState prog_state;
+  prog_state.qc = qc;
+  prog_state.qr = qr;
+  prog_state.qi = qi;
+  prog_state.qv = qv;
+  prog_state.th = th;
+  P3DiagnosticInputs diag_inputs;
+  diag_inputs.pres = pres;
+  diag_inputs.inv_exner = inv_exner;
+
+  view_1d<Int> active_cols("active_cols",nj), active_rank("active_rank",nj), col_order("col_order",nj);
+  Functions::get_column_order(prog_state, diag_inputs, nj, nk, active_cols, active_rank, col_order);
+  auto col_order_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),col_order);
+
+  // The order must be a permutation of the columns
+  std::vector<Int> sorted(col_order_h.data(),col_order_h.data()+nj);
+  std::sort(sorted.begin(),sorted.end());
+  for (Int i = 0; i < nj; ++i) {
+    REQUIRE (sorted[i]==i);
+  }
+
+  // Any leading chunk of the order holds (about) its share of the active columns
+  const Int nact = std::count(active.begin(),active.end(),true);
+  Int nact_chunk = 0;
+  for (Int n = 1; n <= nj; ++n) {
+    nact_chunk += active[col_order_h(n-1)] ? 1 : 0;
+    REQUIRE (std::abs(nact_chunk*nj - n*nact) <= nj);
+  }
+}
+
 void run_phys()
 {
   run_phys_p3_main_part1();
   run_phys_p3_main_part2();
   run_phys_p3_main_part3();
   run_phys_p3_main();
+  run_phys_column_order();
 }
 
 void run_bfb_p3_main_part1()
@@ -509,12 +578,96 @@ void run_bfb_p3_main()
   }
 }
 
+void run_bfb_balance_active_columns()
+{
+  auto engine = Base::get_engine();
+
+  P3MainData d_base(1, 10, 1, 72, 1, 1.800E+03, true, false);
+  d_base.randomize(engine, {
+      {d_base.pres           , {1.00000000E+02 , 9.87111111E+04}},
+      {d_base.dz             , {1.22776609E+02 , 3.49039167E+04}},
+      {d_base.nc_nuceat_tend , {0              , 0}},
+      {d_base.nccn_prescribed, {0              , 0}},
+      {d_base.ni_activated   , {0              , 0}},
+      {d_base.dpres          , {1.37888889E+03, 1.39888889E+03}},
+      {d_base.inv_exner      , {1.00371345E+00, 3.19721007E+00}},
+      {d_base.cld_frac_i     , {1              , 1}},
+      {d_base.cld_frac_l     , {1              , 1}},
+      {d_base.cld_frac_r     , {1              , 1}},
+      {d_base.inv_qc_relvar  , {1              , 1}},
+      {d_base.qc             , {0              , 1.00000000E-04}},
+      {d_base.nc             , {1.00000000E+06 , 1.00000000E+06}},
+      {d_base.qr             , {0              , 1.00000000E-05}},
+      {d_base.nr             , {1.00000000E+06 , 1.00000000E+06}},
+      {d_base.qi             , {0              , 1.00000000E-04}},
+      {d_base.qm             , {0              , 1.00000000E-04}},
+      {d_base.ni             , {1.00000000E+06 , 1.00000000E+06}},
+      {d_base.bm             , {0              , 1.00000000E-02}},
+      {d_base.qv             , {0              , 5.00000000E-02}},
+      {d_base.qv_prev        , {0              , 5.00000000E-02}},
+      {d_base.th_atm         , {6.72653866E+02 , 1.07954335E+03}},
+      {d_base.t_prev         , {1.50000000E+02 , 3.50000000E+02}}
+  });
+
+  // Dry out every other column, so that the column order is not the identity
+  const Int nj = d_base.ite - d_base.its + 1;
+  const Int nk = d_base.kte - d_base.kts + 1;
+  for (Int i = 0; i < nj; i += 2) {
+    for (Int k = 0; k < nk; ++k) {
+      d_base.qc[i*nk+k] = d_base.qr[i*nk+k] = d_base.qi[i*nk+k] = d_base.qv[i*nk+k] = 0;
+    }
+  }
+
+  // Reordering the columns affects performance, but not answers
+  P3MainData ds[] = { P3MainData(d_base), P3MainData(d_base) };
+  for (int n = 0; n < 2; ++n) {
+    auto& d = ds[n];
+    p3_main_host(
+      d.qc, d.nc, d.qr, d.nr, d.th_atm, d.qv, d.dt, d.qi, d.qm, d.ni,
+      d.bm, d.pres, d.dz, d.nc_nuceat_tend, d.nccn_prescribed, d.ni_activated, d.inv_qc_relvar, d.it, d.precip_liq_surf,
+      d.precip_ice_surf, d.its, d.ite, d.kts, d.kte, d.diag_eff_radius_qc, d.diag_eff_radius_qi, d.diag_eff_radius_qr,
+      d.rho_qi, d.do_predict_nc, d.do_prescribed_CCN, d.use_hetfrz_classnuc, d.dpres, d.inv_exner, d.qv2qi_depos_tend,
+      d.precip_liq_flux, d.precip_ice_flux, d.cld_frac_r, d.cld_frac_l, d.cld_frac_i,
+      d.liq_ice_exchange, d.vap_liq_exchange, d.vap_ice_exchange, d.qv_prev, d.t_prev,
+      n==1);
+  }
+
+  const auto& d0 = ds[0];
+  const auto& d1 = ds[1];
+  const auto tot = d0.total(d0.qc);
+  for (Int t = 0; t < tot; ++t) {
+    REQUIRE(d0.qc[t]                 == d1.qc[t]);
+    REQUIRE(d0.nc[t]                 == d1.nc[t]);
+    REQUIRE(d0.qr[t]                 == d1.qr[t]);
+    REQUIRE(d0.nr[t]                 == d1.nr[t]);
+    REQUIRE(d0.qi[t]                 == d1.qi[t]);
+    REQUIRE(d0.qm[t]                 == d1.qm[t]);
+    REQUIRE(d0.ni[t]                 == d1.ni[t]);
+    REQUIRE(d0.bm[t]                 == d1.bm[t]);
+    REQUIRE(d0.qv[t]                 == d1.qv[t]);
+    REQUIRE(d0.th_atm[t]             == d1.th_atm[t]);
+    REQUIRE(d0.diag_eff_radius_qc[t] == d1.diag_eff_radius_qc[t]);
+    REQUIRE(d0.diag_eff_radius_qi[t] == d1.diag_eff_radius_qi[t]);
+    REQUIRE(d0.diag_eff_radius_qr[t] == d1.diag_eff_radius_qr[t]);
+    REQUIRE(d0.rho_qi[t]             == d1.rho_qi[t]);
+    REQUIRE(d0.qv2qi_depos_tend[t]   == d1.qv2qi_depos_tend[t]);
+    REQUIRE(d0.liq_ice_exchange[t]   == d1.liq_ice_exchange[t]);
+    REQUIRE(d0.vap_liq_exchange[t]   == d1.vap_liq_exchange[t]);
+    REQUIRE(d0.vap_ice_exchange[t]   == d1.vap_ice_exchange[t]);
+    REQUIRE(d0.precip_liq_flux[t]    == d1.precip_liq_flux[t]);
+    REQUIRE(d0.precip_ice_flux[t]    == d1.precip_ice_flux[t]);
+    REQUIRE(d0.precip_liq_surf[t]    == d1.precip_liq_surf[t]);
+    REQUIRE(d0.precip_ice_surf[t]    == d1.precip_ice_surf[t]);
+  }
+}
+
 void run_bfb()
 {
   run_bfb_p3_main_part1();
   run_bfb_p3_main_part2();
   run_bfb_p3_main_part3();
   run_bfb_p3_main();
+  run_bfb_balance_active_columns();
 }
 
 };
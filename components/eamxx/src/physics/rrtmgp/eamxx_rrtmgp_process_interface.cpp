@@ -13,6 +13,8 @@
 #include <ekat_team_policy_utils.hpp>
 #include <ekat_assert.hpp>
 
+#include <limits>
+
 #include "cpp/rrtmgp/mo_gas_concentrations.h"
 
 namespace scream {
@@ -114,8 +116,34 @@ void RRTMGPRadiation::set_grids(const std::shared_ptr<const GridsManager> grids_
     m_lon = m_grid->get_geometry_data("lon");
   }
 
-  // Figure out radiation column chunks stats
-  m_col_chunk_size = std::min(m_params.get("column_chunk_size", m_ncol),m_ncol);
+  // Number of g-points (needed to estimate the chunks memory footprint)
+  m_nswgpts = m_params.get<int>("nswgpts",112);
+  m_nlwgpts = m_params.get<int>("nlwgpts",128);
+
+  // Figure out radiation column chunks stats. A non-positive chunk size means
+  // that the chunk size is picked so that the chunk working set fits in
+  // column_chunk_target_mb megabytes (by default, this rank's share of the host
+  // last level cache on CPU, and no limit on GPU)
+  const int chunk_size = m_params.get("column_chunk_size", m_ncol);
+  if (chunk_size>0) {
+    m_col_chunk_size = std::min(chunk_size,m_ncol);
+  } else {
+    const double target_mb = m_params.get<double>("column_chunk_target_mb",-1.0);
+    size_t target_bytes;
+    if (target_mb>0) {
+      target_bytes = static_cast<size_t>(target_mb*1024*1024);
+    } else {
+      // The last level cache is shared by all the ranks on the node
+      MPI_Comm node_comm;
+      int ranks_per_node;
+      MPI_Comm_split_type(m_comm.mpi_comm(),MPI_COMM_TYPE_SHARED,m_comm.rank(),MPI_INFO_NULL,&node_comm);
+      MPI_Comm_size(node_comm,&ranks_per_node);
+      MPI_Comm_free(&node_comm);
+      target_bytes = rrtmgp::default_chunk_target_bytes(ekat::OnGpu<ExeSpace>::value,ranks_per_node);
+    }
+    m_col_chunk_size = rrtmgp::auto_col_chunk_size(m_ncol,chunk_bytes_per_col(),target_bytes,
+                                                   ExeSpace().concurrency());
+  }
   m_num_col_chunks = (m_ncol+m_col_chunk_size-1) / m_col_chunk_size;
   m_col_chunk_beg.resize(m_num_col_chunks+1,0);
   for (int i=0; i<m_num_col_chunks; ++i) {
@@ -127,8 +155,6 @@ void RRTMGPRadiation::set_grids(const std::shared_ptr<const GridsManager> grids_
             "  - Number of chunks: " + std::to_string(m_num_col_chunks) + "\n");
 
   // Set up dimension layouts
-  m_nswgpts = m_params.get<int>("nswgpts",112);
-  m_nlwgpts = m_params.get<int>("nlwgpts",128);
   FieldLayout scalar2d = m_grid->get_2d_scalar_layout();
   FieldLayout scalar3d_mid = m_grid->get_3d_scalar_layout(true);
   FieldLayout scalar3d_int = m_grid->get_3d_scalar_layout(false);
@@ -291,21 +317,37 @@ void RRTMGPRadiation::set_grids(const std::shared_ptr<const GridsManager> grids_
 }  // RRTMGPRadiation::set_grids
 
 size_t RRTMGPRadiation::requested_buffer_size_in_bytes() const
+{
+  return m_col_chunk_size * chunk_buffer_bytes_per_col();
+} // RRTMGPRadiation::requested_buffer_size
+
+size_t RRTMGPRadiation::chunk_buffer_bytes_per_col() const
 {
   const size_t interface_request =
-    Buffer::num_1d_ncol*m_col_chunk_size +
-    Buffer::num_2d_nlay*m_col_chunk_size*m_nlay +
-    Buffer::num_2d_nlay_p1*m_col_chunk_size*(m_nlay+1) +
-    Buffer::num_2d_nswbands*m_col_chunk_size*m_nswbands +
-    Buffer::num_3d_nlev_nswbands*m_col_chunk_size*(m_nlay+1)*m_nswbands +
-    Buffer::num_3d_nlev_nlwbands*m_col_chunk_size*(m_nlay+1)*m_nlwbands +
-    Buffer::num_3d_nlay_nswbands*m_col_chunk_size*(m_nlay)*m_nswbands +
-    Buffer::num_3d_nlay_nlwbands*m_col_chunk_size*(m_nlay)*m_nlwbands +
-    Buffer::num_3d_nlay_nswgpts*m_col_chunk_size*(m_nlay)*m_nswgpts +
-    Buffer::num_3d_nlay_nlwgpts*m_col_chunk_size*(m_nlay)*m_nlwgpts;
+    Buffer::num_1d_ncol +
+    Buffer::num_2d_nlay*m_nlay +
+    Buffer::num_2d_nlay_p1*(m_nlay+1) +
+    Buffer::num_2d_nswbands*m_nswbands +
+    Buffer::num_3d_nlev_nswbands*(m_nlay+1)*m_nswbands +
+    Buffer::num_3d_nlev_nlwbands*(m_nlay+1)*m_nlwbands +
+    Buffer::num_3d_nlay_nswbands*(m_nlay)*m_nswbands +
+    Buffer::num_3d_nlay_nlwbands*(m_nlay)*m_nlwbands +
+    Buffer::num_3d_nlay_nswgpts*(m_nlay)*m_nswgpts +
+    Buffer::num_3d_nlay_nlwgpts*(m_nlay)*m_nlwgpts;
 
   return interface_request * sizeof(Real);
-} // RRTMGPRadiation::requested_buffer_size
+}
+
+size_t RRTMGPRadiation::chunk_bytes_per_col() const
+{
+  // Besides our buffers, the rrtmgp kernels work on several (nlay,ngpt) temporaries
+  // per column (optical depths, ssa, asymmetry, sources, fluxes), allocated from the pool.
+  // This is a rough estimate, but we only need the order of magnitude.
+  constexpr int num_internal_gpt_arrays = 8;
+  const size_t internal_request = num_internal_gpt_arrays*m_nlay*std::max(m_nswgpts,m_nlwgpts);
+
+  return chunk_buffer_bytes_per_col() + internal_request*sizeof(Real);
+}
 // =========================================================================================
 
 void RRTMGPRadiation::init_buffers(const ATMBufferManager &buffer_manager)
@@ -724,8 +766,31 @@ void RRTMGPRadiation::run_impl (const double dt) {
       }
     }
 
-    // Get solar zenith angle device view
+    // Determine the cosine zenith angle on all columns, before the chunks loop, so that
+    // the loop contains no host work depending on device data, nor host-device copies,
+    // and needs no fence between chunks. Note that the chunks do not run concurrently:
+    // they share the GasConcs object and the buffers, and all kernels are launched on
+    // the default execution space instance, so they still execute in order. The gain
+    // is only that the host can launch the next kernels while the device is busy.
+    // NOTE: Since we are bridging to F90 arrays this must be done on HOST and then
+    //       deep copied to a device view.
     auto d_mu0 = get_field_out("cosine_solar_zenith_angle").get_view<Real*>();
+    {
+      auto h_mu0 = Kokkos::create_mirror_view(d_mu0);
+      if (m_fixed_solar_zenith_angle > 0) {
+        for (int i=0; i<m_ncol; i++) {
+          h_mu0(i) = m_fixed_solar_zenith_angle;
+        }
+      } else {
+        // Now use solar declination to calculate zenith angle for all points
+        for (int i=0;i<m_ncol;i++) {
+          double lat = h_lat(i)*PC::Pi/180.0;  // Convert lat/lon to radians
+          double lon = h_lon(i)*PC::Pi/180.0;
+          h_mu0(i) = shr_orb_cosz_c2f(calday, lat, lon, delta, m_rad_freq_in_steps * dt);
+        }
+      }
+      Kokkos::deep_copy(d_mu0,h_mu0);
+    }
 
     // Loop over each chunk of columns
     for (int ic=0; ic<m_num_col_chunks; ++ic) {
@@ -809,24 +874,6 @@ void RRTMGPRadiation::run_impl (const double dt) {
 
       // Copy data from the FieldManager to the Kokkos Views
       {
-        // Determine the cosine zenith angle
-        // NOTE: Since we are bridging to F90 arrays this must be done on HOST and then
-        //       deep copied to a device view.
-        auto h_mu0 = Kokkos::create_mirror_view(mu0_k);
-        if (m_fixed_solar_zenith_angle > 0) {
-          for (int i=0; i<ncol; i++) {
-            h_mu0(i) = m_fixed_solar_zenith_angle;
-          }
-        } else {
-          // Now use solar declination to calculate zenith angle for all points
-          for (int i=0;i<ncol;i++) {
-            double lat = h_lat(i+beg)*PC::Pi/180.0;  // Convert lat/lon to radians
-            double lon = h_lon(i+beg)*PC::Pi/180.0;
-            h_mu0(i) = shr_orb_cosz_c2f(calday, lat, lon, delta, m_rad_freq_in_steps * dt);
-          }
-        }
-        Kokkos::deep_copy(mu0_k,h_mu0);
-
         const auto policy = TPF::get_default_team_policy(ncol, m_nlay);
         TIMED_KERNEL(
         Kokkos::parallel_for(policy, KOKKOS_LAMBDA(const MemberType& team) {
@@ -919,7 +966,6 @@ void RRTMGPRadiation::run_impl (const double dt) {
         });
                      );
       }
-      Kokkos::fence();
 
 
       // Populate GasConcs object to pass to RRTMGP driver
@@ -977,7 +1023,6 @@ void RRTMGPRadiation::run_impl (const double dt) {
           });
         });
       }
-      Kokkos::fence();
 
       // Compute layer cloud mass (per unit area)
       interface_t::mixing_ratio_to_cloud_mass(qc_k, cldfrac_tot_k, p_del_k, lwp_k);
@@ -993,7 +1038,6 @@ void RRTMGPRadiation::run_impl (const double dt) {
         });
       });
       }
-      Kokkos::fence();
 
       // Compute band-by-band surface_albedos. This is needed since
       // the AD passes broadband albedos, but rrtmgp require band-by-band.
@@ -1051,7 +1095,6 @@ void RRTMGPRadiation::run_impl (const double dt) {
           });
         });
       }
-      Kokkos::fence();
                    );
 
       // Index to surface (bottom of model); used to get surface fluxes below
@@ -1162,6 +1205,7 @@ void RRTMGPRadiation::run_impl (const double dt) {
       });
                    );
     } // loop over chunk
+    Kokkos::fence();
 
     // Restore the refCounted array.
     m_gas_concs_k.concs = gas_concs_k;
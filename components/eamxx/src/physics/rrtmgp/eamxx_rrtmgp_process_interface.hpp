@@ -232,6 +232,10 @@ protected:
   // Computes total number of bytes needed for local variables
   size_t requested_buffer_size_in_bytes() const;
 
+  // Bytes per column of the chunk buffers, and estimate of the whole chunk working set
+  size_t chunk_buffer_bytes_per_col() const;
+  size_t chunk_bytes_per_col() const;
+
   // Set local variables using memory provided by
   // the ATMBufferManager
   void init_buffers(const ATMBufferManager &buffer_manager);
@@ -5,6 +5,10 @@
 #include "cpp/rrtmgp_const.h"
 #include "cpp/rrtmgp_conversion.h"
 
+#include <unistd.h>
+#include <algorithm>
+#include <limits>
+
 namespace scream {
 namespace rrtmgp {
 
@@ -49,6 +53,40 @@ inline bool radiation_do(const int irad, const int nstep) {
   }
 }
 
+// Default memory target for the working set of a radiation column chunk. On GPU,
+// parallelism comes from the columns, so we do not limit the chunk size. On CPU,
+// we want the chunk to stay in the last level cache while the gas optics, cloud
+// optics and flux solvers sweep over it several times. The cache is shared by all
+// the ranks on the node, so each rank only gets its share of it.
+inline size_t default_chunk_target_bytes(const bool on_gpu, const int ranks_per_node) {
+  if (on_gpu) {
+    return std::numeric_limits<size_t>::max();
+  }
+  long cache_size = -1;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+  cache_size = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+#ifdef _SC_LEVEL2_CACHE_SIZE
+  if (cache_size<=0) {
+    cache_size = sysconf(_SC_LEVEL2_CACHE_SIZE);
+  }
+#endif
+  const size_t node_bytes = cache_size>0 ? static_cast<size_t>(cache_size) : size_t(32)*1024*1024;
+  return node_bytes / std::max(ranks_per_node,1);
+}
+
+// Pick the largest chunk size whose working set fits in the target, but with at
+// least one column per thread. The chunks are then balanced, so that the last chunk
+// is not much smaller than the others (the buffers are sized for the largest chunk).
+inline int auto_col_chunk_size(const int ncol, const size_t bytes_per_col,
+                               const size_t target_bytes, const int concurrency) {
+  const int min_size = std::min(ncol,concurrency);
+  int size = static_cast<int>(std::min<size_t>(ncol,target_bytes/bytes_per_col));
+  size = std::max(size,std::max(min_size,1));
+  const int num_chunks = (ncol+size-1) / size;
+  return (ncol+num_chunks-1) / num_chunks;
+}
+
 // Verify that array only contains values within valid range, and if not
 // report min and max of array
 template <class T, typename std::enable_if<T::rank == 1>::type* dummy = nullptr>
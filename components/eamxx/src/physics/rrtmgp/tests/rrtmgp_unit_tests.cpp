@@ -432,6 +432,54 @@ TEST_CASE("rrtmgp_test_radiation_do_k") {
   REQUIRE(scream::rrtmgp::radiation_do(3, 6) == true);
 }
 
+TEST_CASE("rrtmgp_test_col_chunk_size") {
+  using scream::rrtmgp::auto_col_chunk_size;
+  using scream::rrtmgp::default_chunk_target_bytes;
+
+  // On GPU the chunk size is not limited
+  REQUIRE(default_chunk_target_bytes(true, 4) == std::numeric_limits<size_t>::max());
+  REQUIRE(auto_col_chunk_size(1000, 100, default_chunk_target_bytes(true, 4), 1) == 1000);
+
+  // On CPU the node cache is split among the ranks on the node
+  const auto node_bytes = default_chunk_target_bytes(false, 1);
+  REQUIRE(node_bytes > 0);
+  REQUIRE(default_chunk_target_bytes(false, 4) == node_bytes / 4);
+  REQUIRE(default_chunk_target_bytes(false, 0) == node_bytes);
+
+  // Everything fits in the target: one chunk
+  REQUIRE(auto_col_chunk_size(100, 10, 1000, 1) == 100);
+  REQUIRE(auto_col_chunk_size(100, 10, 5000, 1) == 100);
+
+  // 100 cols of 10 bytes with a 250 bytes target: 25 cols per chunk, 4 chunks
+  REQUIRE(auto_col_chunk_size(100, 10, 250, 1) == 25);
+
+  // 100 cols with a 300 bytes target: 30 cols fit, but 4 chunks are needed anyways,
+  // so they are balanced to 25 cols each, rather than 30+30+30+10
+  REQUIRE(auto_col_chunk_size(100, 10, 300, 1) == 25);
+
+  // 10 cols with a 70 bytes target: 2 chunks of 5 cols, rather than 7+3
+  REQUIRE(auto_col_chunk_size(10, 10, 70, 1) == 5);
+
+  // At least one column per thread, even if the target is exceeded
+  REQUIRE(auto_col_chunk_size(100, 10, 50, 20) == 20);
+  REQUIRE(auto_col_chunk_size(100, 10, 50, 200) == 100);
+
+  // At least one column, even if a single column exceeds the target
+  REQUIRE(auto_col_chunk_size(100, 10, 5, 1) == 1);
+  REQUIRE(auto_col_chunk_size(100, 10, 0, 0) == 1);
+
+  // The chunk size always covers ncol with balanced chunks
+  for (int ncol : {1, 7, 97, 128, 1000}) {
+    for (size_t target : {size_t(1), size_t(64), size_t(1000), size_t(100000)}) {
+      const int size = auto_col_chunk_size(ncol, 8, target, 4);
+      const int num_chunks = (ncol + size - 1) / size;
+      REQUIRE(size >= 1);
+      REQUIRE(size <= ncol);
+      REQUIRE(ncol - (num_chunks-1)*size > (num_chunks > 1 ? size - num_chunks : 0));
+    }
+  }
+}
+
 TEST_CASE("rrtmgp_test_check_range_k") {
   // Initialize Kokkos
   scream::init_kls();
@@ -108,6 +108,7 @@ void SPA::initialize_impl (const RunType /* run_type */)
   vremap_data.pmid = pmid;
   vremap_data.pint = pint;
   m_data_interpolation->create_vert_remapper (vremap_data);
+  m_data_interpolation->set_prefetch (m_params.get<bool>("spa_prefetch_data",false));
   m_data_interpolation->init_data_interval (start_of_step_ts());
 
   // Set property checks for fields in this process
@@ -2,6 +2,7 @@
 #define SCREAM_ATMOSPHERE_DIAGNOSTIC_HPP
 
 #include "share/atm_process/atmosphere_process.hpp"
+#include "share/field/field_sum_batch.hpp"
 
 namespace scream
 {
@@ -56,6 +57,11 @@ public:
   virtual void init_timestep (const util::TimeStamp& /* start_of_step */) {}
 
   void compute_diagnostic (const double dt = 0);
+
+  // Diags that need global sums can add their local partial sums to this batch,
+  // rather than doing the reduction right away. In that case, the diag output
+  // is valid only after the batch has been completed (see FieldSumBatch).
+  void set_sum_batch (const std::shared_ptr<FieldSumBatch>& batch) { m_sum_batch = batch; }
 protected:
 
   void set_required_field_impl (const Field& f) final;
@@ -75,6 +81,9 @@ protected:
 
   // Diagnostics are meant to return a field
   Field m_diagnostic_output;
+
+  // If set, global sums can be deferred to this batch
+  std::shared_ptr<FieldSumBatch> m_sum_batch;
 };
 
 // A short name for the factory for atmosphere diagnostics
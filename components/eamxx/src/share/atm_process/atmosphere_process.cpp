@@ -180,7 +180,14 @@ void AtmosphereProcess::run (const double dt) {
                               true, false, true);
 
     // Run derived class implementation
-    run_impl(dt_sub);
+    if (is_event_tracer_inited()) {
+      const auto trace_name = m_timer_prefix + this->name() + "::run_impl";
+      start_trace_event (trace_name, m_subcycle_iter);
+      run_impl(dt_sub);
+      stop_trace_event (trace_name);
+    } else {
+      run_impl(dt_sub);
+    }
 
     if (m_internal_diagnostics_level > 0)
       // Print hash of OUTPUTS/INTERNALS after run
@@ -550,14 +557,46 @@ void AtmosphereProcess::run_property_check (const prop_check_ptr&       property
   }
 }
 
+void AtmosphereProcess::
+run_property_checks (const std::list<std::pair<CheckFailHandling,prop_check_ptr>>& checks,
+                     FusedPropertyChecks&        fused_checks,
+                     const PropertyCheckCategory property_check_category) const
+{
+  if (not m_params.get("fuse_property_checks", true)) {
+    for (const auto& it : checks) {
+      run_property_check(it.second, it.first, property_check_category);
+    }
+    return;
+  }
+
+  if (fused_checks.num_checks()!=static_cast<int>(checks.size())) {
+    std::vector<prop_check_ptr> pcs;
+    for (const auto& it : checks) {
+      pcs.push_back(it.second);
+    }
+    fused_checks.set_checks(pcs);
+  }
+
+  // Only run the checks that may fail. However, if a check that can repair is run,
+  // the fields may change, so we run all the following checks.
+  const auto& needs_check = fused_checks.screen();
+  bool run_all = false;
+  int icheck = 0;
+  for (const auto& it : checks) {
+    if (run_all or needs_check[icheck]) {
+      run_property_check(it.second, it.first, property_check_category);
+      run_all |= it.second->can_repair();
+    }
+    ++icheck;
+  }
+}
+
 void AtmosphereProcess::run_precondition_checks () const {
   m_atm_logger->debug("[" + this->name() + "] run_precondition_checks...");
   start_timer(m_timer_prefix + this->name() + "::run-precondition-checks");
   // Run all pre-condition property checks
-  for (const auto& it : m_precondition_checks) {
-    run_property_check(it.second, it.first,
-                       PropertyCheckCategory::Precondition);
-  }
+  run_property_checks(m_precondition_checks, m_fused_precondition_checks,
+                      PropertyCheckCategory::Precondition);
   stop_timer(m_timer_prefix + this->name() + "::run-precondition-checks");
   m_atm_logger->debug("[" + this->name() + "] run_precondition_checks...done!");
 }
@@ -566,10 +605,8 @@ void AtmosphereProcess::run_postcondition_checks () const {
   m_atm_logger->debug("[" + this->name() + "] run_postcondition_checks...");
   start_timer(m_timer_prefix + this->name() + "::run-postcondition-checks");
   // Run all post-condition property checks
-  for (const auto& it : m_postcondition_checks) {
-    run_property_check(it.second, it.first,
-                       PropertyCheckCategory::Postcondition);
-  }
+  run_property_checks(m_postcondition_checks, m_fused_postcondition_checks,
+                      PropertyCheckCategory::Postcondition);
   stop_timer(m_timer_prefix + this->name() + "::run-postcondition-checks");
   m_atm_logger->debug("[" + this->name() + "] run_postcondition_checks...done!");
 }
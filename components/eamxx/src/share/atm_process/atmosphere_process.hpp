@@ -8,6 +8,7 @@
 #include "share/field/field_identifier.hpp"
 #include "share/field/field_manager.hpp"
 #include "share/property_checks/property_check.hpp"
+#include "share/property_checks/fused_property_checks.hpp"
 #include "share/field/field_request.hpp"
 #include "share/field/field.hpp"
 #include "share/field/field_group.hpp"
@@ -551,6 +552,12 @@ private:
                            const CheckFailHandling     check_fail_handling,
                            const PropertyCheckCategory property_check_category) const;
 
+  // Run a list of property checks. Unless disabled, the checks are first screened
+  // with a single fused kernel, and only those that may fail are run individually.
+  void run_property_checks (const std::list<std::pair<CheckFailHandling,prop_check_ptr>>& checks,
+                            FusedPropertyChecks&        fused_checks,
+                            const PropertyCheckCategory property_check_category) const;
+
   // NOTE: all these members are private, so that derived classes cannot
   //       bypass checks from the base class by accessing the members directly.
   //       Instead, they are forced to use access function, which include
@@ -581,6 +588,10 @@ private:
   std::list<std::pair<CheckFailHandling,prop_check_ptr>> m_precondition_checks;
   std::list<std::pair<CheckFailHandling,prop_check_ptr>> m_postcondition_checks;
 
+  // Fused screening of the checks above (lazily set up at the first run)
+  mutable FusedPropertyChecks m_fused_precondition_checks;
+  mutable FusedPropertyChecks m_fused_postcondition_checks;
+
   // Column local mass and energy conservation check
   std::pair<CheckFailHandling,prop_check_ptr> m_conservation;
 
@@ -429,12 +429,18 @@ void AtmProcDAG::cleanup () {
 }
 
 void AtmProcDAG::
-add_nodes (const group_type& atm_procs)
+add_nodes (const group_type& atm_procs, const int concurrent_beg)
 {
   const int num_procs = atm_procs.get_num_processes();
   const bool sequential = (atm_procs.get_schedule_type()==ScheduleType::Sequential);
 
-  EKAT_REQUIRE_MSG (sequential, "Error! Parallel splitting dag not yet supported.\n");
+  // In parallel splitting, the processes in the group cannot depend on each other.
+  // NOTE: nested groups inherit the bound of the outermost parallel group, which
+  //       is conservative if a sequential group is nested in a parallel one.
+  int beg = concurrent_beg;
+  if (not sequential and beg<0) {
+    beg = m_nodes.size();
+  }
 
   for (int i=0; i<num_procs; ++i) {
     const auto proc = atm_procs.get_process(i);
@@ -446,7 +452,7 @@ add_nodes (const group_type& atm_procs)
       // Add all the stuff in the group.
       // Note: no need to add remappers for this process, because
       //       the sub-group will have its remappers taken care of
-      add_nodes(*group);
+      add_nodes(*group,beg);
     } else {
       // Create a node for the process
       int id = m_nodes.size();
@@ -454,6 +460,7 @@ add_nodes (const group_type& atm_procs)
       Node& node = m_nodes.back();
       node.id = id;
       node.name = proc->name();
+      node.concurrent_beg = beg;
       m_unmet_deps[id].clear(); // Ensures an entry for this id is in the map
 
       // Input fields
@@ -523,13 +530,16 @@ add_nodes (const group_type& atm_procs)
 
 void AtmProcDAG::add_edges () {
   for (auto& node : m_nodes) {
+    // Providers must come before this node (or before its parallel group)
+    const int bound = node.concurrent_beg>=0 ? node.concurrent_beg : node.id;
+
     // First individual input fields. Add this node as a children
     // of any *previous* node that computes them. If none provides
     // them, add to the unmet deps list
     for (auto id : node.required) {
       auto it = m_fid_to_last_provider.find(id);
       // Note: check that last provider id is SMALLER than this node id
-      if (it!=m_fid_to_last_provider.end() and it->second<node.id) {
+      if (it!=m_fid_to_last_provider.end() and it->second<bound) {
         auto parent_id = it->second;
         m_nodes[parent_id].children.push_back(node.id);
       } else {
@@ -552,7 +562,7 @@ void AtmProcDAG::add_edges () {
       // First check when the group as a whole was last updated
       auto it = m_fid_to_last_provider.find(id);
       // Note: check that last provider id is SMALLER than this node id
-      if (it!=m_fid_to_last_provider.end() and it->second<node.id) {
+      if (it!=m_fid_to_last_provider.end() and it->second<bound) {
         last_group_update_id = it->second;
       }
       // Then check when each group member was last updated
@@ -562,7 +572,7 @@ void AtmProcDAG::add_edges () {
         auto fid_id = std::find(m_fids.begin(),m_fids.end(),fid) - m_fids.begin();
         it = m_fid_to_last_provider.find(fid_id);
         // Note: check that last provider id is SMALLER than this node id
-        if (it!=m_fid_to_last_provider.end() and it->second<node.id) {
+        if (it!=m_fid_to_last_provider.end() and it->second<bound) {
           last_members_update_id[i] = it->second;
         }
         ++i;
@@ -36,7 +36,9 @@ protected:
 
   void cleanup ();
 
-  void add_nodes (const group_type& atm_procs);
+  // If concurrent_beg>=0, the nodes are part of a parallel-split group,
+  // whose first node has id concurrent_beg (see Node::concurrent_beg)
+  void add_nodes (const group_type& atm_procs, const int concurrent_beg = -1);
 
   void add_edges ();
 
@@ -58,6 +60,12 @@ protected:
     std::set<int>     required;     // input  fields
     std::set<int>     gr_computed;  // output groups
     std::set<int>     gr_required;  // input  groups
+
+    // Only providers with id smaller than this can satisfy the deps of this node.
+    // For sequential splitting, this is the node id itself. For parallel splitting,
+    // all the processes in the group see the same input state, so this is the
+    // id of the first node of the group. If negative, the node id is used.
+    int               concurrent_beg = -1;
   };
 
   // Assign an id to each field identifier
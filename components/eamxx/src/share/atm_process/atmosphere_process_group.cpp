@@ -1,5 +1,7 @@
 #include "share/atm_process/atmosphere_process_group.hpp"
 #include "share/field/field_utils.hpp"
+#include "share/util/eamxx_runtime_stats.hpp"
+#include "share/util/eamxx_timing.hpp"
 
 #include "share/property_checks/field_nan_check.hpp"
 
@@ -8,6 +10,8 @@
 #include <ekat_assert.hpp>
 
 #include <memory>
+#include <map>
+#include <set>
 
 namespace scream {
 
@@ -25,7 +29,6 @@ AtmosphereProcessGroup (const ekat::Comm& comm, const ekat::ParameterList& param
       m_group_schedule_type = ScheduleType::Sequential;
     } else if (m_params.get<std::string>("schedule_type") == "parallel") {
       m_group_schedule_type = ScheduleType::Parallel;
-      EKAT_ERROR_MSG("Error! Parallel schedule not yet implemented.\n");
     } else {
       EKAT_ERROR_MSG("Error! Invalid 'schedule_type'. Available choices are 'parallel' and 'sequential'.\n");
     }
@@ -47,25 +50,11 @@ AtmosphereProcessGroup (const ekat::Comm& comm, const ekat::ParameterList& param
   // so we don't expect users to register the APG in the factory.
   apf.register_product("group",&create_atmosphere_process<AtmosphereProcessGroup>);
   for (const auto& ap_name : group_list) {
-    // The comm to be passed to the processes construction is
-    //  - the same as the comm of this APG, if num_entries=1 or sched_type=Sequential
-    //  - a sub-comm of this APG's comm otherwise
+    // The comm to be passed to the processes construction is the same as the comm
+    // of this APG, regardless of the schedule type. In parallel splitting, all procs
+    // run on all ranks, and differ from sequential splitting only in the input state
+    // they see (see run_parallel).
     ekat::Comm proc_comm = m_comm;
-    if (m_group_schedule_type==ScheduleType::Parallel) {
-      // This is what's going to happen when we implment this:
-      //  - the processes in the group are going to be run in parallel
-      //  - each rank is assigned ONE atm process
-      //  - all the atm processes not assigned to this rank will be filled with
-      //    an instance of "RemoteProcessStub" (to be implemented),
-      //    which is a do-nothing class, only responsible to keep track of dependencies
-      //  - the input parameter list should specify for each atm process the number
-      //    of mpi ranks dedicated to it. Obviously, these numbers should add up
-      //    to the size of the input communicator.
-      //  - this class is then responsible of 'combining' the results togehter,
-      //    including remapping input/output fields to/from the sub-comm
-      //    distribution.
-      EKAT_ERROR_MSG("Error! Parallel schedule type not yet implemented.\n");
-    }
 
     // Get the params of this atm proc
     auto& params_i = m_params.sublist(ap_name);
@@ -439,6 +428,85 @@ void AtmosphereProcessGroup::initialize_impl (const RunType run_type) {
     m_atm_logger->debug("[EAMxx::initialize::"+atm_proc->name()+"] memory usage: " + std::to_string(max_mem_usage) + "MB");
 #endif
   }
+
+  if (m_group_schedule_type==ScheduleType::Parallel) {
+    setup_parallel_splitting();
+  }
+}
+
+void AtmosphereProcessGroup::setup_parallel_splitting () {
+  // For each process, gather the ids of the fields it reads and computes.
+  // Fields in groups are processed individually, since the monolithic
+  // field (if any) is just a container of the individual fields.
+  using fid_set_t = std::set<FieldIdentifier>;
+  std::vector<fid_set_t> required(m_group_size), computed(m_group_size);
+  std::map<FieldIdentifier,Field> computed_fields;
+  std::map<FieldIdentifier,std::vector<int>> providers;
+  for (int iproc=0; iproc<m_group_size; ++iproc) {
+    const auto& atm_proc = m_atm_processes[iproc];
+    auto add_computed = [&](const Field& f) {
+      const auto& fid = f.get_header().get_identifier();
+      if (computed[iproc].insert(fid).second) {
+        computed_fields.emplace(fid,f);
+        providers[fid].push_back(iproc);
+      }
+    };
+    auto add_required = [&](const Field& f) {
+      required[iproc].insert(f.get_header().get_identifier());
+    };
+
+    for (const auto& f : atm_proc->get_fields_out()) {
+      add_computed(f);
+    }
+    for (const auto& g : atm_proc->get_groups_out()) {
+      for (const auto& it : g.m_individual_fields) {
+        add_computed(*it.second);
+      }
+    }
+    for (const auto& f : atm_proc->get_fields_in()) {
+      add_required(f);
+    }
+    for (const auto& g : atm_proc->get_groups_in()) {
+      for (const auto& it : g.m_individual_fields) {
+        add_required(*it.second);
+      }
+    }
+  }
+
+  // A computed field needs splitting if it is computed by more than one process,
+  // or if it is computed by one process and read by another one. All other
+  // computed fields can be safely updated in place by their only provider.
+  m_split_fields.clear();
+  m_proc_split_fields.clear();
+  m_proc_split_fields.resize(m_group_size);
+  for (const auto& it : computed_fields) {
+    const auto& fid   = it.first;
+    const auto& procs = providers.at(fid);
+
+    bool needs_split = procs.size()>1;
+    for (int iproc=0; iproc<m_group_size and not needs_split; ++iproc) {
+      needs_split = iproc!=procs.front() and required[iproc].count(fid)==1;
+    }
+    if (not needs_split) {
+      continue;
+    }
+
+    EKAT_REQUIRE_MSG (fid.data_type()==DataType::RealType,
+        "Error! Parallel splitting is only supported for real-valued fields.\n"
+        "  - atm proc group: " + name() + "\n"
+        "  - field name    : " + fid.name() + "\n"
+        "  - data type     : " + e2str(fid.data_type()) + "\n");
+
+    SplitField sf;
+    sf.f      = it.second;
+    sf.f_beg  = sf.f.clone();
+    sf.f_out  = sf.f.clone();
+    sf.single_provider = procs.size()==1;
+    for (int iproc : procs) {
+      m_proc_split_fields[iproc].push_back(m_split_fields.size());
+    }
+    m_split_fields.push_back(sf);
+  }
 }
 
 void AtmosphereProcessGroup::run_impl (const double dt) {
@@ -455,21 +523,70 @@ void AtmosphereProcessGroup::run_sequential (const double dt) {
   //  - nobody from outside told this APG to not update timestamps
   const bool do_update = do_update_time_stamp() &&
                       (get_subcycle_iter()==get_num_subcycles()-1);
+  const bool trace = is_event_tracer_inited();
   for (auto atm_proc : m_atm_processes) {
     atm_proc->set_update_time_stamps(do_update);
     // Run the process
-    atm_proc->run(dt);
+    if (trace) {
+      const auto trace_name = "EAMxx::" + name() + "::run_sequential::" + atm_proc->name();
+      start_trace_event(trace_name, get_subcycle_iter());
+      atm_proc->run(dt);
+      stop_trace_event(trace_name);
+    } else {
+      atm_proc->run(dt);
+    }
 #ifdef SCREAM_HAS_MEMORY_USAGE
-    long long my_mem_usage = get_mem_usage(MB);
-    long long max_mem_usage;
-    m_comm.all_reduce(&my_mem_usage,&max_mem_usage,1,MPI_MAX);
-    m_atm_logger->debug("[EAMxx::run_sequential::"+atm_proc->name()+"] memory usage: " + std::to_string(max_mem_usage) + "MB");
+    // Reduced across ranks (and logged) at the runtime stats cadence, to avoid a global sync here
+    record_runtime_stat("[EAMxx::run_sequential::"+atm_proc->name()+"] memory usage",
+                        get_mem_usage(MB),"MB",LogLevel::debug);
 #endif
   }
 }
 
-void AtmosphereProcessGroup::run_parallel (const double /* dt */) {
-  EKAT_REQUIRE_MSG (false,"Error! Parallel splitting not yet implemented.\n");
+void AtmosphereProcessGroup::run_parallel (const double dt) {
+  // In parallel splitting, all atm procs see the same input state, namely
+  // the state at the beginning of the group step. After each proc runs, we
+  // save its contribution to the split fields, and restore their start-of-step
+  // value. At the end, the output is the start-of-step value plus the sum of
+  // the increments of all procs.
+  const bool do_update = do_update_time_stamp() &&
+                      (get_subcycle_iter()==get_num_subcycles()-1);
+
+  for (auto& sf : m_split_fields) {
+    sf.f_beg.deep_copy(sf.f);
+    if (not sf.single_provider) {
+      sf.f_out.deep_copy(sf.f);
+    }
+  }
+
+  for (int iproc=0; iproc<m_group_size; ++iproc) {
+    auto atm_proc = m_atm_processes[iproc];
+    atm_proc->set_update_time_stamps(do_update);
+    // Run the process
+    atm_proc->run(dt);
+
+    for (int idx : m_proc_split_fields[iproc]) {
+      auto& sf = m_split_fields[idx];
+      if (sf.single_provider) {
+        // No need to sum increments: simply stash the proc output (this is also BFB)
+        sf.f_out.deep_copy(sf.f);
+      } else {
+        // f_out += f - f_beg
+        sf.f_out.update(sf.f,1,1);
+        sf.f_out.update(sf.f_beg,-1,1);
+      }
+      sf.f.deep_copy(sf.f_beg);
+    }
+#ifdef SCREAM_HAS_MEMORY_USAGE
+    record_runtime_stat("[EAMxx::run_parallel::"+atm_proc->name()+"] memory usage",
+                        get_mem_usage(MB),"MB",LogLevel::debug);
+#endif
+  }
+
+  // Now that all procs ran, set the combined result in the split fields
+  for (auto& sf : m_split_fields) {
+    sf.f.deep_copy(sf.f_out);
+  }
 }
 
 void AtmosphereProcessGroup::finalize_impl (/* what inputs? */) {
@@ -490,6 +607,7 @@ set_required_field (const Field& f) {
     // In parallel splitting, all required fields are *actual* inputs,
     // and the base class impl is fine.
     AtmosphereProcess::set_required_field(f);
+    return;
   }
 
   // Find the first process that requires this group
@@ -558,6 +676,7 @@ set_required_group (const FieldGroup& group) {
     // In parallel splitting, all required group are *actual* inputs,
     // and the base class impl is fine.
     AtmosphereProcess::set_required_group(group);
+    return;
   }
 
   // Find the first process that requires this group
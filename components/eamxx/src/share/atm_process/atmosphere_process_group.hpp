@@ -24,6 +24,10 @@ namespace scream
  *  The only caveat is required fields in sequential scheduling: if an atm proc
  *  requires a field that is computed by a previous atm proc in the group,
  *  that field is not exposed as a required field of the group.
+ *
+ *  In parallel scheduling, all atm procs see the same input state (the one at
+ *  the beginning of the group run), and the output of the group is the input
+ *  state plus the sum of the increments computed by each atm proc.
  */
 
 class AtmosphereProcessGroup : public AtmosphereProcess
@@ -132,6 +136,10 @@ protected:
   void run_sequential (const double dt);
   void run_parallel   (const double dt);
 
+  // Find the fields that need special handling in parallel splitting,
+  // and allocate the auxiliary fields needed to handle them
+  void setup_parallel_splitting ();
+
   // The methods to set the fields/groups in the right processes of the group
   void set_required_field_impl (const Field& f);
   void set_computed_field_impl (const Field& f);
@@ -150,6 +158,21 @@ protected:
 
   // This is only needed to be able to access grids objects later on
   std::shared_ptr<const GridsManager>   m_grids_mgr;
+
+  // In parallel splitting, a field computed by more than one atm proc, or computed
+  // by one atm proc and required by another, needs to be reset to its start-of-step
+  // value after each atm proc runs, while the atm procs contributions are
+  // accumulated in a separate buffer.
+  struct SplitField {
+    Field f;      // The field seen by the atm procs
+    Field f_beg;  // The value at the beginning of the group run
+    Field f_out;  // The accumulated output of the atm procs
+    bool  single_provider;
+  };
+  std::vector<SplitField>         m_split_fields;
+
+  // For each atm proc, the indices (in m_split_fields) of the split fields it computes
+  std::vector<std::vector<int>>   m_proc_split_fields;
 };
 
 } // namespace scream
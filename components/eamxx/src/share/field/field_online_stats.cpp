@@ -0,0 +1,201 @@
+#include "share/field/field_online_stats.hpp"
+
+namespace scream
+{
+
+namespace {
+
+using KT = KokkosTypes<DefaultDevice>;
+
+// Like in FieldTally, arrays are seen as 2d, with the last dim possibly padded
+int last_dim (const Field& f) {
+  const auto& layout = f.get_header().get_identifier().get_layout();
+  return layout.rank()==0 ? 1 : layout.dims().back();
+}
+
+int leading_dim (const Field& f) {
+  const auto& layout = f.get_header().get_identifier().get_layout();
+  return layout.rank()==0 ? 1 : f.get_header().get_alloc_properties().get_last_extent();
+}
+
+void check_field (const Field& f, const DataType dt, const std::string& func) {
+  EKAT_REQUIRE_MSG (f.is_allocated(),
+      "Error! Input field to " + func + " is not allocated.\n"
+      " - field name: " + f.name() + "\n");
+  EKAT_REQUIRE_MSG (f.data_type()==dt,
+      "Error! Input field to " + func + " has the wrong data type.\n"
+      " - field name: " + f.name() + "\n");
+  EKAT_REQUIRE_MSG (not f.get_header().get_alloc_properties().is_subfield(),
+      "Error! Input field to " + func + " cannot be a subfield.\n"
+      " - field name: " + f.name() + "\n");
+}
+
+struct WelfordKernel {
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int idx) const {
+    const int i = idx / dim;
+    const int j = idx % dim;
+    const auto xv = x[i*x_ld + j];
+    if (xv==constants::fill_value<Real>) {
+      return;
+    }
+    const int k = i*y_ld + j;
+    const Real n = count==nullptr ? nsamples : count[i*c_ld + j];
+    const Real delta = xv - mean[k];
+    mean[k] += delta / n;
+    m2[k] += delta*(xv - mean[k]);
+  }
+
+  const Real* x;
+  Real*       mean;
+  Real*       m2;
+  const int*  count;
+  int         nsamples;
+  int         dim, x_ld, y_ld, c_ld;
+};
+
+struct HistogramKernel {
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int idx) const {
+    const int i = idx / dim;
+    const int j = idx % dim;
+    const auto xv = x[i*x_ld + j];
+    const int nbins = edges.extent(0) - 1;
+    if (xv==constants::fill_value<Real> or xv<edges(0) or not (xv<edges(nbins))) {
+      return;
+    }
+    // Find k such that edges(k)<=xv<edges(k+1) (the edges are sorted)
+    int beg = 0, end = nbins;
+    while (end-beg>1) {
+      const int mid = (beg+end) / 2;
+      if (edges(mid)<=xv) {
+        beg = mid;
+      } else {
+        end = mid;
+      }
+    }
+    hist[idx*nbins + beg] += 1;
+  }
+
+  const Real* x;
+  Real*       hist;
+  KT::view_1d<const Real> edges;
+  int         dim, x_ld;
+};
+
+struct ExceedanceKernel {
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int idx) const {
+    const int i = idx / dim;
+    const int j = idx % dim;
+    const auto xv = x[i*x_ld + j];
+    if (xv!=constants::fill_value<Real> and xv>threshold) {
+      y[i*y_ld + j] += 1;
+    }
+  }
+
+  const Real* x;
+  Real*       y;
+  Real        threshold;
+  int         dim, x_ld, y_ld;
+};
+
+} // anonymous namespace
+
+void update_welford (const Field& x, const Field& count, const int nsamples,
+                     const Field& mean, const Field& m2)
+{
+  const auto& layout = x.get_header().get_identifier().get_layout();
+  EKAT_REQUIRE_MSG (mean.get_header().get_identifier().get_layout()==layout and
+                    m2.get_header().get_identifier().get_layout()==layout,
+      "Error! Incompatible layouts for update_welford.\n"
+      " - x name   : " + x.name() + "\n"
+      " - mean name: " + mean.name() + "\n"
+      " - m2 name  : " + m2.name() + "\n");
+  check_field(x,get_data_type<Real>(),"update_welford");
+  check_field(mean,get_data_type<Real>(),"update_welford");
+  check_field(m2,get_data_type<Real>(),"update_welford");
+  EKAT_REQUIRE_MSG (leading_dim(mean)==leading_dim(m2),
+      "Error! The mean and m2 fields in update_welford must have the same padding.\n");
+
+  WelfordKernel k;
+  k.x     = x.get_internal_view_data<const Real>();
+  k.mean  = mean.get_internal_view_data<Real>();
+  k.m2    = m2.get_internal_view_data<Real>();
+  k.count = nullptr;
+  k.nsamples = nsamples;
+  k.dim   = last_dim(x);
+  k.x_ld  = leading_dim(x);
+  k.y_ld  = leading_dim(mean);
+  k.c_ld  = 0;
+  if (count.is_allocated()) {
+    EKAT_REQUIRE_MSG (count.get_header().get_identifier().get_layout().congruent(layout),
+        "Error! Incompatible layouts for update_welford.\n"
+        " - x name    : " + x.name() + "\n"
+        " - count name: " + count.name() + "\n");
+    check_field(count,DataType::IntType,"update_welford");
+    k.count = count.get_internal_view_data<const int>();
+    k.c_ld  = leading_dim(count);
+  } else {
+    EKAT_REQUIRE_MSG (nsamples>0,
+        "Error! Invalid number of samples in update_welford.\n"
+        " - nsamples: " + std::to_string(nsamples) + "\n");
+  }
+
+  Kokkos::RangePolicy<KT::ExeSpace> policy(0,layout.size());
+  Kokkos::parallel_for("update_welford",policy,k);
+}
+
+void update_histogram (const Field& x, const KT::view_1d<const Real>& edges,
+                       const Field& hist)
+{
+  const int nbins = edges.extent_int(0) - 1;
+  EKAT_REQUIRE_MSG (nbins>0,
+      "Error! update_histogram requires at least two bin edges.\n");
+  const auto& layout = x.get_header().get_identifier().get_layout();
+  const auto& h_layout = hist.get_header().get_identifier().get_layout();
+  EKAT_REQUIRE_MSG (h_layout.rank()==layout.rank()+1 and h_layout.dims().back()==nbins and
+                    h_layout.clone().strip_dim(layout.rank()).congruent(layout),
+      "Error! Incompatible layouts for update_histogram.\n"
+      " - x name   : " + x.name() + "\n"
+      " - hist name: " + hist.name() + "\n");
+  check_field(x,get_data_type<Real>(),"update_histogram");
+  check_field(hist,get_data_type<Real>(),"update_histogram");
+  EKAT_REQUIRE_MSG (leading_dim(hist)==nbins,
+      "Error! The histogram field in update_histogram cannot be padded.\n"
+      " - hist name: " + hist.name() + "\n");
+
+  HistogramKernel k;
+  k.x     = x.get_internal_view_data<const Real>();
+  k.hist  = hist.get_internal_view_data<Real>();
+  k.edges = edges;
+  k.dim   = last_dim(x);
+  k.x_ld  = leading_dim(x);
+
+  Kokkos::RangePolicy<KT::ExeSpace> policy(0,layout.size());
+  Kokkos::parallel_for("update_histogram",policy,k);
+}
+
+void update_exceedance (const Field& x, const Real threshold, const Field& exceed)
+{
+  const auto& layout = x.get_header().get_identifier().get_layout();
+  EKAT_REQUIRE_MSG (exceed.get_header().get_identifier().get_layout()==layout,
+      "Error! Incompatible layouts for update_exceedance.\n"
+      " - x name     : " + x.name() + "\n"
+      " - exceed name: " + exceed.name() + "\n");
+  check_field(x,get_data_type<Real>(),"update_exceedance");
+  check_field(exceed,get_data_type<Real>(),"update_exceedance");
+
+  ExceedanceKernel k;
+  k.x     = x.get_internal_view_data<const Real>();
+  k.y     = exceed.get_internal_view_data<Real>();
+  k.threshold = threshold;
+  k.dim   = last_dim(x);
+  k.x_ld  = leading_dim(x);
+  k.y_ld  = leading_dim(exceed);
+
+  Kokkos::RangePolicy<KT::ExeSpace> policy(0,layout.size());
+  Kokkos::parallel_for("update_exceedance",policy,k);
+}
+
+} // namespace scream
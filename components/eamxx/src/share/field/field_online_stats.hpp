@@ -0,0 +1,38 @@
+#ifndef SCREAM_FIELD_ONLINE_STATS_HPP
+#define SCREAM_FIELD_ONLINE_STATS_HPP
+
+#include "share/field/field.hpp"
+
+namespace scream
+{
+
+/*
+ * Online (i.e., one sample at a time) statistics of a field, accumulated on device
+ *
+ * These are used by output streams with averaging type Variance, Histogram,
+ * or Exceedance, and update the statistics with the current value of x.
+ * In all cases, entries of x equal to fill_value are skipped.
+ *
+ * The input field x must be of type Real, and must not be a subfield (padding is fine).
+ * The output fields must be of type Real (int for count), and must not be subfields.
+ */
+
+// Welford update of the mean and of the sum of squared deviations from the mean (m2).
+// If count is allocated, it holds the number of samples of each entry (including x),
+// and must have a layout congruent to that of x. Otherwise, all entries have nsamples samples.
+// At the end of the accumulation window, the (population) variance is m2/n.
+void update_welford (const Field& x, const Field& count, const int nsamples,
+                     const Field& mean, const Field& m2);
+
+// Add one to the bin containing each entry of x. The layout of hist must be that of x
+// with an extra (last) dimension, of size edges.size()-1. The k-th bin is [edges[k],edges[k+1]),
+// and values outside of [edges.front(),edges.back()) are not counted.
+void update_histogram (const Field& x, const KokkosTypes<DefaultDevice>::view_1d<const Real>& edges,
+                       const Field& hist);
+
+// Add one to each entry of exceed where x>threshold. The two fields must have the same layout.
+void update_exceedance (const Field& x, const Real threshold, const Field& exceed);
+
+} // namespace scream
+
+#endif // SCREAM_FIELD_ONLINE_STATS_HPP
@@ -0,0 +1,80 @@
+#include "share/field/field_quantize.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace scream
+{
+
+namespace {
+
+struct BitRoundKernel {
+  using uint_t = std::conditional_t<sizeof(Real)==8,std::uint64_t,std::uint32_t>;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int idx) const {
+    const auto v = x[idx];
+    if (v==constants::fill_value<Real> or not Kokkos::isfinite(v)) {
+      return;
+    }
+    // Round to nearest (ties to even) in the kept bits, then drop the trailing ones.
+    // A carry into the exponent is fine: it gives the correctly rounded value.
+    auto bits = Kokkos::bit_cast<uint_t>(v);
+    bits += half_minus_one + ((bits >> shift) & 1);
+    x[idx] = Kokkos::bit_cast<Real>(bits & mask);
+  }
+
+  Real*   x;
+  int     shift;          // Number of dropped mantissa bits
+  uint_t  half_minus_one;
+  uint_t  mask;
+};
+
+} // anonymous namespace
+
+int significant_digits_to_bits (const int digits)
+{
+  EKAT_REQUIRE_MSG (digits>0,
+      "Error! The number of significant digits must be positive.\n"
+      " - digits: " + std::to_string(digits) + "\n");
+  return static_cast<int>(std::ceil(digits*std::log2(10.0)));
+}
+
+void bitround (const Field& f, const int nsb)
+{
+  EKAT_REQUIRE_MSG (f.is_allocated(),
+      "Error! Input field to bitround is not allocated.\n"
+      " - field name: " + f.name() + "\n");
+  EKAT_REQUIRE_MSG (f.data_type()==get_data_type<Real>(),
+      "Error! Input field to bitround must have data type Real.\n"
+      " - field name: " + f.name() + "\n");
+  EKAT_REQUIRE_MSG (not f.get_header().get_alloc_properties().is_subfield(),
+      "Error! Input field to bitround cannot be a subfield.\n"
+      " - field name: " + f.name() + "\n");
+  EKAT_REQUIRE_MSG (not f.is_read_only(),
+      "Error! Input field to bitround is read-only.\n"
+      " - field name: " + f.name() + "\n");
+  EKAT_REQUIRE_MSG (nsb>0,
+      "Error! The number of significant bits in bitround must be positive.\n"
+      " - nsb: " + std::to_string(nsb) + "\n");
+
+  using uint_t = BitRoundKernel::uint_t;
+  constexpr int mantissa_bits = std::numeric_limits<Real>::digits - 1;
+  if (nsb>=mantissa_bits) {
+    return;
+  }
+
+  BitRoundKernel k;
+  k.x     = f.get_internal_view_data<Real>();
+  k.shift = mantissa_bits - nsb;
+  k.half_minus_one = (uint_t(1) << (k.shift-1)) - 1;
+  k.mask  = ~((uint_t(1) << k.shift) - 1);
+
+  const int size = f.get_header().get_alloc_properties().get_num_scalars();
+  Kokkos::RangePolicy<KokkosTypes<DefaultDevice>::ExeSpace> policy(0,size);
+  Kokkos::parallel_for("bitround",policy,k);
+}
+
+} // namespace scream
@@ -0,0 +1,29 @@
+#ifndef SCREAM_FIELD_QUANTIZE_HPP
+#define SCREAM_FIELD_QUANTIZE_HPP
+
+#include "share/field/field.hpp"
+
+namespace scream
+{
+
+/*
+ * Lossy quantization of field data, used by output streams to reduce storage
+ *
+ * BitRound (Klower et al, 2021) rounds each value to the nearest number with
+ * only nsb significant bits in the mantissa (ties to even), and sets the trailing
+ * bits to zero. The zeroed bits make the data much more compressible (e.g., by
+ * the deflate filter of netCDF4 files). The relative error is at most 2^-(nsb+1).
+ */
+
+// Number of mantissa bits needed to preserve the given number of decimal significant digits
+int significant_digits_to_bits (const int digits);
+
+// Apply BitRound in place to all entries of f (padding included). Entries equal
+// to fill_value, as well as inf/nan, are not modified. If nsb is larger than
+// or equal to the number of mantissa bits of Real, this is a no-op.
+// The field must be of type Real, and must not be a subfield.
+void bitround (const Field& f, const int nsb);
+
+} // namespace scream
+
+#endif // SCREAM_FIELD_QUANTIZE_HPP
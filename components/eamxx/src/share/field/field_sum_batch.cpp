@@ -0,0 +1,118 @@
+#include "share/field/field_sum_batch.hpp"
+
+namespace scream
+{
+
+FieldSumBatch::FieldSumBatch (const ekat::Comm& comm)
+ : m_comm (comm)
+ , m_offsets (1,0)
+{
+  // Nothing else to do
+}
+
+FieldSumBatch::~FieldSumBatch ()
+{
+  // Do not leave a dangling request around
+  if (m_started) {
+    MPI_Wait(&m_request,MPI_STATUS_IGNORE);
+  }
+}
+
+void FieldSumBatch::add (const Field& f, const callback_type& post)
+{
+  EKAT_REQUIRE_MSG (not m_started,
+      "Error! Cannot add fields to a FieldSumBatch after calling start().\n"
+      " - field name: " + f.name() + "\n");
+  EKAT_REQUIRE_MSG (f.is_allocated(),
+      "Error! Cannot add a non-allocated field to a FieldSumBatch.\n"
+      " - field name: " + f.name() + "\n");
+  EKAT_REQUIRE_MSG (f.data_type()==get_data_type<Real>(),
+      "Error! FieldSumBatch only supports fields of type Real.\n"
+      " - field name: " + f.name() + "\n"
+      " - data type : " + e2str(f.data_type()) + "\n");
+  const auto& ap = f.get_header().get_alloc_properties();
+  EKAT_REQUIRE_MSG (ap.contiguous() and not ap.is_subfield() and ap.get_padding()==0,
+      "Error! FieldSumBatch requires fields with contiguous data and no padding.\n"
+      " - field name: " + f.name() + "\n");
+
+  m_fields.push_back(f);
+  m_callbacks.push_back(post);
+  m_offsets.push_back(m_offsets.back()+f.get_header().get_identifier().get_layout().size());
+}
+
+bool FieldSumBatch::is_pending (const Field& f) const
+{
+  for (const auto& pf : m_fields) {
+    if (pf.is_aliasing(f)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void FieldSumBatch::start ()
+{
+  EKAT_REQUIRE_MSG (not m_started,
+      "Error! FieldSumBatch::start() was already called.\n");
+  if (m_fields.empty()) {
+    return;
+  }
+
+  const int size = m_offsets.back();
+  if (static_cast<int>(m_buf.size())<size) {
+    m_buf = decltype(m_buf)("field_sum_batch_buf",size);
+    m_buf_h = Kokkos::create_mirror_view(m_buf);
+  }
+
+  // Pack all fields in the device buffer, then copy to host at once
+  using exec_space = KT::ExeSpace;
+  using range_t = std::pair<int,int>;
+  for (size_t i=0; i<m_fields.size(); ++i) {
+    const auto& f = m_fields[i];
+    KT::view_1d<const Real> src (f.get_internal_view_data<const Real>(),m_offsets[i+1]-m_offsets[i]);
+    auto dst = Kokkos::subview(m_buf,range_t(m_offsets[i],m_offsets[i+1]));
+    Kokkos::deep_copy(exec_space(),dst,src);
+  }
+  Kokkos::deep_copy(m_buf_h,m_buf);
+
+  MPI_Iallreduce(MPI_IN_PLACE,m_buf_h.data(),size,ekat::get_mpi_type<Real>(),
+                 MPI_SUM,m_comm.mpi_comm(),&m_request);
+  m_started = true;
+}
+
+void FieldSumBatch::wait ()
+{
+  if (not m_started) {
+    start();
+  }
+  if (m_fields.empty()) {
+    return;
+  }
+
+  MPI_Wait(&m_request,MPI_STATUS_IGNORE);
+  m_started = false;
+
+  // Unpack the buffer in the fields
+  using exec_space = KT::ExeSpace;
+  using range_t = std::pair<int,int>;
+  Kokkos::deep_copy(m_buf,m_buf_h);
+  for (size_t i=0; i<m_fields.size(); ++i) {
+    const auto& f = m_fields[i];
+    KT::view_1d<Real> dst (f.get_internal_view_data<Real>(),m_offsets[i+1]-m_offsets[i]);
+    auto src = Kokkos::subview(m_buf,range_t(m_offsets[i],m_offsets[i+1]));
+    Kokkos::deep_copy(exec_space(),dst,src);
+  }
+  Kokkos::fence();
+
+  for (const auto& post : m_callbacks) {
+    if (post) {
+      post();
+    }
+  }
+
+  m_fields.clear();
+  m_callbacks.clear();
+  m_offsets.resize(1);
+}
+
+} // namespace scream
@@ -0,0 +1,72 @@
+#ifndef SCREAM_FIELD_SUM_BATCH_HPP
+#define SCREAM_FIELD_SUM_BATCH_HPP
+
+#include "share/field/field.hpp"
+
+#include <ekat_comm.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace scream
+{
+
+/*
+ * A class to batch the global (i.e., across ranks) sums of several fields
+ *
+ * Some diagnostics (e.g., horizontal or zonal averages) compute partial sums
+ * on each rank, which must then be summed across ranks. Rather than doing one
+ * blocking all_reduce per field, each diag can add its field(s) to this batch.
+ * Once all fields are added, start() packs them in a single buffer, and launches
+ * one non-blocking MPI_Iallreduce. Later, wait() completes the reduction, copies
+ * the global sums back in the fields, and calls the post-processing callbacks
+ * of each field (if any), in the order the fields were added.
+ *
+ * NOTE: start and wait are collective, so all ranks must add the same fields
+ *       (with the same sizes), in the same order.
+ */
+
+class FieldSumBatch
+{
+public:
+  using callback_type = std::function<void()>;
+
+  explicit FieldSumBatch (const ekat::Comm& comm);
+  ~FieldSumBatch ();
+
+  // Add a field, whose values will be summed across ranks. The field must be
+  // of Real type, and its data must be contiguous (no padding, no subfields).
+  // The callback (if any) is called in wait(), once f contains the global sum.
+  void add (const Field& f, const callback_type& post = {});
+
+  // Whether the global sum of this field has not been completed yet
+  bool is_pending (const Field& f) const;
+
+  bool empty () const { return m_fields.empty(); }
+
+  // Launch the reduction of all the fields added so far
+  void start ();
+
+  // Complete the reduction (calling start first, if needed), and reset the batch
+  void wait ();
+
+protected:
+  using KT = KokkosTypes<DefaultDevice>;
+
+  ekat::Comm                  m_comm;
+
+  std::vector<Field>          m_fields;
+  std::vector<callback_type>  m_callbacks;
+  std::vector<int>            m_offsets;
+
+  // The buffer is grown as needed, and never shrunk
+  KT::view_1d<Real>           m_buf;
+  KT::view_1d<Real>::HostMirror m_buf_h;
+
+  MPI_Request                 m_request = MPI_REQUEST_NULL;
+  bool                        m_started = false;
+};
+
+} // namespace scream
+
+#endif // SCREAM_FIELD_SUM_BATCH_HPP
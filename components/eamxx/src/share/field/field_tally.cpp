@@ -0,0 +1,184 @@
+#include "share/field/field_tally.hpp"
+
+namespace scream
+{
+
+namespace {
+
+template<CombineMode CM>
+struct TallyKernel
+{
+  using KT = FieldTally::KT;
+
+  KOKKOS_INLINE_FUNCTION
+  void operator() (const int idx) const {
+    // Find the entry this index belongs to (the offsets are sorted)
+    int beg = 0, end = entries.extent(0);
+    while (end-beg>1) {
+      const int mid = (beg+end) / 2;
+      if (offsets(mid)<=idx) {
+        beg = mid;
+      } else {
+        end = mid;
+      }
+    }
+    const auto& e = entries(beg);
+    const int i = (idx - offsets(beg)) / e.dim;
+    const int j = (idx - offsets(beg)) % e.dim;
+    const auto x = e.x[i*e.x_ld + j];
+    if (e.count!=nullptr) {
+      const int m = x!=constants::fill_value<Real> ? 1 : 0;
+      e.mask[i*e.y_ld + j] = m;
+      e.count[i*e.y_ld + j] += m;
+    } else if (e.fill_aware) {
+      combine<CM,true>(x,e.y[i*e.y_ld + j],Real(1),Real(1));
+    } else {
+      combine<CM,false>(x,e.y[i*e.y_ld + j],Real(1),Real(1));
+    }
+  }
+
+  KT::view_1d<const FieldTally::Entry> entries;
+  KT::view_1d<const int>               offsets;
+};
+
+template<CombineMode CM>
+void run_tally (const FieldTally::KT::view_1d<FieldTally::Entry>& entries,
+                const FieldTally::KT::view_1d<int>& offsets,
+                const int size)
+{
+  TallyKernel<CM> kernel;
+  kernel.entries = entries;
+  kernel.offsets = offsets;
+  Kokkos::RangePolicy<FieldTally::KT::ExeSpace> policy(0,size);
+  Kokkos::parallel_for("FieldTally::run",policy,kernel);
+}
+
+} // anonymous namespace
+
+FieldTally::FieldTally (const CombineMode cm)
+ : m_cm (cm)
+ , m_offsets (1,0)
+{
+  EKAT_REQUIRE_MSG (cm==CombineMode::Update or cm==CombineMode::Max or cm==CombineMode::Min,
+      "Error! FieldTally only supports Update, Max, and Min combine modes.\n");
+}
+
+bool FieldTally::add_field (const Field& x, const Field& y)
+{
+  EKAT_REQUIRE_MSG (not m_closed,
+      "Error! Cannot add fields to a FieldTally after calling close().\n");
+
+  const auto& layout = x.get_header().get_identifier().get_layout();
+  EKAT_REQUIRE_MSG (y.get_header().get_identifier().get_layout()==layout,
+      "Error! Incompatible layouts for FieldTally::add_field.\n"
+      " - x name: " + x.name() + "\n"
+      " - y name: " + y.name() + "\n");
+  if (not is_supported(x,get_data_type<Real>()) or not is_supported(y,get_data_type<Real>()) or
+      y.is_read_only()) {
+    return false;
+  }
+
+  Entry e;
+  e.x     = x.get_internal_view_data<const Real>();
+  e.y     = y.get_internal_view_data<Real>();
+  e.count = nullptr;
+  e.mask  = nullptr;
+  e.dim   = layout.rank()==0 ? 1 : layout.dims().back();
+  e.x_ld  = layout.rank()==0 ? 1 : x.get_header().get_alloc_properties().get_last_extent();
+  e.y_ld  = layout.rank()==0 ? 1 : y.get_header().get_alloc_properties().get_last_extent();
+  e.fill_aware = x.get_header().may_be_filled();
+  add_entry(e,layout.size());
+  return true;
+}
+
+bool FieldTally::add_count (const Field& x, const Field& count, const Field& mask)
+{
+  EKAT_REQUIRE_MSG (not m_closed,
+      "Error! Cannot add counts to a FieldTally after calling close().\n");
+
+  const auto& layout = x.get_header().get_identifier().get_layout();
+  EKAT_REQUIRE_MSG (count.get_header().get_identifier().get_layout().congruent(layout) and
+                    mask.get_header().get_identifier().get_layout().congruent(layout),
+      "Error! Incompatible layouts for FieldTally::add_count.\n"
+      " - x name    : " + x.name() + "\n"
+      " - count name: " + count.name() + "\n"
+      " - mask name : " + mask.name() + "\n");
+  if (not is_supported(x,get_data_type<Real>()) or
+      not is_supported(count,DataType::IntType) or
+      not is_supported(mask,DataType::IntType)) {
+    return false;
+  }
+  const auto& c_ap = count.get_header().get_alloc_properties();
+  const auto& m_ap = mask.get_header().get_alloc_properties();
+  if (layout.rank()>0 and c_ap.get_last_extent()!=m_ap.get_last_extent()) {
+    return false;
+  }
+
+  Entry e;
+  e.x     = x.get_internal_view_data<const Real>();
+  e.y     = nullptr;
+  e.count = count.get_internal_view_data<int>();
+  e.mask  = mask.get_internal_view_data<int>();
+  e.dim   = layout.rank()==0 ? 1 : layout.dims().back();
+  e.x_ld  = layout.rank()==0 ? 1 : x.get_header().get_alloc_properties().get_last_extent();
+  e.y_ld  = layout.rank()==0 ? 1 : c_ap.get_last_extent();
+  e.fill_aware = false;
+  add_entry(e,layout.size());
+  return true;
+}
+
+void FieldTally::close ()
+{
+  EKAT_REQUIRE_MSG (not m_closed,
+      "Error! FieldTally::close() was already called.\n");
+
+  const int n = m_entries.size();
+  m_entries_d = decltype(m_entries_d)("field_tally_entries",n);
+  m_offsets_d = decltype(m_offsets_d)("field_tally_offsets",n+1);
+  auto entries_h = Kokkos::create_mirror_view(m_entries_d);
+  auto offsets_h = Kokkos::create_mirror_view(m_offsets_d);
+  for (int i=0; i<n; ++i) {
+    entries_h(i) = m_entries[i];
+    offsets_h(i) = m_offsets[i];
+  }
+  offsets_h(n) = m_offsets[n];
+  Kokkos::deep_copy(m_entries_d,entries_h);
+  Kokkos::deep_copy(m_offsets_d,offsets_h);
+
+  m_closed = true;
+}
+
+void FieldTally::run () const
+{
+  EKAT_REQUIRE_MSG (m_closed,
+      "Error! Cannot run a FieldTally before calling close().\n");
+
+  const int size = m_offsets.back();
+  if (size==0) {
+    return;
+  }
+  switch (m_cm) {
+    case CombineMode::Update: run_tally<CombineMode::Update>(m_entries_d,m_offsets_d,size); break;
+    case CombineMode::Max:    run_tally<CombineMode::Max>   (m_entries_d,m_offsets_d,size); break;
+    case CombineMode::Min:    run_tally<CombineMode::Min>   (m_entries_d,m_offsets_d,size); break;
+    default:
+      EKAT_ERROR_MSG ("Error! Unexpected combine mode in FieldTally::run.\n");
+  }
+}
+
+bool FieldTally::is_supported (const Field& f, const DataType dt)
+{
+  const auto& ap = f.get_header().get_alloc_properties();
+  return f.is_allocated() and f.data_type()==dt and not ap.is_subfield();
+}
+
+void FieldTally::add_entry (const Entry& e, const int size)
+{
+  if (size==0) {
+    return;
+  }
+  m_entries.push_back(e);
+  m_offsets.push_back(m_offsets.back()+size);
+}
+
+} // namespace scream
@@ -0,0 +1,89 @@
+#ifndef SCREAM_FIELD_TALLY_HPP
+#define SCREAM_FIELD_TALLY_HPP
+
+#include "share/field/field.hpp"
+#include "share/util/eamxx_combine_ops.hpp"
+
+#include <vector>
+
+namespace scream
+{
+
+/*
+ * A class to accumulate several fields in a single kernel launch
+ *
+ * Output streams with non-instant averaging accumulate each field in a tally
+ * at every step, and (possibly) count the entries that are not fill_value.
+ * Doing this with the Field methods requires one (tiny) kernel per field, plus
+ * two per count. Instead, fields and counts can be added to this class, which,
+ * once closed, stores a device table describing all the accumulations, and
+ * performs them all in one kernel in run().
+ *
+ * For each field pair (x,y), run() does the same as y.update/max/min(x),
+ * depending on the combine mode (fill-aware, if x may be filled).
+ * For each count, run() does the same as
+ *   compute_mask<Comparison::NE>(x,fill_value,mask);
+ *   count.update(mask,1,1);
+ *
+ * Only fields of type Real that are not subfields can be added (padding is fine).
+ * The add methods return false if the input fields cannot be handled, in which
+ * case the caller must accumulate them separately.
+ *
+ * NOTE: the table stores the fields data pointers, so the fields must not be
+ *       reallocated after being added.
+ */
+
+class FieldTally
+{
+public:
+  using KT = KokkosTypes<DefaultDevice>;
+
+  // One accumulation. For fields, y=combine(y,x). For counts, mask=(x!=fill_value)
+  // and count+=mask. Arrays are seen as 2d, with the last dim possibly padded.
+  struct Entry {
+    const Real* x;
+    Real*       y;
+    int*        count;
+    int*        mask;
+    int         dim;      // Size of the last dimension
+    int         x_ld;     // Leading dimension of x
+    int         y_ld;     // Leading dimension of y (or count/mask)
+    bool        fill_aware;
+  };
+
+  explicit FieldTally (const CombineMode cm);
+
+  // Add field pair, to do y=combine(x,y)
+  bool add_field (const Field& x, const Field& y);
+
+  // Add count, to do count+=(x!=fill_value). The mask field is updated too.
+  bool add_count (const Field& x, const Field& count, const Field& mask);
+
+  bool empty () const { return m_entries.empty(); }
+  int size () const { return m_entries.size(); }
+
+  // Copy the table to device. No more entries can be added after this call
+  void close ();
+
+  // Perform all the accumulations
+  void run () const;
+
+protected:
+  static bool is_supported (const Field& f, const DataType dt);
+
+  void add_entry (const Entry& e, const int size);
+
+  CombineMode               m_cm;
+
+  std::vector<Entry>        m_entries;
+  std::vector<int>          m_offsets;
+
+  KT::view_1d<Entry>        m_entries_d;
+  KT::view_1d<int>          m_offsets_d;
+
+  bool                      m_closed = false;
+};
+
+} // namespace scream
+
+#endif // SCREAM_FIELD_TALLY_HPP
@@ -1,4 +1,5 @@
 #include "share/grid/remap/abstract_remapper.hpp"
+#include "share/util/eamxx_timing.hpp"
 
 namespace scream
 {
@@ -107,7 +108,14 @@ void AbstractRemapper::remap_fwd ()
       "Error! Forward remap is not allowed by this remapper.\n");
   EKAT_REQUIRE_MSG (not m_has_read_only_tgt_fields,
       "Error! Forward remap IS allowed by this remapper, but some of the tgt fields are read-only\n");
-  remap_fwd_impl ();
+  if (is_event_tracer_inited()) {
+    const auto trace_name = "EAMxx::remap_fwd::" + m_src_grid->name() + "->" + m_tgt_grid->name();
+    start_trace_event (trace_name);
+    remap_fwd_impl ();
+    stop_trace_event (trace_name);
+  } else {
+    remap_fwd_impl ();
+  }
 }
 
 void AbstractRemapper::remap_bwd ()
@@ -120,7 +128,14 @@ void AbstractRemapper::remap_bwd ()
       "Error! Backward remap is not allowed by this remapper.\n");
   EKAT_REQUIRE_MSG (not m_has_read_only_src_fields,
       "Error! Backward remap IS allowed by this remapper, but some of the src fields are read-only\n");
-  remap_bwd_impl ();
+  if (is_event_tracer_inited()) {
+    const auto trace_name = "EAMxx::remap_bwd::" + m_tgt_grid->name() + "->" + m_src_grid->name();
+    start_trace_event (trace_name);
+    remap_bwd_impl ();
+    stop_trace_event (trace_name);
+  } else {
+    remap_bwd_impl ();
+  }
 }
 
 void AbstractRemapper::
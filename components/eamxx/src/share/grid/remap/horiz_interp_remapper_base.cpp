@@ -42,6 +42,11 @@ HorizInterpRemapperBase (const grid_ptr_type& fine_grid,
   m_col_lids = data.col_lids;
   m_weights = data.weights;
 
+  m_format = data.format;
+  m_ell_width = data.ell_width;
+  m_ell_col_lids = data.ell_col_lids;
+  m_ell_weights = data.ell_weights;
+
   // The grids really only matter for the horiz part. We may have 2+ remappers with
   // fine grids that only differ in terms of number of levs. Such remappers cannot
   // store the same coarse grid. So we soft-clone the grid, and reset the number of levels
@@ -88,6 +93,25 @@ HorizInterpRemapperBase::
   }
 }
 
+void HorizInterpRemapperBase::
+set_sparse_format (const SparseFormat fmt)
+{
+  if (fmt==SparseFormat::ELL and m_ell_width<0) {
+    // The ELL data was not built, since it was not the preferred format.
+    auto& data = s_remapper_data.at(m_map_file);
+    if (data.ell_width<0) {
+      data.build_ell();
+    }
+    m_ell_width = data.ell_width;
+    m_ell_col_lids = data.ell_col_lids;
+    m_ell_weights = data.ell_weights;
+  }
+  EKAT_REQUIRE_MSG (fmt!=SparseFormat::ELL or m_ell_width>0 or m_ell_weights.extent(1)==0,
+      "[HorizInterpRemapperBase::set_sparse_format] Error! Cannot use ELL format with an empty matrix.\n"
+      " - map file: " + m_map_file + "\n");
+  m_format = fmt;
+}
+
 void HorizInterpRemapperBase::registration_ends_impl ()
 {
   using namespace ShortFieldTagsNames;
@@ -153,6 +177,11 @@ template<int PackSize>
 void HorizInterpRemapperBase::
 local_mat_vec (const Field& x, const Field& y) const
 {
+  if (m_format==SparseFormat::ELL) {
+    local_mat_vec_ell<PackSize>(x,y);
+    return;
+  }
+
   using RangePolicy = typename KT::RangePolicy;
   using MemberType  = typename KT::MemberType;
   using TPF         = ekat::TeamPolicyFactory<DefaultDevice::execution_space>;
@@ -272,6 +301,135 @@ local_mat_vec (const Field& x, const Field& y) const
   }
 }
 
+template<int PackSize>
+void HorizInterpRemapperBase::
+local_mat_vec_ell (const Field& x, const Field& y) const
+{
+  using MemberType  = typename KT::MemberType;
+  using TPF         = ekat::TeamPolicyFactory<DefaultDevice::execution_space>;
+  using Pack        = ekat::Pack<Real,PackSize>;
+  using PackInfo    = ekat::PackInfo<PackSize>;
+
+  const auto row_grid = m_type==InterpType::Refine ? m_fine_grid : m_ov_coarse_grid;
+  const int  nrows    = row_grid->get_num_local_dofs();
+
+  const auto& src_layout = x.get_header().get_identifier().get_layout();
+  const int   rank       = src_layout.rank();
+
+  // All rows have exactly width entries (some with zero weight), so no need for row offsets
+  const int width    = m_ell_width;
+  auto      col_lids = m_ell_col_lids;
+  auto      weights  = m_ell_weights;
+
+  switch (rank) {
+    // Note: in each case, handle 1st contribution to each row separately,
+    //       using = instead of +=. This allows to avoid doing an extra
+    //       loop to zero out y before the mat-vec.
+    case 1:
+    {
+      // There is no vertical dim to vectorize over, so vectorize over rows
+      // instead: each team handles a block of rows, and loops over the k-th
+      // entries of all rows in the block, which are contiguous in memory.
+      constexpr int block_size = 64;
+      const int nblocks = (nrows+block_size-1) / block_size;
+
+      auto x_view = x.get_strided_view<const Real*>();
+      auto y_view = y.get_strided_view<      Real*>();
+      auto policy = TPF::get_default_team_policy(nblocks,block_size);
+      Kokkos::parallel_for(policy,
+                           KOKKOS_LAMBDA(const MemberType& team) {
+        const int row_beg = team.league_rank()*block_size;
+        const int nr = Kokkos::min(block_size,nrows-row_beg);
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(team,nr),
+                            [&](const int i){
+          const int row = row_beg + i;
+          y_view(row) = weights(0,row)*x_view(col_lids(0,row));
+        });
+        for (int k=1; k<width; ++k) {
+          Kokkos::parallel_for(Kokkos::TeamVectorRange(team,nr),
+                              [&](const int i){
+            const int row = row_beg + i;
+            y_view(row) += weights(k,row)*x_view(col_lids(k,row));
+          });
+        }
+      });
+      break;
+    }
+    case 2:
+    {
+      auto x_view = x.get_view<const Pack**>();
+      auto y_view = y.get_view<      Pack**>();
+      const int dim1 = PackInfo::num_packs(src_layout.dim(1));
+      auto policy = TPF::get_default_team_policy(nrows,dim1);
+      Kokkos::parallel_for(policy,
+                           KOKKOS_LAMBDA(const MemberType& team) {
+        const auto row = team.league_rank();
+
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(team,dim1),
+                            [&](const int j){
+          y_view(row,j) = weights(0,row)*x_view(col_lids(0,row),j);
+          for (int k=1; k<width; ++k) {
+            y_view(row,j) += weights(k,row)*x_view(col_lids(k,row),j);
+          }
+        });
+      });
+      break;
+    }
+    case 3:
+    {
+      auto x_view = x.get_view<const Pack***>();
+      auto y_view = y.get_view<      Pack***>();
+      const int dim1 = src_layout.dim(1);
+      const int dim2 = PackInfo::num_packs(src_layout.dim(2));
+      auto policy = TPF::get_default_team_policy(nrows,dim1*dim2);
+      Kokkos::parallel_for(policy,
+                           KOKKOS_LAMBDA(const MemberType& team) {
+        const auto row = team.league_rank();
+
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(team,dim1*dim2),
+                            [&](const int idx){
+          const int j = idx / dim2;
+          const int l = idx % dim2;
+          y_view(row,j,l) = weights(0,row)*x_view(col_lids(0,row),j,l);
+          for (int k=1; k<width; ++k) {
+            y_view(row,j,l) += weights(k,row)*x_view(col_lids(k,row),j,l);
+          }
+        });
+      });
+      break;
+    }
+    case 4:
+    {
+      auto x_view = x.get_view<const Pack****>();
+      auto y_view = y.get_view<      Pack****>();
+      const int dim1 = src_layout.dim(1);
+      const int dim2 = src_layout.dim(2);
+      const int dim3 = PackInfo::num_packs(src_layout.dim(3));
+      auto policy = TPF::get_default_team_policy(nrows,dim1*dim2*dim3);
+      Kokkos::parallel_for(policy,
+                           KOKKOS_LAMBDA(const MemberType& team) {
+        const auto row = team.league_rank();
+
+        Kokkos::parallel_for(Kokkos::TeamVectorRange(team,dim1*dim2*dim3),
+                            [&](const int idx){
+          const int j = (idx / dim3) / dim2;
+          const int l = (idx / dim3) % dim2;
+          const int m =  idx % dim3;
+          y_view(row,j,l,m) = weights(0,row)*x_view(col_lids(0,row),j,l,m);
+          for (int k=1; k<width; ++k) {
+            y_view(row,j,l,m) += weights(k,row)*x_view(col_lids(k,row),j,l,m);
+          }
+        });
+      });
+      break;
+    }
+    default:
+    {
+      EKAT_ERROR_MSG("[HorizInterpRemapperBase::local_mat_vec_ell] Error! Fields of rank 5 or greater are not supported.\n");
+    }
+  }
+}
+
 void HorizInterpRemapperBase::clean_up ()
 {
   // Clear all fields
@@ -291,11 +449,17 @@ std::map<std::string,HorizRemapperData> HorizInterpRemapperBase::s_remapper_data
 template
 void HorizInterpRemapperBase::
 local_mat_vec<1>(const Field&, const Field&) const;
+template
+void HorizInterpRemapperBase::
+local_mat_vec_ell<1>(const Field&, const Field&) const;
 
 #if SCREAM_PACK_SIZE>1
 template
 void HorizInterpRemapperBase::
 local_mat_vec<SCREAM_PACK_SIZE>(const Field&, const Field&) const;
+template
+void HorizInterpRemapperBase::
+local_mat_vec_ell<SCREAM_PACK_SIZE>(const Field&, const Field&) const;
 #endif
 
 } // namespace scream
@@ -13,6 +13,10 @@ namespace scream
  * This base class simply implements one method, common to all interpolation
  * remappers, which reads a map file, and grabs the sparse matrix triplets
  * that are needed.
+ *
+ * The local sparse matrix is stored in CRS format, and, if the row lengths are
+ * nearly uniform, also in ELL format, which is then used for the mat-vec.
+ * The format can be changed at runtime via set_sparse_format (mostly for benchmarking).
  */
 
 class HorizInterpRemapperBase : public AbstractRemapper
@@ -24,6 +28,9 @@ public:
 
   ~HorizInterpRemapperBase ();
 
+  SparseFormat get_sparse_format () const { return m_format; }
+  void set_sparse_format (const SparseFormat fmt);
+
 protected:
 
   void registration_ends_impl () override;
@@ -32,6 +39,8 @@ protected:
 
   template<typename T>
   using view_1d = typename KT::template view_1d<T>;
+  template<typename T>
+  using view_2d = typename KT::template view_2d<T>;
 
   void create_ov_fields ();
 
@@ -46,6 +55,8 @@ public:
 #endif
   template<int N>
   void local_mat_vec (const Field& f_src, const Field& f_tgt) const;
+  template<int N>
+  void local_mat_vec_ell (const Field& f_src, const Field& f_tgt) const;
 
   // The fine and coarse grids. Depending on m_type, they could be
   // respectively m_src_grid and m_tgt_grid or viceversa
@@ -68,6 +79,13 @@ public:
   view_1d<int>    m_col_lids;
   view_1d<Real>   m_weights;
 
+  // ----- Sparse matrix ELL representation ---- //
+  int             m_ell_width;
+  view_2d<int>    m_ell_col_lids;
+  view_2d<Real>   m_ell_weights;
+
+  SparseFormat    m_format;
+
   // Keep track of this, since we need to tell the remap data repo
   // we are releasing the data for our map file.
   std::string     m_map_file;
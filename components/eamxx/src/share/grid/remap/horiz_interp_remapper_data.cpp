@@ -4,10 +4,36 @@
 #include "share/grid/grid_import_export.hpp"
 #include "share/io/eamxx_scorpio_interface.hpp"
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
 #include <numeric>
+#include <sstream>
 
 namespace scream {
 
+namespace {
+
+// FNV-1a hash. Unlike std::hash, it is guaranteed to be the same across runs
+std::uint64_t fnv1a (const void* data, const std::size_t n,
+                     std::uint64_t h = 14695981039346656037ULL)
+{
+  auto bytes = reinterpret_cast<const unsigned char*>(data);
+  for (std::size_t i=0; i<n; ++i) {
+    h ^= bytes[i];
+    h *= 1099511628211ULL;
+  }
+  return h;
+}
+
+// Header of cache files: bump the version if the format changes
+constexpr std::uint64_t cache_magic   = 0x4541'4d58'5848'5244; // "EAMXXHRD"
+constexpr std::uint64_t cache_version = 1;
+
+} // anonymous namespace
+
+std::string HorizRemapperData::s_cache_dir = "";
+
 // --------------- HorizRemapperData ---------------- //
 
 void HorizRemapperData::
@@ -20,14 +46,268 @@ build (const std::string& map_file,
   fine_grid = fine_grid_in;
   type = type_in;
 
-  // Gather sparse matrix triplets needed by this rank
-  auto my_triplets = get_my_triplets (map_file);
+  // If caching is on, try to load data generated by a previous run. Since building the
+  // data requires collective operations, we can use the cache only if ALL ranks can.
+  std::string cache_file;
+  bool use_cache = false;
+  CachedData cached;
+  if (not s_cache_dir.empty()) {
+    cache_file = get_cache_file_name(map_file);
+    int can_use = cache_file!="" and read_cache(cache_file,cached) ? 1 : 0;
+    int all_can_use;
+    comm.all_reduce(&can_use,&all_can_use,1,MPI_MIN);
+    use_cache = all_can_use==1;
+  }
+
+  if (use_cache) {
+    build_from_cache (cached);
+  } else {
+    // Gather sparse matrix triplets needed by this rank
+    auto my_triplets = get_my_triplets (map_file);
 
-  // Create coarse/ov_coarse grids
-  create_coarse_grids (my_triplets);
+    // Create coarse/ov_coarse grids
+    create_coarse_grids (my_triplets);
 
-  // Create crs matrix
-  create_crs_matrix_structures (my_triplets);
+    // Create crs matrix
+    create_crs_matrix_structures (my_triplets);
+
+    if (cache_file!="") {
+      write_cache (cache_file);
+    }
+  }
+
+  // If rows have (almost) the same length, use the ELL format instead
+  format = choose_format ();
+  if (format==SparseFormat::ELL) {
+    build_ell ();
+  }
+}
+
+std::string HorizRemapperData::
+get_cache_file_name (const std::string& map_file) const
+{
+  namespace fs = std::filesystem;
+
+  // Instead of hashing the (possibly large) map file, we use path, size, and modification time
+  std::error_code ec;
+  const auto path  = fs::absolute(map_file,ec).string();
+  const auto size  = fs::file_size(map_file,ec);
+  if (ec) {
+    return "";
+  }
+  const auto mtime = fs::last_write_time(map_file,ec).time_since_epoch().count();
+  if (ec) {
+    return "";
+  }
+  const int itype = static_cast<int>(type);
+  const int nranks = comm.size();
+
+  auto h = fnv1a(path.data(),path.size());
+  h = fnv1a(&size,sizeof(size),h);
+  h = fnv1a(&mtime,sizeof(mtime),h);
+  h = fnv1a(&itype,sizeof(itype),h);
+  h = fnv1a(&nranks,sizeof(nranks),h);
+
+  std::stringstream ss;
+  ss << s_cache_dir << "/" << fs::path(map_file).stem().string()
+     << "." << std::hex << h << std::dec
+     << ".np" << nranks << ".rank" << comm.rank() << ".bin";
+  return ss.str();
+}
+
+std::uint64_t HorizRemapperData::get_fine_grid_hash () const
+{
+  // The local mat-vec uses lids of the fine grid, so the order of gids matters too
+  auto gids_h = fine_grid->get_dofs_gids().get_view<const gid_type*,Host>();
+  const int ncols = gids_h.size();
+  auto h = fnv1a(&ncols,sizeof(ncols));
+  return fnv1a(gids_h.data(),ncols*sizeof(gid_type),h);
+}
+
+bool HorizRemapperData::
+read_cache (const std::string& cache_file, CachedData& data) const
+{
+  std::ifstream ifs(cache_file,std::ios::binary);
+  if (not ifs.good()) {
+    return false;
+  }
+
+  auto read = [&](auto* ptr, const std::size_t n) {
+    ifs.read(reinterpret_cast<char*>(ptr),n*sizeof(*ptr));
+    return ifs.good();
+  };
+  auto read_vec = [&](auto& v) {
+    std::int64_t n;
+    if (not read(&n,1) or n<0) {
+      return false;
+    }
+    v.resize(n);
+    return n==0 or read(v.data(),n);
+  };
+
+  // Check the header first
+  std::uint64_t magic, version, grid_hash;
+  int itype, real_size, gid_size;
+  if (not read(&magic,1) or magic!=cache_magic or
+      not read(&version,1) or version!=cache_version or
+      not read(&grid_hash,1) or grid_hash!=get_fine_grid_hash() or
+      not read(&itype,1) or itype!=static_cast<int>(type) or
+      not read(&real_size,1) or real_size!=sizeof(Real) or
+      not read(&gid_size,1) or gid_size!=sizeof(gid_type)) {
+    return false;
+  }
+
+  if (not read_vec(data.ov_coarse_gids) or
+      not read_vec(data.coarse_gids) or
+      not read_vec(data.row_offsets) or
+      not read_vec(data.col_lids) or
+      not read_vec(data.weights)) {
+    return false;
+  }
+
+  // Some sanity checks on the CRS structures
+  const int num_rows = type==InterpType::Refine ? fine_grid->get_num_local_dofs()
+                                                : data.ov_coarse_gids.size();
+  const int nnz = data.col_lids.size();
+  return static_cast<int>(data.row_offsets.size())==num_rows+1 and
+         data.row_offsets.back()==nnz and
+         data.weights.size()==data.col_lids.size();
+}
+
+void HorizRemapperData::
+write_cache (const std::string& cache_file) const
+{
+  namespace fs = std::filesystem;
+
+  // Failing to write the cache is not an error: we simply won't have it next time
+  std::error_code ec;
+  fs::create_directories(s_cache_dir,ec);
+
+  // Write to a tmp file and then rename, so that a crash can't leave a corrupted cache
+  const auto tmp_file = cache_file + ".tmp";
+  {
+    std::ofstream ofs(tmp_file,std::ios::binary);
+    if (not ofs.good()) {
+      return;
+    }
+
+    auto write = [&](const auto* ptr, const std::size_t n) {
+      ofs.write(reinterpret_cast<const char*>(ptr),n*sizeof(*ptr));
+    };
+    auto write_view = [&](const auto& v) {
+      auto v_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),v);
+      const std::int64_t n = v_h.size();
+      write(&n,1);
+      write(v_h.data(),n);
+    };
+
+    const std::uint64_t grid_hash = get_fine_grid_hash();
+    const int itype = static_cast<int>(type);
+    const int real_size = sizeof(Real);
+    const int gid_size = sizeof(gid_type);
+    write(&cache_magic,1);
+    write(&cache_version,1);
+    write(&grid_hash,1);
+    write(&itype,1);
+    write(&real_size,1);
+    write(&gid_size,1);
+
+    write_view(ov_coarse_grid->get_dofs_gids().get_view<const gid_type*,Host>());
+    write_view(coarse_grid->get_dofs_gids().get_view<const gid_type*,Host>());
+    write_view(row_offsets);
+    write_view(col_lids);
+    write_view(weights);
+
+    if (not ofs.good()) {
+      ofs.close();
+      fs::remove(tmp_file,ec);
+      return;
+    }
+  }
+  fs::rename(tmp_file,cache_file,ec);
+}
+
+void HorizRemapperData::
+build_from_cache (const CachedData& data)
+{
+  auto create_grid = [&](const std::string& name, const std::vector<gid_type>& gids) {
+    auto grid = std::make_shared<PointGrid>(name,gids.size(),0,comm);
+    auto gids_h = grid->get_dofs_gids().get_view<gid_type*,Host>();
+    std::copy(gids.begin(),gids.end(),gids_h.data());
+    grid->get_dofs_gids().sync_to_dev();
+    return grid;
+  };
+  ov_coarse_grid = create_grid("ov_coarse_grid",data.ov_coarse_gids);
+  coarse_grid    = create_grid("coarse_grid",data.coarse_gids);
+
+  auto to_dev = [](const auto& v) {
+    using T = typename std::decay_t<decltype(v)>::value_type;
+    view_1d<T> d("",v.size());
+    auto d_h = Kokkos::create_mirror_view(d);
+    std::copy(v.begin(),v.end(),d_h.data());
+    Kokkos::deep_copy(d,d_h);
+    return d;
+  };
+  row_offsets = to_dev(data.row_offsets);
+  col_lids    = to_dev(data.col_lids);
+  weights     = to_dev(data.weights);
+}
+
+void HorizRemapperData::build_ell ()
+{
+  auto row_offsets_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),row_offsets);
+  auto col_lids_h    = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),col_lids);
+  auto weights_h     = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),weights);
+
+  const int num_rows = row_offsets_h.size()-1;
+  ell_width = 0;
+  for (int row=0; row<num_rows; ++row) {
+    ell_width = std::max(ell_width,row_offsets_h(row+1)-row_offsets_h(row));
+  }
+
+  ell_col_lids = view_2d<int>("",ell_width,num_rows);
+  ell_weights  = view_2d<Real>("",ell_width,num_rows);
+  auto ell_col_lids_h = Kokkos::create_mirror_view(ell_col_lids);
+  auto ell_weights_h  = Kokkos::create_mirror_view(ell_weights);
+
+  // Padding entries have zero weight, and point to the first col of the row
+  // (or to col 0 for empty rows), so that kernels do not need to branch
+  for (int row=0; row<num_rows; ++row) {
+    const int beg = row_offsets_h(row);
+    const int len = row_offsets_h(row+1) - beg;
+    for (int k=0; k<ell_width; ++k) {
+      if (k<len) {
+        ell_col_lids_h(k,row) = col_lids_h(beg+k);
+        ell_weights_h(k,row)  = weights_h(beg+k);
+      } else {
+        ell_col_lids_h(k,row) = len>0 ? col_lids_h(beg) : 0;
+        ell_weights_h(k,row)  = 0;
+      }
+    }
+  }
+  Kokkos::deep_copy(ell_col_lids,ell_col_lids_h);
+  Kokkos::deep_copy(ell_weights,ell_weights_h);
+}
+
+SparseFormat HorizRemapperData::choose_format () const
+{
+  // ELL makes all rows equally long, which helps vectorization, but also
+  // adds (wasted) work on padding entries. We use it only if the padded
+  // matrix is not much larger than the actual one.
+  constexpr double max_ell_fill_ratio = 1.25;
+
+  auto row_offsets_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),row_offsets);
+  const int num_rows = row_offsets_h.size()-1;
+  const int nnz = num_rows>0 ? row_offsets_h(num_rows) : 0;
+  int max_len = 0;
+  for (int row=0; row<num_rows; ++row) {
+    max_len = std::max(max_len,row_offsets_h(row+1)-row_offsets_h(row));
+  }
+
+  if (nnz==0 or static_cast<double>(max_len)*num_rows > max_ell_fill_ratio*nnz) {
+    return SparseFormat::CRS;
+  }
+  return SparseFormat::ELL;
 }
 
 auto HorizRemapperData::
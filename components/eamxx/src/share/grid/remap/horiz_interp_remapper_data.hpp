@@ -6,6 +6,7 @@
 
 #include <ekat_comm.hpp>
 
+#include <cstdint>
 #include <memory>
 #include <map>
 #include <string>
@@ -17,13 +18,36 @@ enum class InterpType {
   Coarsen
 };
 
+// Storage format for the local sparse matrix
+//  - CRS: compressed row storage
+//  - ELL: each row is padded (with zero weights) to the max row length. Entries are stored
+//         as (k,row), so that the k-th entries of consecutive rows are contiguous in memory
+enum class SparseFormat {
+  CRS,
+  ELL
+};
+
+inline std::string e2str (const SparseFormat fmt) {
+  switch (fmt) {
+    case SparseFormat::CRS: return "CRS";
+    case SparseFormat::ELL: return "ELL";
+    default: return "INVALID";
+  }
+}
+
 // A small struct to hold horiz remap data, which can be shared across multiple horiz remappers
 // NOTE: the client will call the build method, which will read the map file, and create the
 //       CRS matrix data for online interpolation.
+// NOTE: if a cache directory is set, each rank stores its (already partitioned) data in a
+//       binary file in that directory. Later runs with the same map file, fine grid
+//       decomposition, and number of ranks load the data from there, skipping the map
+//       file read and the MPI exchange of triplets.
 struct HorizRemapperData {
   using KT = KokkosTypes<DefaultDevice>;
   template<typename T>
   using view_1d = typename KT::template view_1d<T>;
+  template<typename T>
+  using view_2d = typename KT::template view_2d<T>;
 
   // The last argument specifies the base index for gids in the map file
   // For ncremap-type files, all indices are 1-based
@@ -41,10 +65,49 @@ struct HorizRemapperData {
   view_1d<int>    col_lids;
   view_1d<Real>   weights;
 
+  // The ELL matrix data, with views of size (ell_width,num_rows).
+  // They are only built if format=ELL (or via build_ell). Until then, ell_width=-1.
+  int             ell_width = -1;
+  view_2d<int>    ell_col_lids;
+  view_2d<Real>   ell_weights;
+
+  // The format to use for the local mat-vec, based on the distribution of row lengths
+  SparseFormat    format = SparseFormat::CRS;
+
+  // Create the ELL matrix data from the CRS one
+  void build_ell ();
+
   int num_customers = 0;
+
+  // An empty string disables the cache
+  static void set_cache_dir (const std::string& dir) { s_cache_dir = dir; }
+  static const std::string& get_cache_dir () { return s_cache_dir; }
 private:
   using gid_type = AbstractGrid::gid_type;
 
+  static std::string s_cache_dir;
+
+  // The data stored in the cache file
+  struct CachedData {
+    std::vector<gid_type> ov_coarse_gids;
+    std::vector<gid_type> coarse_gids;
+    std::vector<int>      row_offsets;
+    std::vector<int>      col_lids;
+    std::vector<Real>     weights;
+  };
+
+  // Cache file for this rank. Returns an empty string if the map file can't be inspected
+  std::string get_cache_file_name (const std::string& map_file) const;
+  std::uint64_t get_fine_grid_hash () const;
+
+  // Returns true if the file exists and matches the current fine grid and interp type.
+  // NOTE: this method is NOT collective, so ranks can proceed even if some of them fail
+  bool read_cache (const std::string& cache_file, CachedData& data) const;
+  void write_cache (const std::string& cache_file) const;
+
+  // Set grids and CRS structures from the cached data
+  void build_from_cache (const CachedData& data);
+
   InterpType                          type;
   std::shared_ptr<const AbstractGrid> fine_grid;
   ekat::Comm                          comm;
@@ -68,6 +131,9 @@ private:
   // Not a const ref, since we'll sort the triplets according to
   // how row gids appear in the coarse grid
   void create_crs_matrix_structures (std::vector<Triplet>& triplets);
+
+  // Choose the format that is likely to give the fastest mat-vec
+  SparseFormat choose_format () const;
 };
 
 } // namespace scream
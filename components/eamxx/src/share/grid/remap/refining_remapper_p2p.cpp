@@ -8,6 +8,7 @@
 #include <ekat_team_policy_utils.hpp>
 #include <ekat_pack_utils.hpp>
 
+#include <map>
 #include <numeric>
 
 namespace scream
@@ -105,6 +106,49 @@ void RefiningRemapperP2P::setup_mpi_data_structures ()
   }
   auto total_col_size = m_fields_col_sizes_scan_sum.back();
 
+  // ----------- Group fields by layout class -------------- //
+
+  // Map the non-COL dims to the fields with those dims
+  std::map<std::vector<int>,std::vector<int>> layout_classes;
+  m_is_fused.resize(m_num_fields,0);
+  for (int i=0; i<m_num_fields; ++i) {
+    const auto& fh = m_src_fields[i].get_header();
+    const auto& fl = fh.get_identifier().get_layout();
+    if (m_needs_remap[i]==0 or not fl.has_tag(COL) or fh.get_alloc_properties().is_subfield())
+      continue;
+
+    layout_classes[fl.clone().strip_dim(COL).dims()].push_back(i);
+    m_is_fused[i] = 1;
+  }
+
+  auto col_stride = [&](const Field& f) {
+    const auto& fh = f.get_header();
+    const int ncols = fh.get_identifier().get_layout().dim(COL);
+    return ncols>0 ? fh.get_alloc_properties().get_num_scalars() / ncols : 0;
+  };
+  for (const auto& [dims,fields] : layout_classes) {
+    auto& group = m_fused_groups.emplace_back();
+    group.col_size = std::accumulate(dims.begin(),dims.end(),1,std::multiplies<int>());
+    group.last_dim = dims.empty() ? 1 : dims.back();
+    group.fields = view_1d<FusedFieldInfo>("fused_fields",fields.size());
+
+    auto fields_h = Kokkos::create_mirror_view(group.fields);
+    for (size_t j=0; j<fields.size(); ++j) {
+      const int i = fields[j];
+      const auto& src = m_src_fields[i];
+      const auto& ov  = m_ov_fields[i];
+      auto& info = fields_h(j);
+      info.src = src.get_internal_view_data<const Real>();
+      info.ov  = ov.get_internal_view_data<Real>();
+      info.src_col_stride  = col_stride(src);
+      info.src_last_extent = dims.empty() ? 1 : src.get_header().get_alloc_properties().get_last_extent();
+      info.ov_col_stride   = col_stride(ov);
+      info.ov_last_extent  = dims.empty() ? 1 : ov.get_header().get_alloc_properties().get_last_extent();
+      info.col_sizes_scan_sum = m_fields_col_sizes_scan_sum[i];
+    }
+    Kokkos::deep_copy(group.fields,fields_h);
+  }
+
   // ----------- Compute RECV metadata -------------- //
 
   // Figure out where ov_src cols are received from
@@ -182,9 +226,51 @@ void RefiningRemapperP2P::pack_and_send ()
   auto send_buf = m_send_buffer;
   const int num_exports = export_pids.size();
   const int total_col_size = m_fields_col_sizes_scan_sum.back();
+
+  // Pack all fields of a layout class with a single kernel. Each league
+  // index corresponds to a (field,export) pair.
+  for (const auto& group : m_fused_groups) {
+    const auto fields = group.fields;
+    const int nfields  = fields.size();
+    const int col_size = group.col_size;
+    const int last_dim = group.last_dim;
+    auto pack_col = KOKKOS_LAMBDA (const int ifield, const int iexp, const int idx) {
+      const auto& info = fields(ifield);
+      const int pid  = export_pids(iexp);
+      const int icol = export_lids(iexp);
+      auto pid_offset = pids_send_offsets(pid);
+      auto pos_within_pid = iexp - pid_offset;
+      auto offset = pid_offset*total_col_size
+                  + ncols_send(pid)*info.col_sizes_scan_sum
+                  + pos_within_pid*col_size;
+      send_buf(offset+idx) = info.src[icol*info.src_col_stride
+                                      + (idx/last_dim)*info.src_last_extent
+                                      + idx%last_dim];
+    };
+    if (col_size==1) {
+      auto pack = KOKKOS_LAMBDA(const int i) {
+        pack_col(i / num_exports, i % num_exports, 0);
+      };
+      Kokkos::parallel_for(RangePolicy(0,nfields*num_exports),pack);
+    } else {
+      auto policy = TPF::get_default_team_policy(nfields*num_exports,col_size);
+      auto pack = KOKKOS_LAMBDA(const TeamMember& team) {
+        const int ifield = team.league_rank() / num_exports;
+        const int iexp   = team.league_rank() % num_exports;
+        auto tvr = Kokkos::TeamVectorRange(team,col_size);
+        Kokkos::parallel_for(tvr,[&](const int idx) {
+          pack_col(ifield,iexp,idx);
+        });
+      };
+      Kokkos::parallel_for(policy,pack);
+    }
+  }
+
+  // Pack the remaining fields one at a time
   for (int ifield=0; ifield<m_num_fields; ++ifield) {
-    if (m_needs_remap[ifield]==0)
-      // No need to process this field. We'll deep copy src->tgt later
+    if (m_needs_remap[ifield]==0 or m_is_fused[ifield]==1)
+      // No need to process this field. We'll deep copy src->tgt later,
+      // or it was already packed above
       continue;
 
     const auto& f = m_src_fields[ifield];
@@ -330,9 +416,51 @@ void RefiningRemapperP2P::recv_and_unpack ()
   auto recv_buf = m_recv_buffer;
   const int num_imports = import_pids.size();
   const int total_col_size = m_fields_col_sizes_scan_sum.back();
+
+  // Unpack all fields of a layout class with a single kernel. Each league
+  // index corresponds to a (field,import) pair.
+  for (const auto& group : m_fused_groups) {
+    const auto fields = group.fields;
+    const int nfields  = fields.size();
+    const int col_size = group.col_size;
+    const int last_dim = group.last_dim;
+    auto unpack_col = KOKKOS_LAMBDA (const int ifield, const int iimp, const int idx) {
+      const auto& info = fields(ifield);
+      const int pid  = import_pids(iimp);
+      const int icol = import_lids(iimp);
+      const auto pid_offset = pids_recv_offsets(pid);
+      const auto pos_within_pid = iimp - pid_offset;
+      auto offset = pid_offset*total_col_size
+                  + ncols_recv(pid)*info.col_sizes_scan_sum
+                  + pos_within_pid*col_size;
+      info.ov[icol*info.ov_col_stride
+              + (idx/last_dim)*info.ov_last_extent
+              + idx%last_dim] = recv_buf(offset+idx);
+    };
+    if (col_size==1) {
+      auto unpack = KOKKOS_LAMBDA(const int i) {
+        unpack_col(i / num_imports, i % num_imports, 0);
+      };
+      Kokkos::parallel_for(RangePolicy(0,nfields*num_imports),unpack);
+    } else {
+      auto policy = TPF::get_default_team_policy(nfields*num_imports,col_size);
+      auto unpack = KOKKOS_LAMBDA(const TeamMember& team) {
+        const int ifield = team.league_rank() / num_imports;
+        const int iimp   = team.league_rank() % num_imports;
+        auto tvr = Kokkos::TeamVectorRange(team,col_size);
+        Kokkos::parallel_for(tvr,[&](const int idx) {
+          unpack_col(ifield,iimp,idx);
+        });
+      };
+      Kokkos::parallel_for(policy,unpack);
+    }
+  }
+
+  // Unpack the remaining fields one at a time
   for (int ifield=0; ifield<m_num_fields; ++ifield) {
-    if (m_needs_remap[ifield]==0)
-      // No need to process this field. We'll deep copy src->tgt later
+    if (m_needs_remap[ifield]==0 or m_is_fused[ifield]==1)
+      // No need to process this field. We'll deep copy src->tgt later,
+      // or it was already unpacked above
       continue;
 
           auto& f  = m_ov_fields[ifield];
@@ -453,6 +581,8 @@ void RefiningRemapperP2P::clean_up ()
   m_send_req.clear();
   m_recv_req.clear();
   m_imp_exp = nullptr;
+  m_fused_groups.clear();
+  m_is_fused.clear();
 
   HorizInterpRemapperBase::clean_up();
 }
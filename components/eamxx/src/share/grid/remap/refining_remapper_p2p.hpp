@@ -44,6 +44,11 @@ class GridImportExport;
  * however, use the classic send/recv paradigm, where data is packed in
  * a buffer, sent to the recv rank, and then unpacked and accumulated
  * into the result.
+ *
+ * Fields with the same layout class (i.e., same dims besides COL) are packed
+ * and unpacked together, with a single kernel for each layout class. Only
+ * subfields (whose memory is not described by a simple column stride) are
+ * packed/unpacked one field at a time.
  */
 
 class RefiningRemapperP2P : public HorizInterpRemapperBase
@@ -88,6 +93,31 @@ protected:
   // Exclusive scan sum of the col size of each field
   std::vector<int> m_fields_col_sizes_scan_sum;
 
+  // Data needed to pack/unpack a field inside a fused kernel. The entry (icol,idx)
+  // of the field, with idx the flattened index within the column, is found at
+  //   data[icol*col_stride + (idx/last_dim)*last_extent + idx%last_dim]
+  // where last_dim is the extent of the last dim, and last_extent the allocated one.
+  struct FusedFieldInfo {
+    const Real* src;
+    Real*       ov;
+    int         src_col_stride;
+    int         src_last_extent;
+    int         ov_col_stride;
+    int         ov_last_extent;
+    int         col_sizes_scan_sum;
+  };
+
+  // All fields in a group have the same layout class
+  struct FusedGroup {
+    int col_size;
+    int last_dim;
+    view_1d<FusedFieldInfo> fields;
+  };
+  std::vector<FusedGroup>   m_fused_groups;
+
+  // Whether each field is handled by one of the fused groups
+  std::vector<int>          m_is_fused;
+
   // ImportData/export info
   std::shared_ptr<GridImportExport>  m_imp_exp;
 
@@ -5,6 +5,8 @@
 
 #include <ekat_pack_utils.hpp>
 
+#include <algorithm>
+#include <map>
 #include <numeric>
 
 namespace scream
@@ -26,37 +28,32 @@ RefiningRemapperRMA::
 
 void RefiningRemapperRMA::remap_fwd_impl ()
 {
-  // Start RMA epoch on each field
-  for (int i=0; i<m_num_fields; ++i) {
-    check_mpi_call(MPI_Win_post(m_mpi_group,0,m_mpi_win[i]),
-                   "MPI_Win_post for field: " + m_src_fields[i].name());
-    check_mpi_call(MPI_Win_start(m_mpi_group,0,m_mpi_win[i]),
-                   "MPI_Win_start for field: " + m_src_fields[i].name());
-  }
+  // Start RMA epoch
+  check_mpi_call(MPI_Win_post(m_mpi_group,0,m_mpi_win),"MPI_Win_post");
+  check_mpi_call(MPI_Win_start(m_mpi_group,0,m_mpi_win),"MPI_Win_start");
 
-  // Loop over fields, and grab data
+  // Loop over fields, and grab data. Since the window is dynamic,
+  // the target displacement is the absolute address on the remote rank
   constexpr HostOrDevice MpiDev = MpiOnDev ? Device : Host;
   const auto& dt = ekat::get_mpi_type<Real>();
   for (int i=0; i<m_num_fields; ++i) {
     const int col_size = m_col_size[i];
     const int col_stride = m_col_stride[i];
     const int col_offset = m_col_offset[i];
-    const auto& win = m_mpi_win[i];
     auto ov_data = m_ov_fields[i].get_internal_view_data<Real,MpiDev>();
     for (int icol=0; icol<m_ov_coarse_grid->get_num_local_dofs(); ++icol) {
       const int pid = m_remote_pids[icol];
       const int lid = m_remote_lids[icol];
+      const auto disp = MPI_Aint_add(m_remote_addr[pid*m_num_fields+i],
+                                     (lid*col_stride+col_offset)*sizeof(Real));
       check_mpi_call(MPI_Get(ov_data+icol*col_size,col_size,dt,pid,
-                             lid*col_stride+col_offset,col_size,dt,win),
+                             disp,col_size,dt,m_mpi_win),
                      "MPI_Get for field: " + m_ov_fields[i].name());
     }
   }
 
-  // Close access RMA epoch on each field (exposure is still open)
-  for (int i=0; i<m_num_fields; ++i) {
-    check_mpi_call(MPI_Win_complete(m_mpi_win[i]),
-                   "MPI_Win_complete for field: " + m_ov_fields[i].name());
-  }
+  // Close access RMA epoch (exposure is still open)
+  check_mpi_call(MPI_Win_complete(m_mpi_win),"MPI_Win_complete");
 
   // Helpef function, to establish if a field can be handled with packs
   auto can_pack_field = [](const Field& f) {
@@ -88,11 +85,8 @@ void RefiningRemapperRMA::remap_fwd_impl ()
     }
   }
 
-  // Close exposure RMA epoch on each field
-  for (int i=0; i<m_num_fields; ++i) {
-    check_mpi_call(MPI_Win_wait(m_mpi_win[i]),
-                   "MPI_Win_post for field: " + m_src_fields[i].name());
-  }
+  // Close exposure RMA epoch
+  check_mpi_call(MPI_Win_wait(m_mpi_win),"MPI_Win_wait");
 }
 
 void RefiningRemapperRMA::setup_mpi_data_structures ()
@@ -110,8 +104,17 @@ void RefiningRemapperRMA::setup_mpi_data_structures ()
   // TODO: scope out possibility of using sub-groups for start/post calls
   //       (but I'm afraid you can't, b/c start/post may require same groups)
 
+  // Create the window. Fields are attached to it below
+  check_mpi_call(MPI_Win_create_dynamic(MPI_INFO_NULL,mpi_comm,&m_mpi_win),
+                 "[RefiningRemapperRMA::setup_mpi_data_structures] MPI_Win_create_dynamic");
+#ifndef EKAT_MPI_ERRORS_ARE_FATAL
+  check_mpi_call(MPI_Win_set_errhandler(m_mpi_win,MPI_ERRORS_RETURN),
+                 "[RefiningRemapperRMA::setup_mpi_data_structure] setting MPI_ERRORS_RETURN handler on MPI_Win");
+#endif
+
   // Create per-field structures
-  m_mpi_win.resize(m_num_fields);
+  std::vector<MPI_Aint> my_addr(m_num_fields,0);
+  std::map<void*,size_t> regions;
   m_col_size.resize(m_num_fields);
   m_col_stride.resize(m_num_fields);
   m_col_offset.resize(m_num_fields,0);
@@ -137,14 +140,27 @@ void RefiningRemapperRMA::setup_mpi_data_structures ()
     }
 
     auto data = f.get_internal_view_data<Real,Host>();
-    check_mpi_call(MPI_Win_create(data,win_size,sizeof(Real),
-                                  MPI_INFO_NULL,mpi_comm,&m_mpi_win[i]),
-                   "[RefiningRemapperRMA::setup_mpi_data_structures] MPI_Win_create");
-#ifndef EKAT_MPI_ERRORS_ARE_FATAL
-    check_mpi_call(MPI_Win_set_errhandler(m_mpi_win[i],MPI_ERRORS_RETURN),
-                   "[RefiningRemapperRMA::setup_mpi_data_structure] setting MPI_ERRORS_RETURN handler on MPI_Win");
-#endif
+    auto& size = regions[data];
+    size = std::max<size_t>(size,win_size);
+    check_mpi_call(MPI_Get_address(data,&my_addr[i]),
+                   "[RefiningRemapperRMA::setup_mpi_data_structures] MPI_Get_address");
+  }
+
+  // Attach memory regions to the window. Subfields of the same parent share the
+  // same data pointer, and attaching overlapping regions is erroneous in MPI.
+  for (const auto& [data,size] : regions) {
+    if (size>0) {
+      check_mpi_call(MPI_Win_attach(m_mpi_win,data,size),
+                     "[RefiningRemapperRMA::setup_mpi_data_structures] MPI_Win_attach");
+      m_attached_ptrs.push_back(data);
+    }
   }
+
+  // Gather the address of all fields on all ranks
+  m_remote_addr.resize(m_num_fields*m_comm.size());
+  check_mpi_call(MPI_Allgather(my_addr.data(),m_num_fields,MPI_AINT,
+                               m_remote_addr.data(),m_num_fields,MPI_AINT,mpi_comm),
+                 "[RefiningRemapperRMA::setup_mpi_data_structures] MPI_Allgather");
 }
 
 void RefiningRemapperRMA::clean_up ()
@@ -154,10 +170,14 @@ void RefiningRemapperRMA::clean_up ()
     check_mpi_call(MPI_Group_free(&m_mpi_group),"MPI_Group_free");
     m_mpi_group = MPI_GROUP_NULL;
   }
-  for (auto& win : m_mpi_win) {
-    check_mpi_call(MPI_Win_free(&win),"MPI_Win_free");
+  if (m_mpi_win!=MPI_WIN_NULL) {
+    for (auto ptr : m_attached_ptrs) {
+      check_mpi_call(MPI_Win_detach(m_mpi_win,ptr),"MPI_Win_detach");
+    }
+    check_mpi_call(MPI_Win_free(&m_mpi_win),"MPI_Win_free");
   }
-  m_mpi_win.clear();
+  m_attached_ptrs.clear();
+  m_remote_addr.clear();
   m_remote_pids.clear();
   m_remote_lids.clear();
   m_col_size.clear();
@@ -42,6 +42,9 @@ namespace scream
  * standard since 2.0, but its support is still sub-optimal, due to
  * limited effort in optimizing it by the vendors. Furthermore, as of
  * Oct 2023, RMA operations are not supported by GPU-aware implementations.
+ *
+ * All fields are attached to a single dynamic MPI window, so that each
+ * remap requires only one RMA epoch, regardless of the number of fields.
  */
 
 class RefiningRemapperRMA : public HorizInterpRemapperBase
@@ -98,8 +101,15 @@ protected:
   std::vector<int>          m_col_stride;
   std::vector<int>          m_col_offset;
 
-  // One MPI window object for each field
-  std::vector<MPI_Win>      m_mpi_win;
+  // A single dynamic MPI window, with all fields attached
+  MPI_Win                   m_mpi_win = MPI_WIN_NULL;
+
+  // The local pointers attached to m_mpi_win
+  std::vector<void*>        m_attached_ptrs;
+
+  // The address of each field's data on each rank, stored as
+  // m_remote_addr[pid*m_num_fields+ifield]
+  std::vector<MPI_Aint>     m_remote_addr;
 };
 
 } // namespace scream
@@ -37,6 +37,9 @@ enum class OutputAvgType {
   Max,
   Min,
   Average,
+  Variance,   // Welford mean and variance (the mean is output as a separate var)
+  Histogram,  // Sample counts in fixed bins, along an extra "bin" dimension
+  Exceedance, // Number of samples above a threshold
   Invalid
 };
 
@@ -47,6 +50,9 @@ inline std::string e2str(const OutputAvgType avg) {
     case OAT::Max:      return "MAX";
     case OAT::Min:      return "MIN";
     case OAT::Average:  return "AVERAGE";
+    case OAT::Variance:   return "VARIANCE";
+    case OAT::Histogram:  return "HISTOGRAM";
+    case OAT::Exceedance: return "EXCEEDANCE";
     default:            return "INVALID";
   }
 }
@@ -54,7 +60,8 @@ inline std::string e2str(const OutputAvgType avg) {
 inline OutputAvgType str2avg (const std::string& s) {
   auto s_ci = ekat::upper_case(s);
   using OAT = OutputAvgType;
-  for (auto e : {OAT::Instant, OAT::Max, OAT::Min, OAT::Average}) {
+  for (auto e : {OAT::Instant, OAT::Max, OAT::Min, OAT::Average,
+                 OAT::Variance, OAT::Histogram, OAT::Exceedance}) {
     if (s_ci==e2str(e)) {
       return e;
     }
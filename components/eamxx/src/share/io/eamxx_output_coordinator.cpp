@@ -0,0 +1,139 @@
+#include "share/io/eamxx_output_coordinator.hpp"
+#include "share/io/eamxx_scorpio_interface.hpp"
+
+#include <ekat_assert.hpp>
+
+namespace scream
+{
+
+auto OutputCoordinator::
+get_diagnostic (const std::string& name, const std::string& grid_name) const
+ -> diag_ptr_type
+{
+  auto it = m_diags.find(diag_key(name,grid_name));
+  return it==m_diags.end() ? nullptr : it->second;
+}
+
+void OutputCoordinator::
+add_diagnostic (const std::string& name, const std::string& grid_name,
+                const diag_ptr_type& diag)
+{
+  EKAT_REQUIRE_MSG (diag!=nullptr,
+      "[OutputCoordinator] Error! Invalid diagnostic pointer.\n"
+      " - diag name: " + name + "\n");
+  auto [it,inserted] = m_diags.emplace(diag_key(name,grid_name),diag);
+  EKAT_REQUIRE_MSG (inserted or it->second==diag,
+      "[OutputCoordinator] Error! A different diagnostic was already stored with this name.\n"
+      " - diag name: " + name + "\n"
+      " - grid name: " + grid_name + "\n");
+}
+
+bool OutputCoordinator::
+has_remapped_field (const std::string& remap_key, const std::string& fname) const
+{
+  auto it = m_remapped.find(remap_key);
+  return it!=m_remapped.end() and it->second.count(fname)==1;
+}
+
+const Field& OutputCoordinator::
+get_remapped_field (const std::string& remap_key, const std::string& fname)
+{
+  EKAT_REQUIRE_MSG (has_remapped_field(remap_key,fname),
+      "[OutputCoordinator] Error! Remapped field not found.\n"
+      " - remap key : " + remap_key + "\n"
+      " - field name: " + fname + "\n");
+  const auto& entry = m_remapped.at(remap_key).at(fname);
+  m_shared_remappers.insert(entry.remapper.get());
+  return entry.tgt;
+}
+
+auto OutputCoordinator::
+get_remapper (const std::string& remap_key, const std::string& fname) const
+ -> const remapper_ptr_type&
+{
+  EKAT_REQUIRE_MSG (has_remapped_field(remap_key,fname),
+      "[OutputCoordinator] Error! Remapped field not found.\n"
+      " - remap key : " + remap_key + "\n"
+      " - field name: " + fname + "\n");
+  return m_remapped.at(remap_key).at(fname).remapper;
+}
+
+void OutputCoordinator::
+add_remapped_field (const std::string& remap_key, const std::string& fname,
+                    const Field& tgt, const remapper_ptr_type& remapper)
+{
+  EKAT_REQUIRE_MSG (not has_remapped_field(remap_key,fname),
+      "[OutputCoordinator] Error! Remapped field was already added.\n"
+      " - remap key : " + remap_key + "\n"
+      " - field name: " + fname + "\n");
+  m_remapped[remap_key].emplace(fname,RemapEntry{tgt,remapper});
+}
+
+bool OutputCoordinator::
+is_shared (const AbstractRemapper& remapper) const
+{
+  return m_shared_remappers.count(&remapper)==1;
+}
+
+bool OutputCoordinator::
+updated_in_step (const void* obj) const
+{
+  return m_updated.count(obj)==1;
+}
+
+void OutputCoordinator::
+mark_updated_in_step (const void* obj)
+{
+  m_updated.insert(obj);
+}
+
+void OutputCoordinator::
+request_flush (const std::string& filename, const bool async)
+{
+  m_pending_flushes.emplace_back(filename,async);
+  if (not m_in_step) {
+    flush_files();
+  }
+}
+
+void OutputCoordinator::
+begin_step (const util::TimeStamp& ts)
+{
+  if (m_in_step and ts==m_curr_ts) {
+    // Another output manager already started this step
+    return;
+  }
+
+  // In case end_step was not called for the previous step
+  flush_files();
+
+  m_curr_ts = ts;
+  m_updated.clear();
+  m_in_step = true;
+}
+
+void OutputCoordinator::
+end_step ()
+{
+  flush_files();
+  m_in_step = false;
+}
+
+void OutputCoordinator::
+flush_files ()
+{
+  // NOTE: the order of the flushes is the same on all ranks, since
+  //       all ranks run the output managers in the same order.
+  for (const auto& [filename,async] : m_pending_flushes) {
+    if (async) {
+      scorpio::enqueue_async_task([filename=filename]() {
+        scorpio::flush_file(filename);
+      });
+    } else {
+      scorpio::flush_file(filename);
+    }
+  }
+  m_pending_flushes.clear();
+}
+
+} // namespace scream
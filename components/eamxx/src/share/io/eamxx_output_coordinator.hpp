@@ -0,0 +1,100 @@
+#ifndef SCREAM_OUTPUT_COORDINATOR_HPP
+#define SCREAM_OUTPUT_COORDINATOR_HPP
+
+#include "share/atm_process/atmosphere_diagnostic.hpp"
+#include "share/grid/remap/abstract_remapper.hpp"
+#include "share/field/field.hpp"
+#include "share/util/eamxx_time_stamp.hpp"
+
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace scream
+{
+
+/*
+ * A class to share output work across the output streams of a simulation.
+ *
+ * Several output streams (possibly belonging to different OutputManager objects)
+ * often request the same diagnostics, and/or the same fields remapped with the
+ * same remap. If all these streams are given the same OutputCoordinator,
+ *  - a diagnostic is created once, and computed at most once per step;
+ *  - a remapped field is registered only in the remapper of the first stream
+ *    requesting it (with a given remap), and other streams simply reuse the
+ *    output of that remapper;
+ *  - file flushes requested during a step are deferred to the end of the step,
+ *    so that all the writes of the step are done before PIO syncs the files.
+ *
+ * The driver must call begin_step at the beginning of the output phase of each step
+ * (the OutputManager does it in its run method), and end_step once all output
+ * managers have run.
+ */
+
+class OutputCoordinator
+{
+public:
+  using diag_ptr_type     = std::shared_ptr<AtmosphereDiagnostic>;
+  using remapper_ptr_type = std::shared_ptr<AbstractRemapper>;
+
+  OutputCoordinator () = default;
+
+  // Retrieve/store a diagnostic. If not found, get_diagnostic returns nullptr.
+  diag_ptr_type get_diagnostic (const std::string& name, const std::string& grid_name) const;
+  void add_diagnostic (const std::string& name, const std::string& grid_name,
+                       const diag_ptr_type& diag);
+
+  // Retrieve/store the target field of a remap. The remap_key must uniquely identify
+  // the remap (e.g., src grid name and map file name), while fname is the name
+  // of the source field. A stream getting a remapped field via get_remapped_field
+  // must ensure the returned remapper is up to date before using the field.
+  bool has_remapped_field (const std::string& remap_key, const std::string& fname) const;
+  const Field& get_remapped_field (const std::string& remap_key, const std::string& fname);
+  const remapper_ptr_type& get_remapper (const std::string& remap_key, const std::string& fname) const;
+  void add_remapped_field (const std::string& remap_key, const std::string& fname,
+                           const Field& tgt, const remapper_ptr_type& remapper);
+
+  // Whether the output of this remapper is used by more than one stream
+  bool is_shared (const AbstractRemapper& remapper) const;
+
+  // Track which objs (e.g., diagnostics, remappers) were already updated during the current step.
+  bool updated_in_step (const void* obj) const;
+  void mark_updated_in_step (const void* obj);
+
+  // Flush the file at the end of the step (or immediately, if no step is ongoing).
+  // If async=true, the flush is enqueued in the scorpio async worker
+  void request_flush (const std::string& filename, const bool async);
+
+  void begin_step (const util::TimeStamp& ts);
+  void end_step ();
+
+protected:
+
+  static std::string diag_key (const std::string& name, const std::string& grid_name) {
+    return name + "@" + grid_name;
+  }
+
+  void flush_files ();
+
+  struct RemapEntry {
+    Field             tgt;
+    remapper_ptr_type remapper;
+  };
+
+  std::map<std::string,diag_ptr_type>                       m_diags;
+  std::map<std::string,std::map<std::string,RemapEntry>>    m_remapped;
+  std::set<const AbstractRemapper*>                         m_shared_remappers;
+
+  util::TimeStamp                                           m_curr_ts;
+  std::set<const void*>                                     m_updated;
+
+  // Files to flush at the end of the step (and whether to flush asynchronously)
+  std::vector<std::pair<std::string,bool>>                  m_pending_flushes;
+  bool                                                      m_in_step = false;
+};
+
+} // namespace scream
+
+#endif // SCREAM_OUTPUT_COORDINATOR_HPP
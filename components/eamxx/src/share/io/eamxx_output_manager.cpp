@@ -9,8 +9,11 @@
 #include <ekat_comm.hpp>
 #include <ekat_string_utils.hpp>
 
+#include <any>
 #include <fstream>
+#include <map>
 #include <memory>
+#include <set>
 #include <chrono>
 #include <ctime>
 
@@ -82,7 +85,7 @@ setup (const std::shared_ptr<fm_type>& field_mgr,
     EKAT_REQUIRE_MSG(grid_names.size()==1,
       "Error! Output requested on multiple grids but no grid information exists in output params.\n");
 
-    auto output = std::make_shared<output_type>(m_io_comm,m_params,field_mgr,*grid_names.begin());
+    auto output = std::make_shared<output_type>(m_io_comm,m_params,field_mgr,*grid_names.begin(),m_coordinator);
     output->set_logger(m_atm_logger);
     m_output_streams.push_back(output);
   } else {
@@ -116,12 +119,28 @@ setup (const std::shared_ptr<fm_type>& field_mgr,
       // as this is what the FieldManager expects.
       const auto& gname = field_mgr->get_grids_manager()->get_grid(*it)->name();
 
-      auto output = std::make_shared<output_type>(m_io_comm,m_params,field_mgr,gname);
+      auto output = std::make_shared<output_type>(m_io_comm,m_params,field_mgr,gname,m_coordinator);
       output->set_logger(m_atm_logger);
       m_output_streams.push_back(output);
     }
   }
 
+  // Per-var settings are shared by the streams of all grids, so check them here
+  if (m_params.isSublist("significant_digits_per_field")) {
+    std::set<std::string> vars;
+    for (const auto& it : m_output_streams) {
+      const auto& names = it->get_var_names();
+      vars.insert(names.begin(),names.end());
+    }
+    const auto& digits_pl = m_params.sublist("significant_digits_per_field");
+    for (auto it=digits_pl.params_names_cbegin(); it!=digits_pl.params_names_cend(); ++it) {
+      EKAT_REQUIRE_MSG (vars.count(*it)==1,
+          "Error! Found significant digits for a var that is not in the output stream.\n"
+          " - yaml file: " + m_params.name() + "\n"
+          " - var name : " + *it + "\n");
+    }
+  }
+
   // For normal output, setup the geometry data streams, which we used to write the
   // geo data in the output file when we create it.
   if (m_save_grid_data) {
@@ -311,6 +330,13 @@ set_logger(const std::shared_ptr<ekat::logger::LoggerBase>& atm_logger) {
   m_atm_logger = atm_logger;
 }
 
+void OutputManager::
+set_output_coordinator (const std::shared_ptr<OutputCoordinator>& coordinator) {
+  EKAT_REQUIRE_MSG (m_output_streams.empty(),
+      "Error! The output coordinator must be set before calling setup.\n");
+  m_coordinator = coordinator;
+}
+
 void OutputManager::
 add_global (const std::string& name, const std::shared_ptr<std::any>& global) {
   EKAT_REQUIRE_MSG (m_globals.find(name)==m_globals.end(),
@@ -370,6 +396,11 @@ void OutputManager::run(const util::TimeStamp& timestamp)
     return;
   }
 
+  if (m_coordinator) {
+    // No-op if another output manager already started this step
+    m_coordinator->begin_step(timestamp);
+  }
+
   // Ensure we did not go past the scheduled write time without hitting it
   EKAT_REQUIRE_MSG (
       (m_output_control.frequency_units=="nsteps"
@@ -501,50 +532,34 @@ void OutputManager::run(const util::TimeStamp& timestamp)
       control.compute_next_write_ts();
       control.nsamples_since_last_write = 0;
 
+      // Collect all the attributes to write. We store them (by value) in a map,
+      // so that the actual scorpio calls can be executed asynchronously
+      std::map<std::string,std::any> atts;
       if (m_is_model_restart_output) {
         // Only write nsteps on model restart
-        set_attribute(filespecs.filename,"GLOBAL","nsteps",timestamp.get_num_steps());
+        atts["nsteps"] = timestamp.get_num_steps();
       } else {
         if (filespecs.ftype==FileType::HistoryRestart) {
-          // Update the date of last write and sample size
-          write_timestamp (filespecs.filename,"last_write",m_output_control.last_write_ts,true);
-          scorpio::set_attribute (filespecs.filename,"GLOBAL","last_output_filename",m_output_file_specs.filename);
-          scorpio::set_attribute (filespecs.filename,"GLOBAL","num_snapshots_since_last_write",m_output_control.nsamples_since_last_write);
-          scorpio::set_attribute (filespecs.filename,"GLOBAL","last_output_file_num_snaps",m_output_file_specs.storage.num_snapshots_in_file);
+          // Update sample size (the date of last write is written below)
+          atts["last_output_filename"] = m_output_file_specs.filename;
+          atts["num_snapshots_since_last_write"] = m_output_control.nsamples_since_last_write;
+          atts["last_output_file_num_snaps"] = m_output_file_specs.storage.num_snapshots_in_file;
         }
         // Write these in both output and rhist file. The former, b/c we need these info when we postprocess
         // output, and the latter b/c we want to make sure these params don't change across restarts
-        set_attribute(filespecs.filename,"GLOBAL","averaging_type",e2str(m_avg_type));
-        set_attribute(filespecs.filename,"GLOBAL","averaging_frequency_units",m_output_control.frequency_units);
-        set_attribute(filespecs.filename,"GLOBAL","averaging_frequency",m_output_control.frequency);
-        set_attribute(filespecs.filename,"GLOBAL","file_max_storage_type",e2str(m_output_file_specs.storage.type));
+        atts["averaging_type"] = e2str(m_avg_type);
+        atts["averaging_frequency_units"] = m_output_control.frequency_units;
+        atts["averaging_frequency"] = m_output_control.frequency;
+        atts["file_max_storage_type"] = e2str(m_output_file_specs.storage.type);
         if (m_output_file_specs.storage.type==NumSnaps) {
-          set_attribute(filespecs.filename,"GLOBAL","max_snapshots_per_file",m_output_file_specs.storage.max_snapshots_in_file);
+          atts["max_snapshots_per_file"] = m_output_file_specs.storage.max_snapshots_in_file;
         }
-        const auto& fp_precision = m_params.get<std::string>("floating_point_precision");
-        set_attribute(filespecs.filename,"GLOBAL","fp_precision",fp_precision);
+        atts["fp_precision"] = m_params.get<std::string>("floating_point_precision");
       }
 
-      // Write all stored globals
+      // Add all stored globals
       for (const auto& it : m_globals) {
-        const auto& name = it.first;
-        const auto& any = *it.second;
-        if (any.type()==typeid(int)) {
-          set_attribute(filespecs.filename,"GLOBAL",name,std::any_cast<const int&>(any));
-        } else if (any.type()==typeid(std::int64_t)) {
-          set_attribute(filespecs.filename,"GLOBAL",name,std::any_cast<const std::int64_t&>(any));
-        } else if (any.type()==typeid(float)) {
-          set_attribute(filespecs.filename,"GLOBAL",name,std::any_cast<const float&>(any));
-        } else if (any.type()==typeid(double)) {
-          set_attribute(filespecs.filename,"GLOBAL",name,std::any_cast<const double&>(any));
-        } else if (any.type()==typeid(std::string)) {
-          set_attribute(filespecs.filename,"GLOBAL",name,std::any_cast<const std::string&>(any));
-        } else {
-          EKAT_ERROR_MSG (
-              "Error! Invalid concrete type for IO global.\n"
-              " - global name: " + it.first + "\n"
-              " - type id    : " + std::string(any.type().name()) + "\n");
-        }
+        atts[it.first] = *it.second;
       }
 
       // We're adding one snapshot to the file
@@ -553,10 +568,38 @@ void OutputManager::run(const util::TimeStamp& timestamp)
       // NOTE: for checkpoint files, unless we write restart data, we did not update time,
       //       which means we cannot write any variable (the check var.num_records==time.length
       //       would fail)
-      if (m_time_bnds.size()>0 and
-          (filespecs.ftype!=FileType::HistoryRestart or is_full_checkpoint_step)) {
-        scorpio::write_var(filespecs.filename, "time_bnds", m_time_bnds.data());
-      }
+      const bool write_time_bnds = m_time_bnds.size()>0 and
+                                   (filespecs.ftype!=FileType::HistoryRestart or is_full_checkpoint_step);
+      const bool write_last_write_ts = not m_is_model_restart_output and
+                                       filespecs.ftype==FileType::HistoryRestart;
+
+      run_io_task([filename=filespecs.filename, atts, write_time_bnds, time_bnds=m_time_bnds,
+                   write_last_write_ts, last_write_ts=m_output_control.last_write_ts]() {
+        if (write_last_write_ts) {
+          write_timestamp (filename,"last_write",last_write_ts,true);
+        }
+        for (const auto& [name,any] : atts) {
+          if (any.type()==typeid(int)) {
+            set_attribute(filename,"GLOBAL",name,std::any_cast<const int&>(any));
+          } else if (any.type()==typeid(std::int64_t)) {
+            set_attribute(filename,"GLOBAL",name,std::any_cast<const std::int64_t&>(any));
+          } else if (any.type()==typeid(float)) {
+            set_attribute(filename,"GLOBAL",name,std::any_cast<const float&>(any));
+          } else if (any.type()==typeid(double)) {
+            set_attribute(filename,"GLOBAL",name,std::any_cast<const double&>(any));
+          } else if (any.type()==typeid(std::string)) {
+            set_attribute(filename,"GLOBAL",name,std::any_cast<const std::string&>(any));
+          } else {
+            EKAT_ERROR_MSG (
+                "Error! Invalid concrete type for IO global.\n"
+                " - global name: " + name + "\n"
+                " - type id    : " + std::string(any.type().name()) + "\n");
+          }
+        }
+        if (write_time_bnds) {
+          scorpio::write_var(filename, "time_bnds", time_bnds.data());
+        }
+      });
 
       close_or_flush_if_needed(filespecs,control);
     };
@@ -573,7 +616,9 @@ void OutputManager::run(const util::TimeStamp& timestamp)
 
       // Always flush output during checkpoints (assuming we opened it already)
       if (m_output_file_specs.is_open) {
-        scorpio::flush_file (m_output_file_specs.filename);
+        run_io_task([filename=m_output_file_specs.filename]() {
+          scorpio::flush_file (filename);
+        });
       }
     }
     stop_timer(timer_root+"::update_snapshot_tally");
@@ -693,6 +738,9 @@ setup_internals (const std::shared_ptr<fm_type>& field_mgr,
 
     // Hard code some parameters in case we access them later
     m_params.set<std::string>("floating_point_precision","real");
+
+    // The restart file must be complete before we move on
+    m_params.set("async_write",false);
   } else {
     auto avg_type = m_params.get<std::string>("averaging_type");
     m_avg_type = str2avg(avg_type);
@@ -721,6 +769,16 @@ setup_internals (const std::shared_ptr<fm_type>& field_mgr,
     m_filename_prefix = m_params.get<std::string>("filename_prefix");
     m_output_file_specs.flush_frequency = m_params.get("flush_frequency",1);
 
+    // If true, the scorpio calls of write steps are done by a background thread
+    m_async_write = m_params.get("async_write",false);
+    if (m_async_write and not scorpio::async_tasks_supported()) {
+      m_atm_logger->warn("[EAMxx::output_manager] Async writes require MPI_THREAD_MULTIPLE,\n"
+                         "  which MPI does not provide. Falling back to synchronous writes.\n"
+                         "  yaml file: " + m_params.name() + "\n");
+      m_async_write = false;
+      m_params.set("async_write",false);
+    }
+
     // Allow user to ask for higher precision for normal model output,
     // but default to single to save on storage
     const auto& prec = m_params.get<std::string>("floating_point_precision", "single");
@@ -849,7 +907,7 @@ setup_file (      IOFileSpecs& filespecs,
 
   // Make all output streams register their dims/vars
   for (auto& it : m_output_streams) {
-    it->setup_output_file(filename,fp_precision,mode);
+    it->setup_output_file(filename,fp_precision,mode,filespecs.is_restart_file());
   }
 
   // If grid data is needed,  also register geo data fields. Skip if file is resumed,
@@ -937,10 +995,29 @@ close_or_flush_if_needed (      IOFileSpecs& file_specs,
   }
 
   if (not file_specs.storage.snapshot_fits(*window_start_ts)) {
-    scorpio::release_file(file_specs.filename);
+    run_io_task([filename=file_specs.filename]() {
+      scorpio::release_file(filename);
+    });
     file_specs.close();
   } else if (file_specs.file_needs_flush()) {
-    scorpio::flush_file (file_specs.filename);
+    if (m_coordinator) {
+      // Flush all files together, once all output managers are done with this step
+      m_coordinator->request_flush(file_specs.filename,m_async_write);
+    } else {
+      run_io_task([filename=file_specs.filename]() {
+        scorpio::flush_file (filename);
+      });
+    }
+  }
+}
+
+void OutputManager::
+run_io_task (const std::function<void()>& task) const
+{
+  if (m_async_write) {
+    scorpio::enqueue_async_task(task);
+  } else {
+    task();
   }
 }
 
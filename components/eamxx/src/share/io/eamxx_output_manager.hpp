@@ -2,6 +2,7 @@
 #define SCREAM_OUTPUT_MANAGER_HPP
 
 #include "share/io/scorpio_output.hpp"
+#include "share/io/eamxx_output_coordinator.hpp"
 #include "share/io/eamxx_scorpio_interface.hpp"
 #include "share/io/eamxx_io_utils.hpp"
 #include "share/io/eamxx_io_file_specs.hpp"
@@ -16,6 +17,8 @@
 #include <ekat_comm.hpp>
 #include <ekat_parameter_list.hpp>
 
+#include <functional>
+
 namespace scream
 {
 
@@ -104,6 +107,10 @@ public:
               const std::set<std::string>& grid_names);
 
   void set_logger(const std::shared_ptr<ekat::logger::LoggerBase>& atm_logger);
+
+  // Share diags/remaps/flushes with other output managers. Must be called before setup.
+  void set_output_coordinator (const std::shared_ptr<OutputCoordinator>& coordinator);
+
   void add_global (const std::string& name, const std::shared_ptr<std::any>& global);
 
   void init_timestep (const util::TimeStamp& start_of_step, const Real dt);
@@ -136,6 +143,10 @@ protected:
   void close_or_flush_if_needed (      IOFileSpecs& file_specs,
                                  const IOControl&   control) const;
 
+  // Run a task containing scorpio calls, either immediately or, if m_async_write=true,
+  // in the scorpio async worker thread (see eamxx_scorpio_interface.hpp)
+  void run_io_task (const std::function<void()>& task) const;
+
   // Manage logging of info to atm.log
   void push_to_logger();
 
@@ -188,6 +199,14 @@ protected:
 
   // If true, we save grid data in output file
   bool m_save_grid_data;
+
+  // If true, the scorpio calls of write steps (variables, globals, file close/flush)
+  // are executed asynchronously, so that the model can proceed while data is written.
+  // The data is snapshotted, so it is safe for the model to change it.
+  bool m_async_write = false;
+
+  // If set, used to avoid redundant work across output streams
+  std::shared_ptr<OutputCoordinator> m_coordinator;
 };
 
 } // namespace scream
@@ -8,13 +8,112 @@
 #include <ekat_assert.hpp>
 
 #include <pio.h>
+#include <mpi.h>
 
 #include <set>
 #include <numeric>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
 
 namespace scream {
 namespace scorpio {
 
+// A background thread executing tasks in FIFO order. Used to run scorpio
+// calls asynchronously (see enqueue_async_task in the header).
+struct AsyncWorker
+{
+  using task_t = std::function<void()>;
+
+  ~AsyncWorker () { stop(); }
+
+  bool is_worker_thread () const {
+    return m_thread.joinable() and std::this_thread::get_id()==m_thread.get_id();
+  }
+
+  void enqueue (const task_t& task) {
+    if (not m_thread.joinable()) {
+      m_stop = false;
+      m_thread = std::thread([this](){ loop(); });
+    }
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_tasks.push_back(task);
+      ++m_num_pending;
+    }
+    m_cv_task.notify_one();
+  }
+
+  void wait () {
+    if (m_num_pending.load()>0) {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv_done.wait(lock,[this](){ return m_num_pending.load()==0; });
+    }
+    if (m_error) {
+      // Rethrow (only once) the first error encountered by the worker
+      auto err = m_error;
+      m_error = nullptr;
+      std::rethrow_exception(err);
+    }
+  }
+
+  void stop () {
+    if (not m_thread.joinable()) return;
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_stop = true;
+    }
+    m_cv_task.notify_one();
+    m_thread.join();
+  }
+
+private:
+  void loop () {
+    while (true) {
+      task_t task;
+      {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv_task.wait(lock,[this](){ return m_stop or not m_tasks.empty(); });
+        if (m_tasks.empty()) {
+          return; // m_stop=true, and nothing left to do
+        }
+        task = std::move(m_tasks.front());
+        m_tasks.pop_front();
+      }
+
+      // After an error, we skip all remaining tasks: they most likely depend
+      // on the failed one. The error is rethrown in the next call to wait()
+      if (not m_error) {
+        try {
+          task();
+        } catch (...) {
+          m_error = std::current_exception();
+        }
+      }
+      // Release captured resources (e.g., staging buffers) before waking up waiters
+      task = nullptr;
+
+      {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        --m_num_pending;
+      }
+      m_cv_done.notify_all();
+    }
+  }
+
+  std::thread               m_thread;
+  std::mutex                m_mutex;
+  std::condition_variable   m_cv_task;
+  std::condition_variable   m_cv_done;
+  std::deque<task_t>        m_tasks;
+  std::atomic<int>          m_num_pending{0};
+  std::exception_ptr        m_error;
+  bool                      m_stop = false;
+};
+
 // This class is an implementation detail, and therefore it is hidden inside
 // a cpp file. All customers of IO capabilities must use the common interfaces
 // exposed in the header file of this source file.
@@ -23,6 +122,16 @@ struct ScorpioSession
 {
 public:
   static ScorpioSession& instance () {
+    auto& s = instance_no_wait();
+    // Unless we are the async worker, we must not interleave PIO calls with
+    // pending async tasks: PIO calls must happen in the same order on all ranks
+    if (not s.async_worker.is_worker_thread()) {
+      s.async_worker.wait();
+    }
+    return s;
+  }
+
+  static ScorpioSession& instance_no_wait () {
     static ScorpioSession s;
     return s;
   }
@@ -52,6 +161,8 @@ public:
 
   ekat::Comm  comm;
 
+  AsyncWorker async_worker;
+
 private:
 
   ScorpioSession () = default;
@@ -221,6 +332,8 @@ int pio_iotype (IOType iotype) {
     case IOType::Adios:         iotype_int = static_cast<int>(PIO_IOTYPE_ADIOS);    break;
     case IOType::Adiosc:        iotype_int = static_cast<int>(PIO_IOTYPE_ADIOSC);   break;
     case IOType::Hdf5:          iotype_int = static_cast<int>(PIO_IOTYPE_HDF5);     break;
+    case IOType::NetCDF4c:      iotype_int = static_cast<int>(PIO_IOTYPE_NETCDF4C); break;
+    case IOType::NetCDF4p:      iotype_int = static_cast<int>(PIO_IOTYPE_NETCDF4P); break;
     default:
       EKAT_ERROR_MSG ("Unrecognized/unsupported iotype.\n");
   }
@@ -351,6 +464,32 @@ void init_subsystem(const ekat::Comm& comm, const int atm_id)
       "Error! PIO was configured with PIO_OFFSET not a 64-bit int.\n");
 }
 
+bool async_tasks_supported ()
+{
+  int provided;
+  MPI_Query_thread(&provided);
+  return provided==MPI_THREAD_MULTIPLE;
+}
+
+void enqueue_async_task (const std::function<void()>& task)
+{
+  if (not async_tasks_supported()) {
+    // Calling MPI from two threads at once would be undefined behavior
+    task();
+    return;
+  }
+
+  // Note: ScorpioSession::instance() would wait for pending tasks
+  auto& s = ScorpioSession::instance_no_wait();
+  s.async_worker.enqueue(task);
+}
+
+void wait_async_tasks ()
+{
+  // Getting the session already waits for all pending tasks
+  ScorpioSession::instance();
+}
+
 bool is_subsystem_inited () {
   return ScorpioSession::instance().pio_sysid!=-1;
 }
@@ -365,6 +504,9 @@ void finalize_subsystem ()
   EKAT_REQUIRE_MSG (s.pio_sysid!=-1,
       "Error! PIO subsystem was already finalized.\n");
 
+  // Note: all pending async tasks are already completed (see ScorpioSession::instance)
+  s.async_worker.stop();
+
   for (auto& it : s.files) {
     EKAT_REQUIRE_MSG (it.second.num_customers==0,
       "Error! ScorpioSession::finalize called, but a file is still in use elsewhere.\n"
@@ -1049,6 +1191,69 @@ void define_var (const std::string& filename, const std::string& varname,
   define_var(filename,varname,"",dimensions,dtype,dtype,time_dependent);
 }
 
+bool is_iotype_available (const IOType iotype)
+{
+  return iotype==IOType::DefaultIOType or PIOc_iotype_available(pio_iotype(iotype))==1;
+}
+
+bool supports_compression (const std::string& filename)
+{
+  const auto& f = impl::get_file(filename,"scorpio::supports_compression");
+
+  // Only netCDF4 files support filters
+  const int iotype = pio_iotype(f.iotype);
+  return iotype==PIO_IOTYPE_NETCDF4C or iotype==PIO_IOTYPE_NETCDF4P;
+}
+
+bool set_var_compression (const std::string& filename, const std::string& varname,
+                          const int deflate_level, const bool shuffle)
+{
+  const auto& f = impl::get_file(filename,"scorpio::set_var_compression");
+  const auto& var = impl::get_var(filename,varname,"scorpio::set_var_compression");
+
+  EKAT_REQUIRE_MSG (deflate_level>=0 and deflate_level<=9,
+      "Error! Invalid deflate level. Valid values are 0 (no compression) through 9.\n"
+      " - filename: " + filename + "\n"
+      " - varname : " + varname + "\n"
+      " - level   : " + std::to_string(deflate_level) + "\n");
+  EKAT_REQUIRE_MSG (not f.enddef,
+      "Error! Compression must be set right after defining the variable, before enddef.\n"
+      " - filename: " + filename + "\n"
+      " - varname : " + varname + "\n");
+
+  if (deflate_level==0 or not supports_compression(filename)) {
+    return false;
+  }
+
+  // Depending on how netcdf/hdf5 were built, parallel filters may not be available.
+  // In that case, we simply write the var uncompressed, rather than erroring out.
+  int err = PIOc_def_var_deflate(f.ncid,var.ncid,shuffle ? 1 : 0,1,deflate_level);
+  return err==PIO_NOERR;
+}
+
+bool get_var_compression (const std::string& filename, const std::string& varname,
+                          int& deflate_level, bool& shuffle)
+{
+  const auto& f = impl::get_file(filename,"scorpio::get_var_compression");
+  const auto& var = impl::get_var(filename,varname,"scorpio::get_var_compression");
+
+  deflate_level = 0;
+  shuffle = false;
+  if (not supports_compression(filename)) {
+    return false;
+  }
+
+  int shuffle_int, deflate;
+  int err = PIOc_inq_var_deflate(f.ncid,var.ncid,&shuffle_int,&deflate,&deflate_level);
+  check_scorpio_noerr(err,filename,"variable",varname,"get_var_compression","inq_var_deflate");
+  if (deflate==0) {
+    deflate_level = 0;
+    return false;
+  }
+  shuffle = shuffle_int==1;
+  return true;
+}
+
 // This overload is not exposed externally. Also, filename is only
 // used to print it in case there are errors
 void change_var_dtype (PIOVar& var,
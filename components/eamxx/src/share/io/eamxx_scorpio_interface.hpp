@@ -6,6 +6,7 @@
 #include <ekat_comm.hpp>
 #include <ekat_assert.hpp>
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -69,6 +70,26 @@ void init_subsystem(const ekat::Comm& comm, const int atm_id = 0);
 bool is_subsystem_inited ();
 void finalize_subsystem ();
 
+// =================== Async operations ================= //
+
+// Enqueue a task (containing calls to this interface), to be executed by a
+// background thread. Tasks are executed in the order they are enqueued.
+// Any call to this interface from a different thread first waits for ALL
+// pending tasks to complete, so that PIO calls are always issued in the same
+// order on all ranks. Hence, the task must not use data that the caller may
+// change before the next call to this interface (capture by value).
+// An exception thrown by a task is rethrown by the next interface call.
+// NOTE: PIO calls are MPI collectives, so running them on a background thread
+//       while the main thread does MPI requires MPI_THREAD_MULTIPLE. If MPI was
+//       not initialized with that level, the task is executed right away.
+void enqueue_async_task (const std::function<void()>& task);
+
+// Whether enqueued tasks are actually executed asynchronously (see above)
+bool async_tasks_supported ();
+
+// Wait for all pending async tasks to complete
+void wait_async_tasks ();
+
 // =================== File operations ================= //
 
 // Opens a file, returns const handle to it (useful for Read mode, to get dims/vars)
@@ -162,6 +183,24 @@ void define_var (const std::string& filename, const std::string& varname,
                  const std::string& dtype,
                  const bool time_dependent = false);
 
+// Whether the given iotype is available in the current PIO build
+bool is_iotype_available (const IOType iotype);
+
+// Whether the file supports compression filters (only netCDF4 files do)
+bool supports_compression (const std::string& filename);
+
+// Enable deflate compression (with optional byte shuffle) for a var. Must be called
+// after define_var, but before the first enddef call. Returns true if the filter
+// was set, and false if the file does not support compression, if deflate_level=0,
+// or if the filter could not be set (e.g., netcdf/hdf5 lack parallel filters).
+bool set_var_compression (const std::string& filename, const std::string& varname,
+                          const int deflate_level, const bool shuffle = true);
+
+// Retrieve the deflate settings of a var. Returns false (and sets deflate_level=0)
+// if the var is not compressed.
+bool get_var_compression (const std::string& filename, const std::string& varname,
+                          int& deflate_level, bool& shuffle);
+
 // This is useful when reading data sets. E.g., if the pio file is storing
 // a var as float, but we need to read it as double, we need to call this.
 // NOTE: read_var/write_var automatically change the dtype if the input
@@ -28,6 +28,8 @@ enum IOType {
   Adios,
   Adiosc,
   Hdf5,
+  NetCDF4c,
+  NetCDF4p,
   Invalid
 };
 
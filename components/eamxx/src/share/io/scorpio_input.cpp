@@ -5,6 +5,7 @@
 
 #include <ekat_string_utils.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <numeric>
 
@@ -163,6 +164,9 @@ set_fields (const std::vector<Field>& fields) {
 void AtmosphereInput::
 reset_filename (const std::string& filename)
 {
+  EKAT_REQUIRE_MSG (not m_pending_read,
+      "Error! Cannot reset the filename while a split-phase read is pending.\n"
+      " - file name: " + m_filename + "\n");
   if (m_filename!="") {
     scorpio::release_file(m_filename);
   }
@@ -212,10 +216,13 @@ void AtmosphereInput::read_variables (const int time_index)
   EKAT_REQUIRE_MSG (m_fields_inited and m_scorpio_inited,
       "Error! Internal structures not fully inited yet. Did you forget to call 'init(..)'?\n");
 
+  EKAT_REQUIRE_MSG (not m_pending_read,
+      "Error! Cannot read variables while a split-phase read is pending.\n"
+      " - file name: " + m_filename + "\n");
+
   for (auto const& name : m_fields_names) {
 
     auto f_scorpio = m_fm_for_scorpio->get_field(name);
-    auto f_user    = m_fm_from_user->get_field(name);
 
     // Read the data
     switch (f_scorpio.data_type()) {
@@ -235,10 +242,7 @@ void AtmosphereInput::read_variables (const int time_index)
             " - field name: " + name + "\n");
     }
 
-    f_scorpio.sync_to_dev();
-    if (not f_scorpio.is_aliasing(f_user)) {
-      f_user.deep_copy(f_scorpio);
-    }
+    copy_to_user_field(name);
   }
   if (m_atm_logger) {
     auto func_finish = std::chrono::steady_clock::now();
@@ -247,9 +251,127 @@ void AtmosphereInput::read_variables (const int time_index)
   }
 }
 
+void AtmosphereInput::start_read_variables (const int time_index)
+{
+  m_atm_logger->info("[EAMxx::scorpio_input] Starting read of variables from file");
+  m_atm_logger->info("  file name: " + m_filename);
+  m_atm_logger->info("  var names: " + ekat::join(m_fields_names,", "));
+  if (time_index!=-1) {
+    m_atm_logger->info("  time idx : " + std::to_string(time_index));
+  }
+
+  EKAT_REQUIRE_MSG (m_fields_inited and m_scorpio_inited,
+      "Error! Internal structures not fully inited yet. Did you forget to call 'init(..)'?\n");
+  EKAT_REQUIRE_MSG (not m_pending_read,
+      "Error! Cannot start a read while the previous one is still pending.\n"
+      " - file name: " + m_filename + "\n");
+
+  struct VarRead {
+    std::string name;
+    DataType    dt;
+    std::shared_ptr<std::vector<char>> buf;
+  };
+  std::vector<VarRead> reads;
+  for (const auto& name : m_fields_names) {
+    const auto& f = m_fm_for_scorpio->get_field(name);
+    const auto dt = f.data_type();
+    int dt_size;
+    switch (dt) {
+      case DataType::DoubleType:  dt_size = sizeof(double); break;
+      case DataType::FloatType:   dt_size = sizeof(float);  break;
+      case DataType::IntType:     dt_size = sizeof(int);    break;
+      default:
+        EKAT_ERROR_MSG (
+            "Error! Unsupported/unrecognized data type while reading field from file.\n"
+            " - file name : " + m_filename + "\n"
+            " - field name: " + name + "\n");
+    }
+    auto& buf = m_read_staging[name];
+    if (buf==nullptr) {
+      buf = std::make_shared<std::vector<char>>();
+    }
+    buf->resize(f.get_header().get_identifier().get_layout().size()*dt_size);
+    reads.push_back({name,dt,buf});
+  }
+
+  // Capture by value: the task must not depend on this object's state
+  scorpio::enqueue_async_task([filename=m_filename,time_index,reads]() {
+    for (const auto& r : reads) {
+      switch (r.dt) {
+        case DataType::DoubleType:
+          scorpio::read_var(filename,r.name,reinterpret_cast<double*>(r.buf->data()),time_index);
+          break;
+        case DataType::FloatType:
+          scorpio::read_var(filename,r.name,reinterpret_cast<float*>(r.buf->data()),time_index);
+          break;
+        default:
+          scorpio::read_var(filename,r.name,reinterpret_cast<int*>(r.buf->data()),time_index);
+      }
+    }
+  });
+  m_pending_read = true;
+}
+
+void AtmosphereInput::finish_read_variables ()
+{
+  auto func_start = std::chrono::steady_clock::now();
+  EKAT_REQUIRE_MSG (m_pending_read,
+      "Error! Cannot finish a read that was never started.\n"
+      " - file name: " + m_filename + "\n");
+
+  m_pending_read = false;
+  scorpio::wait_async_tasks();
+
+  for (const auto& name : m_fields_names) {
+    EKAT_REQUIRE_MSG (m_read_staging.count(name)==1,
+        "Error! The fields were changed during a split-phase read.\n"
+        " - file name : " + m_filename + "\n"
+        " - field name: " + name + "\n");
+    const auto& buf = *m_read_staging.at(name);
+    auto f_scorpio = m_fm_for_scorpio->get_field(name);
+    auto copy = [&](auto* dst) {
+      using T = std::remove_pointer_t<decltype(dst)>;
+      const int n = f_scorpio.get_header().get_identifier().get_layout().size();
+      EKAT_REQUIRE_MSG (buf.size()==n*sizeof(T),
+          "Error! The field layout was changed during a split-phase read.\n"
+          " - file name : " + m_filename + "\n"
+          " - field name: " + name + "\n");
+      const T* src = reinterpret_cast<const T*>(buf.data());
+      std::copy(src,src+n,dst);
+    };
+    switch (f_scorpio.data_type()) {
+      case DataType::DoubleType:  copy(f_scorpio.get_internal_view_data<double,Host>()); break;
+      case DataType::FloatType:   copy(f_scorpio.get_internal_view_data<float,Host>());  break;
+      default:                    copy(f_scorpio.get_internal_view_data<int,Host>());
+    }
+    copy_to_user_field(name);
+  }
+  if (m_atm_logger) {
+    auto func_finish = std::chrono::steady_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(func_finish - func_start)/1000.0;
+    m_atm_logger->debug("  Done! Waited for pending read for " + std::to_string(duration.count()) +" seconds");
+  }
+}
+
+void AtmosphereInput::copy_to_user_field (const std::string& name)
+{
+  auto f_scorpio = m_fm_for_scorpio->get_field(name);
+  auto f_user    = m_fm_from_user->get_field(name);
+
+  f_scorpio.sync_to_dev();
+  if (not f_scorpio.is_aliasing(f_user)) {
+    f_user.deep_copy(f_scorpio);
+  }
+}
+
 /* ---------------------------------------------------------- */
 void AtmosphereInput::finalize()
 {
+  // Do not leave a pending read behind (its result is discarded)
+  if (m_pending_read) {
+    scorpio::wait_async_tasks();
+    m_pending_read = false;
+  }
   if (m_scorpio_inited) {
     scorpio::release_file(m_filename);
   }
@@ -342,9 +464,10 @@ AtmosphereInput::get_vec_of_dims(const FieldLayout& layout)
                   ? m_io_grid->get_special_tag_name(t)
                   : layout.names()[i];
 
-    // If t==CMP, and the name stored in the layout is the default ("dim"),
+    // If t==CMP, and the name stored in the layout is "dim" (the default) or "bin",
     // we append also the extent, to allow different vector dims in the file
-    n += n=="dim" ? std::to_string(layout.dim(i)) : "";
+    // NOTE: this must match what AtmosphereOutput does
+    n += (n=="dim" or n=="bin") ? std::to_string(layout.dim(i)) : "";
 
     dims_names.push_back(n);
   }
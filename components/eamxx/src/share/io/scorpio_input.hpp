@@ -86,6 +86,18 @@ public:
   // Read fields that were required via parameter list.
   void read_variables (const int time_index = -1);
 
+  // Split-phase version of read_variables. The start method queues the read of the
+  // variables in host staging buffers, to be executed by the scorpio async worker (see
+  // enqueue_async_task in eamxx_scorpio_interface.hpp), and returns right away.
+  // The finish method waits for the read, and copies the data in the fields.
+  // In between, the fields can be reset (e.g., to swap buffers), as long as names and
+  // layouts are unchanged, but the filename cannot.
+  // NOTE: any scorpio call from the main thread waits for the pending read, so the read
+  //       only overlaps with work that does not do any I/O.
+  void start_read_variables (const int time_index = -1);
+  void finish_read_variables ();
+  bool has_pending_read () const { return m_pending_read; }
+
   // Cleans up the class
   void finalize();
 
@@ -109,6 +121,9 @@ protected:
 
   void set_decompositions();
 
+  // Copy the data of the scorpio field (on host) to the user field (on device)
+  void copy_to_user_field (const std::string& name);
+
   std::vector<std::string> get_vec_of_dims (const FieldLayout& layout);
 
   // Internal variables
@@ -124,6 +139,10 @@ protected:
   bool m_fields_inited  = false;
   bool m_scorpio_inited = false;
 
+  // Staging buffers for split-phase reads (reused across reads)
+  std::map<std::string,std::shared_ptr<std::vector<char>>>  m_read_staging;
+  bool m_pending_read = false;
+
   std::shared_ptr<ekat::logger::LoggerBase> m_atm_logger = console_logger(ekat::logger::LogLevel::warn);
 }; // Class AtmosphereInput
 
@@ -5,12 +5,19 @@
 #include "share/grid/remap/vertical_remapper.hpp"
 #include "share/util/eamxx_timing.hpp"
 #include "share/field/field_utils.hpp"
+#include "share/field/field_online_stats.hpp"
+#include "share/field/field_quantize.hpp"
 
 #include <ekat_units.hpp>
 #include <ekat_string_utils.hpp>
 #include <ekat_std_utils.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <future>
+#include <memory>
 #include <numeric>
+#include <type_traits>
 
 namespace {
   // Helper lambda, to copy extra data (io string attributes plus filled settings).
@@ -32,6 +39,23 @@ namespace {
       tgt.get_header().set_may_be_filled(true);
     }
   };
+
+  // Copy the (possibly padded) data of a field of type ST into a contiguous array of type T.
+  // Like in FieldTally, arrays are seen as 2d, with the last dim possibly padded
+  template<typename ST, typename T>
+  struct PackKernel {
+    KOKKOS_INLINE_FUNCTION
+    void operator() (const int idx) const {
+      const int i = idx / dim;
+      const int j = idx % dim;
+      // Note: fill_value has the same numerical value for all fp types, so a cast is enough
+      dst[idx] = static_cast<T>(src[i*ld + j]);
+    }
+
+    const ST* src;
+    T*        dst;
+    int       dim, ld;
+  };
 }
 
 namespace scream
@@ -72,8 +96,10 @@ AtmosphereOutput (const ekat::Comm& comm,
 AtmosphereOutput::
 AtmosphereOutput (const ekat::Comm& comm, const ekat::ParameterList& params,
                   const std::shared_ptr<const fm_type>& field_mgr,
-                  const std::string& grid_name)
+                  const std::string& grid_name,
+                  const std::shared_ptr<OutputCoordinator>& coordinator)
  : m_comm           (comm)
+ , m_coordinator    (coordinator)
  , m_add_time_dim   (true)
 {
   using vos_t = std::vector<std::string>;
@@ -85,7 +111,67 @@ AtmosphereOutput (const ekat::Comm& comm, const ekat::ParameterList& params,
   m_avg_type = str2avg(avg_type);
   EKAT_REQUIRE_MSG (m_avg_type!=OutputAvgType::Invalid,
       "Error! Unsupported averaging type '" + avg_type + "'.\n"
-      "       Valid options: instant, Max, Min, Average. Case insensitive.\n");
+      "       Valid options: instant, Max, Min, Average, Variance, Histogram, Exceedance. Case insensitive.\n");
+
+  // Some statistics need extra parameters
+  if (m_avg_type==OutputAvgType::Histogram) {
+    EKAT_REQUIRE_MSG (params.isParameter("histogram_bin_edges"),
+        "Error! Histogram output requires the parameter 'histogram_bin_edges'.\n"
+        " - yaml file: " + params.name() + "\n");
+    for (auto e : params.get<std::vector<double>>("histogram_bin_edges")) {
+      m_hist_edges.push_back(e);
+    }
+    EKAT_REQUIRE_MSG (m_hist_edges.size()>=2 and
+                      std::adjacent_find(m_hist_edges.begin(),m_hist_edges.end(),std::greater_equal<Real>())==m_hist_edges.end(),
+        "Error! The histogram bin edges must be at least two, and strictly increasing.\n"
+        " - yaml file: " + params.name() + "\n");
+    m_hist_edges_d = decltype(m_hist_edges_d)("hist_edges",m_hist_edges.size());
+    auto edges_h = Kokkos::create_mirror_view(m_hist_edges_d);
+    for (size_t i=0; i<m_hist_edges.size(); ++i) {
+      edges_h(i) = m_hist_edges[i];
+    }
+    Kokkos::deep_copy(m_hist_edges_d,edges_h);
+  } else if (m_avg_type==OutputAvgType::Exceedance) {
+    EKAT_REQUIRE_MSG (params.isParameter("exceedance_threshold"),
+        "Error! Exceedance output requires the parameter 'exceedance_threshold'.\n"
+        " - yaml file: " + params.name() + "\n");
+    m_exceedance_threshold = params.get<double>("exceedance_threshold");
+  }
+
+  // Lossy quantization of the output vars, possibly with per-var overrides,
+  // and (lossless) compression of all vars, if the file type supports it
+  if (params.isParameter("significant_digits")) {
+    m_significant_digits = params.get<int>("significant_digits");
+  }
+  if (params.isSublist("significant_digits_per_field")) {
+    const auto& pl = params.sublist("significant_digits_per_field");
+    for (auto it=pl.params_names_cbegin(); it!=pl.params_names_cend(); ++it) {
+      m_significant_digits_per_var[*it] = pl.get<int>(*it);
+    }
+  }
+  auto check_digits = [&](const int digits) {
+    EKAT_REQUIRE_MSG (digits>=0,
+        "Error! The number of significant digits cannot be negative (use 0 for no quantization).\n"
+        " - yaml file: " + params.name() + "\n"
+        " - digits   : " + std::to_string(digits) + "\n");
+  };
+  check_digits(m_significant_digits);
+  for (const auto& [name,digits] : m_significant_digits_per_var) {
+    check_digits(digits);
+  }
+  if (params.isParameter("compression_level")) {
+    m_compression_level = params.get<int>("compression_level");
+    EKAT_REQUIRE_MSG (m_compression_level>=0 and m_compression_level<=9,
+        "Error! Invalid compression level. Valid values are 0 (no compression) through 9.\n"
+        " - yaml file: " + params.name() + "\n"
+        " - compression_level: " + std::to_string(m_compression_level) + "\n");
+  }
+
+  // If requested, the global sums of diags (e.g., horiz/zonal averages)
+  // are done with a single reduction
+  if (params.isParameter("batch_global_sums") and params.get<bool>("batch_global_sums")) {
+    m_sum_batch = std::make_shared<FieldSumBatch>(m_comm);
+  }
 
   // By default, IO is done directly on the field mgr grid
   auto fm_grid = field_mgr->get_grids_manager()->get_grid(grid_name);
@@ -199,28 +285,28 @@ AtmosphereOutput (const ekat::Comm& comm, const ekat::ParameterList& params,
     }
   }
 
+  if (params.isParameter("async_write")) {
+    m_async_write = params.get<bool>("async_write");
+  }
+
   // Setup remappers - if needed
   auto grid_after_vr = fm_grid;
+  std::string remap_key = fm_grid->name();
   if (use_vertical_remap_from_file) {
     // We build a remapper, to remap fields from the fm grid to the io grid
     auto vert_remap_file   = params.get<std::string>("vertical_remap_file");
-    auto p_mid = fm_model->get_field("p_mid");
-    auto p_int = fm_model->get_field("p_int");
-    auto vert_remapper = std::make_shared<VerticalRemapper>(fm_model->get_grid(),vert_remap_file);
-    vert_remapper->set_source_pressure (p_mid,p_int);
-    vert_remapper->set_extrapolation_type(VerticalRemapper::Mask); // both Top AND Bot
-    m_vert_remapper = vert_remapper;
-
-    grid_after_vr = m_vert_remapper->get_tgt_grid();
-    fm_after_vr = std::make_shared<FieldManager>(grid_after_vr,RepoState::Closed);
-
-    for (const auto& fname : m_fields_names) {
-      auto src = fm_model->get_field(fname,fm_grid->name());
-      auto tgt = m_vert_remapper->register_field_from_src(src);
-      transfer_extra_data (src,tgt);
-      fm_after_vr->add_field(tgt);
-    }
-    m_vert_remapper->registration_ends();
+    auto create_remapper = [&]() {
+      auto p_mid = fm_model->get_field("p_mid");
+      auto p_int = fm_model->get_field("p_int");
+      auto vert_remapper = std::make_shared<VerticalRemapper>(fm_model->get_grid(),vert_remap_file);
+      vert_remapper->set_source_pressure (p_mid,p_int);
+      vert_remapper->set_extrapolation_type(VerticalRemapper::Mask); // both Top AND Bot
+      return std::shared_ptr<remapper_type>(vert_remapper);
+    };
+
+    remap_key += "|vert_remap:" + vert_remap_file;
+    fm_after_vr = setup_remap(remap_key,fm_model,create_remapper,m_vert_remapper,m_ext_vert_remappers);
+    grid_after_vr = fm_after_vr->get_grid();
   } else {
     // No vert remap. Simply alias the fm from the model
     fm_after_vr = fm_model;
@@ -230,26 +316,25 @@ AtmosphereOutput (const ekat::Comm& comm, const ekat::ParameterList& params,
   auto grid_after_hr = grid_after_vr;
   if (use_online_remapper || use_horiz_remap_from_file) {
     // We build a remapper, to remap fields from the fm grid to the io grid
+    std::function<std::shared_ptr<remapper_type>()> create_remapper;
     if (use_horiz_remap_from_file) {
       // Construct the coarsening remapper
       auto horiz_remap_file   = params.get<std::string>("horiz_remap_file");
-      m_horiz_remapper = std::make_shared<CoarseningRemapper>(grid_after_vr,horiz_remap_file,true);
+      create_remapper = [=]() -> std::shared_ptr<remapper_type> {
+        return std::make_shared<CoarseningRemapper>(grid_after_vr,horiz_remap_file,true);
+      };
+      remap_key += "|horiz_remap:" + horiz_remap_file;
     } else {
       // Construct a generic remapper (likely, Dyn->PhysicsGLL)
       grid_after_hr = gm->get_grid(io_grid_name);
-      m_horiz_remapper = gm->create_remapper(grid_after_vr,grid_after_hr);
+      create_remapper = [=]() {
+        return gm->create_remapper(grid_after_vr,grid_after_hr);
+      };
+      remap_key += "|online_remap:" + grid_after_hr->name();
     }
 
-    grid_after_hr = m_horiz_remapper->get_tgt_grid();
-    fm_after_hr = std::make_shared<FieldManager>(grid_after_hr,RepoState::Closed);
-
-    for (const auto& fname : m_fields_names) {
-      auto src = fm_after_vr->get_field(fname,grid_after_vr->name());
-      auto tgt = m_horiz_remapper->register_field_from_src(src);
-      transfer_extra_data (src,tgt);
-      fm_after_hr->add_field(tgt);
-    }
-    m_horiz_remapper->registration_ends();
+    fm_after_hr = setup_remap(remap_key,fm_after_vr,create_remapper,m_horiz_remapper,m_ext_horiz_remappers);
+    grid_after_hr = fm_after_hr->get_grid();
   } else {
     // No vert remap. Simply alias the fm after vr
     fm_after_hr = fm_after_vr;
@@ -278,6 +363,10 @@ void AtmosphereOutput::restart (const std::string& filename)
     fields.push_back(f);
   }
 
+  for (const auto& [fname,mean] : m_stats_mean) {
+    fields.push_back(mean);
+  }
+
   AtmosphereInput hist_restart (filename, fm->get_grid(), fields);
   hist_restart.read_variables();
 }
@@ -294,7 +383,7 @@ void AtmosphereOutput::init()
       (m_io_grid->get_global_max_dof_gid()-m_io_grid->get_global_min_dof_gid()+1)==m_io_grid->get_num_global_dofs(),
       "Error! In order for IO to work, the grid must (globally) have dof gids in interval [gid_0,gid_0+num_global_dofs).\n");
 
-  // Create FM for scorpio. The fields in this FM are guaranteed to NOT have parents/padding
+  // Create FM for scorpio. The fields in this FM are guaranteed to NOT have parents
   auto fm_scorpio = m_field_mgrs[Scorpio] = std::make_shared<FieldManager>(fm_after_hr->get_grid(),RepoState::Closed);
   for (size_t i = 0; i < m_fields_names.size(); ++i) {
     const auto& fname = m_fields_names[i];
@@ -303,14 +392,32 @@ void AtmosphereOutput::init()
     const auto& fh = f.get_header();
     const auto& fid = fh.get_identifier();
 
+    // For variance, histogram, and exceedance output, the var has different units,
+    // and, for histograms, an extra "bin" dimension
+    auto get_out_fid = [&]() {
+      using namespace ShortFieldTagsNames;
+      const auto nondim = ekat::units::Units::nondimensional();
+      switch (m_avg_type) {
+        case OutputAvgType::Variance:
+          return FieldIdentifier(fname,fid.get_layout(),fid.get_units()*fid.get_units(),fid.get_grid_name());
+        case OutputAvgType::Histogram:
+          return FieldIdentifier(fname,fid.get_layout().clone().append_dim(CMP,m_hist_edges.size()-1,"bin"),
+                                 nondim,fid.get_grid_name());
+        case OutputAvgType::Exceedance:
+          return FieldIdentifier(fname,fid.get_layout(),nondim,fid.get_grid_name());
+        default:
+          return fid;
+      }
+    };
+
     // Check if the field for scorpio can alias the field after hremap.
-    // It can do so only for Instant output, and if the field is NOT a subfield ant NOT padded
+    // It can do so only for Instant output, and if the field is NOT a subfield.
+    // Padding is fine, since padded fields are packed (on device) at write time (see run).
     // Also, if we track avg cnt, we MUST add the fill_value extra data, to trigger fill-value logic
     // when calling Field's update methods
     if (m_avg_type!=OutputAvgType::Instant or
-        fh.get_alloc_properties().get_padding()>0 or
         fh.get_parent()!=nullptr) {
-      Field copy(fid);
+      Field copy(get_out_fid());
       copy.allocate_view();
       transfer_extra_data (f,copy);
       fm_scorpio->add_field(copy);
@@ -319,9 +426,51 @@ void AtmosphereOutput::init()
     }
 
     // Store the field layout using alias name, so that calls to setup_output_file are easier
-    const auto& layout = fid.get_layout();
+    const auto& layout = fm_scorpio->get_field(fname).get_header().get_identifier().get_layout();
     m_vars_dims[alias] = get_var_dimnames(layout);
 
+    if (has_online_stats()) {
+      // The online stats kernels cannot handle subfields, so we will stage them in a contiguous copy
+      if (fh.get_alloc_properties().is_subfield()) {
+        Field x(fid);
+        x.allocate_view();
+        m_stats_inputs[fname] = x;
+      }
+
+      // For variance, we also need (and output) the mean
+      if (m_avg_type==OutputAvgType::Variance) {
+        const auto mean_name = alias + "_mean";
+        EKAT_REQUIRE_MSG (not ekat::contains(m_alias_names,mean_name),
+            "Error! Variance output of field '" + alias + "' would clash with the output of field '" + mean_name + "'.\n");
+        Field mean(fid.alias(mean_name));
+        mean.allocate_view();
+        m_stats_mean[fname] = mean;
+        m_vars_dims[mean_name] = m_vars_dims[alias];
+      }
+    }
+
+    // Quantization is done on a scratch copy, since the scorpio field may alias the model
+    // field (for instant output), or hold the tally (which must not be altered for checkpoints)
+    const auto it = m_significant_digits_per_var.find(alias);
+    const int digits = it==m_significant_digits_per_var.end() ? m_significant_digits : it->second;
+    if (digits>0) {
+      const auto& f_out = fm_scorpio->get_field(fname);
+      EKAT_REQUIRE_MSG (f_out.data_type()==get_data_type<Real>(),
+          "Error! Quantization is only supported for floating point vars.\n"
+          " - var name: " + alias + "\n");
+      Field q(f_out.get_header().get_identifier());
+      q.allocate_view();
+      m_quantized[fname] = q;
+      m_quantize_nsb[fname] = significant_digits_to_bits(digits);
+
+      // For variance, the mean is output too, and follows the same rule
+      if (m_stats_mean.count(fname)==1) {
+        Field qm(m_stats_mean.at(fname).get_header().get_identifier());
+        qm.allocate_view();
+        m_quantized_mean[fname] = qm;
+      }
+    }
+
     // Now check that all the dims of this field are already set to be registered.
     const auto& tags = layout.tags();
     const auto& dims = layout.dims();
@@ -359,14 +508,68 @@ void AtmosphereOutput::init()
 
     if (m_track_avg_cnt) {
       // Create and store a Field to track the averaging count for this layout
-      set_avg_cnt_tracking(fname,layout);
+      set_avg_cnt_tracking(fname,fid.get_layout());
     }
   }
 
   // For non-instantaneous output, ensure scorpio fields are
   // inited with correct value for accumulation
-  if (m_avg_type!=OutputAvgType::Instant)
+  if (m_avg_type!=OutputAvgType::Instant) {
     reset_scorpio_fields();
+    if (not has_online_stats()) {
+      setup_tally();
+    }
+  }
+}
+
+bool AtmosphereOutput::has_online_stats () const
+{
+  return m_avg_type==OutputAvgType::Variance or
+         m_avg_type==OutputAvgType::Histogram or
+         m_avg_type==OutputAvgType::Exceedance;
+}
+
+void AtmosphereOutput::setup_tally ()
+{
+  auto fm_scorpio = m_field_mgrs[Scorpio];
+  auto fm_after_hr = m_field_mgrs[AfterHorizRemap];
+
+  CombineMode cm;
+  switch (m_avg_type) {
+    case OutputAvgType::Max:
+      cm = CombineMode::Max; break;
+    case OutputAvgType::Min:
+      cm = CombineMode::Min; break;
+    case OutputAvgType::Average:
+      cm = CombineMode::Update; break;
+    default:
+      EKAT_ERROR_MSG ("Unexpected/unsupported averaging type.\n");
+  }
+  m_tally = std::make_shared<FieldTally>(cm);
+  m_tallied_fields.clear();
+  m_tallied_counts.clear();
+
+  // The mask of a count is computed from the first field using it (see run)
+  for (const auto& [fname, count] : m_field_to_avg_count) {
+    if (m_tallied_counts.count(count.name())==1) {
+      continue;
+    }
+    const auto& field = fm_after_hr->get_field(fname);
+    const auto& mask  = count.get_header().get_extra_data<Field>("mask");
+    if (m_tally->add_count(field,count,mask)) {
+      m_tallied_counts.insert(count.name());
+    }
+  }
+
+  for (const auto& fname : m_fields_names) {
+    const auto& f_in  = fm_after_hr->get_field(fname);
+    const auto& f_out = fm_scorpio->get_field(fname);
+    if (m_tally->add_field(f_in,f_out)) {
+      m_tallied_fields.insert(fname);
+    }
+  }
+
+  m_tally->close();
 }
 
 void AtmosphereOutput::
@@ -377,6 +580,76 @@ init_timestep (const util::TimeStamp& start_of_step)
   }
 }
 
+bool AtmosphereOutput::
+can_write_directly (const Field& f, const std::string& fp_dtype)
+{
+  // The host storage of a field can be handed to scorpio as is only if it is
+  // contiguous, and of the same type as the var in the file (int vars are always int)
+  const auto& ap = f.get_header().get_alloc_properties();
+  const bool same_type = f.data_type()==DataType::IntType or
+                         scorpio::refine_dtype("real")==fp_dtype;
+  return not ap.is_subfield() and ap.get_padding()==0 and same_type;
+}
+
+std::shared_ptr<AtmosphereOutput::HostBuffer> AtmosphereOutput::
+get_host_buffer (const std::string& varname, const size_t nbytes)
+{
+  auto& buf = m_host_buffers[varname];
+  if (buf==nullptr) {
+    buf = std::make_shared<HostBuffer>();
+  } else if (buf->write_done.valid()) {
+    // Wait for the previous (async) write of this var to be done with the data.
+    // Note: if the write failed, the error is rethrown by the next scorpio call
+    buf->write_done.wait();
+  }
+  buf->data.resize(nbytes);
+  return buf;
+}
+
+template<typename ST, typename T>
+const T* AtmosphereOutput::
+pack_to_host (const Field& f, const std::string& varname)
+{
+  using KT = KokkosTypes<DefaultDevice>;
+
+  const auto& layout = f.get_header().get_identifier().get_layout();
+  const auto& ap = f.get_header().get_alloc_properties();
+  EKAT_REQUIRE_MSG (not ap.is_subfield(),
+      "Error! Cannot pack a subfield for output.\n"
+      " - field name: " + f.name() + "\n");
+
+  const int size = layout.size();
+  auto buf = get_host_buffer(varname,size*sizeof(T));
+  auto host_data = reinterpret_cast<T*>(buf->data.data());
+  if (size==0) {
+    return host_data;
+  }
+
+  PackKernel<ST,T> k;
+  k.src = f.get_internal_view_data<const ST>();
+  k.dim = layout.rank()==0 ? 1 : layout.dims().back();
+  k.ld  = layout.rank()==0 ? 1 : ap.get_last_extent();
+  Kokkos::RangePolicy<KT::ExeSpace> policy(0,size);
+  if (Kokkos::SpaceAccessibility<KT::ExeSpace,Kokkos::HostSpace>::accessible) {
+    // Kernels can write host memory, so pack directly in the host buffer
+    k.dst = host_data;
+    Kokkos::parallel_for("AtmosphereOutput::pack",policy,k);
+    Kokkos::fence();
+  } else {
+    // Pack in a device buffer, then do a single copy to host
+    auto& dev = m_pack_buffers[varname];
+    if (dev.size()<size*sizeof(T)) {
+      dev = KT::view_1d<char>("pack_" + varname,size*sizeof(T));
+    }
+    k.dst = reinterpret_cast<T*>(dev.data());
+    Kokkos::parallel_for("AtmosphereOutput::pack",policy,k);
+    Unmanaged<KT::view_1d<T>> src_d (k.dst,size);
+    Unmanaged<KokkosTypes<HostDevice>::view_1d<T>> dst_h (host_data,size);
+    Kokkos::deep_copy(dst_h,src_d);
+  }
+  return host_data;
+}
+
 void AtmosphereOutput::
 run (const std::string& filename,
      const bool output_step, const bool checkpoint_step,
@@ -395,13 +668,72 @@ run (const std::string& filename,
     m_atm_logger->info("  file name: " + filename);
   }
 
+  // Write the data of a field, handing its host storage to scorpio if possible, or
+  // packing it (and converting its type) on device otherwise (see can_write_directly).
+  // In async mode, the data is staged in a host buffer, and the write is enqueued.
+  auto write_field = [&](const Field& f, const std::string& varname) {
+    const auto func_start = std::chrono::steady_clock::now();
+    const auto& fp_dtype = m_file_fp_dtype.at(filename);
+    const int size = f.get_header().get_identifier().get_layout().size();
+    auto do_write = [&](const auto* data) {
+      using T = std::remove_const_t<std::remove_pointer_t<decltype(data)>>;
+      if (m_async_write) {
+        auto buf = get_host_buffer(varname,size*sizeof(T));
+        auto buf_data = reinterpret_cast<T*>(buf->data.data());
+        if (data!=buf_data) {
+          std::copy(data,data+size,buf_data);
+        }
+        // If the task is skipped or fails, the promise is destroyed unset,
+        // which still makes the future ready
+        auto done = std::make_shared<std::promise<void>>();
+        buf->write_done = done->get_future();
+        scorpio::enqueue_async_task([filename,varname,buf,done](){
+          scorpio::write_var(filename,varname,reinterpret_cast<const T*>(buf->data.data()));
+          done->set_value();
+        });
+      } else {
+        scorpio::write_var(filename,varname,data);
+      }
+    };
+    const bool is_int = f.data_type()==DataType::IntType;
+    if (can_write_directly(f,fp_dtype)) {
+      f.sync_to_host();
+      if (is_int) {
+        do_write(f.get_internal_view_data<const int,Host>());
+      } else {
+        do_write(f.get_internal_view_data<const Real,Host>());
+      }
+    } else if (is_int) {
+      // A padded int field (e.g., aliased in an Instant stream) must not be written with its padding
+      do_write(pack_to_host<int,int>(f,varname));
+    } else if (fp_dtype=="float") {
+      do_write(pack_to_host<Real,float>(f,varname));
+    } else {
+      do_write(pack_to_host<Real,double>(f,varname));
+    }
+    const auto func_finish = std::chrono::steady_clock::now();
+    duration_write += std::chrono::duration_cast<std::chrono::milliseconds>(func_finish - func_start).count();
+  };
+
   // Update all diagnostics, we need to do this before applying the remapper
   // to make sure that the remapped fields are the most up to date.
   compute_diagnostics(allow_invalid_fields);
 
   auto apply_remap = [&](AbstractRemapper& remapper)
   {
+    // If a src field is the output of a diag whose global sum is pending, complete it
+    if (m_sum_batch) {
+      for (int i=0; i<remapper.get_num_fields(); ++i) {
+        if (m_sum_batch->is_pending(remapper.get_src_field(i))) {
+          m_sum_batch->wait();
+          break;
+        }
+      }
+    }
     remapper.remap_fwd();
+    if (m_coordinator) {
+      m_coordinator->mark_updated_in_step(&remapper);
+    }
 
     for (int i=0; i<remapper.get_num_fields(); ++i) {
       // Need to update the time stamp of the fields on the IO grid,
@@ -414,22 +746,89 @@ run (const std::string& filename,
     }
   }; // end apply_remap
 
+  // If the remapper output is shared with other streams, it may have already
+  // been updated during this step. We can skip the remap if it was run during
+  // this step, if all the src fields that are diags were computed during this
+  // step, and if all src fields have a valid time stamp, equal to that of the
+  // corresponding tgt field. Time stamps alone are not enough: a diag that
+  // failed to compute is filled with fill_value, but keeps its old time stamp.
+  auto is_up_to_date = [&](const AbstractRemapper& remapper) {
+    if (not m_coordinator or not m_coordinator->is_shared(remapper) or
+        not m_coordinator->updated_in_step(&remapper)) {
+      return false;
+    }
+    // A vertical remapper also depends on the source pressure, which may have been
+    // updated after the last remap even if the remapped fields were not
+    std::vector<Field> src_p;
+    if (auto vr = dynamic_cast<const VerticalRemapper*>(&remapper)) {
+      for (bool mid : {true,false}) {
+        auto p = vr->get_source_pressure(mid);
+        if (p.is_allocated()) {
+          src_p.push_back(p);
+        }
+      }
+    }
+    for (int i=0; i<remapper.get_num_fields(); ++i) {
+      const auto& src = remapper.get_src_field(i);
+      const auto& fid = src.get_header().get_identifier();
+      auto diag = m_coordinator->get_diagnostic(fid.name(),fid.get_grid_name());
+      if (diag and not m_coordinator->updated_in_step(diag.get())) {
+        return false;
+      }
+      const auto& src_t = src.get_header().get_tracking().get_time_stamp();
+      const auto& tgt_t = remapper.get_tgt_field(i).get_header().get_tracking().get_time_stamp();
+      if (not src_t.is_valid() or src_t!=tgt_t) {
+        return false;
+      }
+      for (const auto& p : src_p) {
+        const auto& p_t = p.get_header().get_tracking().get_time_stamp();
+        if (not p_t.is_valid() or not (p_t<=tgt_t)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  };
+
+  auto run_remaps = [&](const std::vector<std::shared_ptr<remapper_type>>& ext_remappers,
+                        const std::shared_ptr<remapper_type>& remapper) {
+    // Other streams' remappers first, since they were set up first
+    for (const auto& r : ext_remappers) {
+      if (not is_up_to_date(*r)) {
+        apply_remap(*r);
+      }
+    }
+    if (remapper and not is_up_to_date(*remapper)) {
+      apply_remap(*remapper);
+    }
+  };
+
   // If needed, remap fields from their grid to the unique grid, for I/O
-  if (m_vert_remapper) {
+  if (m_vert_remapper or not m_ext_vert_remappers.empty()) {
     start_timer("EAMxx::IO::vert_remap");
-    apply_remap(*m_vert_remapper);
+    run_remaps(m_ext_vert_remappers,m_vert_remapper);
     stop_timer("EAMxx::IO::vert_remap");
   }
 
-  if (m_horiz_remapper) {
+  if (m_horiz_remapper or not m_ext_horiz_remappers.empty()) {
     start_timer("EAMxx::IO::horiz_remap");
-    apply_remap(*m_horiz_remapper);
+    run_remaps(m_ext_horiz_remappers,m_horiz_remapper);
     stop_timer("EAMxx::IO::horiz_remap");
   }
 
+  // Complete the global sums of the diags, if remaps did not need them
+  if (m_sum_batch) {
+    m_sum_batch->wait();
+  }
+
   auto fm_scorpio = m_field_mgrs[Scorpio];
   auto fm_after_hr = m_field_mgrs[AfterHorizRemap];
 
+  // Accumulate all supported fields and counts at once
+  if (m_tally) {
+    m_tally->run();
+  }
+
   // If tracking avg count, update the count at each field location separately.
   // We do count++ only where the fields are NOT equal to the fill value.
   // Note, we assume that all fields that share a layout are also masked/filled in the same way.
@@ -466,27 +865,24 @@ run (const std::string& filename,
       auto field = fm_after_hr->get_field(fname);
       auto mask  = count.get_header().get_extra_data<Field>("mask");
 
-      // Find where the field is NOT equal to fill_value
-      compute_mask<Comparison::NE>(field,constants::fill_value<Real>,mask);
+      if (m_tallied_counts.count(count.name())==0) {
+        // Find where the field is NOT equal to fill_value
+        compute_mask<Comparison::NE>(field,constants::fill_value<Real>,mask);
 
-      // mask=1 for "good" entries, and mask=0 otherwise.
-      count.update(mask,1,1);
+        // mask=1 for "good" entries, and mask=0 otherwise.
+        count.update(mask,1,1);
+      }
 
       // Handle writing the average count variables to file
       if (is_write_step) {
-        // Bring data to host
-        count.sync_to_host();
-
-        auto func_start = std::chrono::steady_clock::now();
-        scorpio::write_var(filename,count.name(),count.get_internal_view_data<int,Host>());
-        auto func_finish = std::chrono::steady_clock::now();
-        auto duration_loc = std::chrono::duration_cast<std::chrono::milliseconds>(func_finish - func_start);
-        duration_write += duration_loc.count();
+        write_field(count,count.name());
 
-        // If it's an output step, for Avg we need to ensure count>threshold.
+        // If it's an output step, for Avg (and Variance) we need to ensure count>threshold.
         // If count<=threshold, we set count=fill_value, so that fill_val propagates
         // to the output fields when we divide by count later
-        if (output_step and m_avg_type==OutputAvgType::Average) {
+        // NOTE: for Variance, the Welford update below then sees count=1 at those entries,
+        //       which is harmless, since they are set to fill_value anyway.
+        if (output_step and (m_avg_type==OutputAvgType::Average or m_avg_type==OutputAvgType::Variance)) {
           int min_count = static_cast<int>(std::floor(m_avg_coeff_threshold*nsteps_since_last_output));
 
           // Recycle mask to find where count<thresh
@@ -503,6 +899,16 @@ run (const std::string& filename,
     }
   }
 
+  // The online stats kernels need contiguous inputs (see init)
+  auto get_stats_input = [&](const std::string& fname, const Field& f) {
+    auto it = m_stats_inputs.find(fname);
+    if (it==m_stats_inputs.end()) {
+      return f;
+    }
+    it->second.deep_copy(f);
+    return it->second;
+  };
+
   // Take care of updating and possibly writing fields.
   for (size_t i = 0; i < m_fields_names.size(); ++i) {
     const auto& field_name = m_fields_names[i];
@@ -512,22 +918,43 @@ run (const std::string& filename,
     const auto& f_in  = fm_after_hr->get_field(field_name);
           auto& f_out = fm_scorpio->get_field(field_name);
 
-    switch (m_avg_type) {
-      case OutputAvgType::Instant:
-        f_out.deep_copy(f_in);  break; // Note: if f_in aliases f_out, this is a no-op
-      case OutputAvgType::Max:
-        f_out.max(f_in);        break;
-      case OutputAvgType::Min:
-        f_out.min(f_in);        break;
-      case OutputAvgType::Average:
-        f_out.update(f_in,1,1); break;
-      default:
-        EKAT_ERROR_MSG ("Unexpected/unsupported averaging type.\n");
+    if (m_tallied_fields.count(field_name)==0) {
+      switch (m_avg_type) {
+        case OutputAvgType::Instant:
+          f_out.deep_copy(f_in);  break; // Note: if f_in aliases f_out, this is a no-op
+        case OutputAvgType::Max:
+          f_out.max(f_in);        break;
+        case OutputAvgType::Min:
+          f_out.min(f_in);        break;
+        case OutputAvgType::Average:
+          f_out.update(f_in,1,1); break;
+        case OutputAvgType::Variance:
+        {
+          // If not tracking the avg count, all entries have the same number of samples
+          Field count;
+          if (m_track_avg_cnt) {
+            count = m_field_to_avg_count.at(field_name);
+          }
+          update_welford(get_stats_input(field_name,f_in),count,nsteps_since_last_output,
+                         m_stats_mean.at(field_name),f_out);
+          break;
+        }
+        case OutputAvgType::Histogram:
+          update_histogram(get_stats_input(field_name,f_in),m_hist_edges_d,f_out);
+          break;
+        case OutputAvgType::Exceedance:
+          update_exceedance(get_stats_input(field_name,f_in),m_exceedance_threshold,f_out);
+          break;
+        default:
+          EKAT_ERROR_MSG ("Unexpected/unsupported averaging type.\n");
+      }
     }
 
     if (is_write_step) {
       // NOTE: we don't divide by the avg cnt for checkpoint output
-      if (output_step and m_avg_type==OutputAvgType::Average) {
+      // NOTE: for Variance, f_out is the sum of squared deviations, so dividing by
+      //       the count gives the (population) variance
+      if (output_step and (m_avg_type==OutputAvgType::Average or m_avg_type==OutputAvgType::Variance)) {
         // Even if m_track_avg_cnt=true, this field may not need it
         if (m_track_avg_cnt) {
           auto avg_count = m_field_to_avg_count.at(field_name);
@@ -536,21 +963,38 @@ run (const std::string& filename,
 
           const auto& mask = avg_count.get_header().get_extra_data<Field>("mask");
           f_out.deep_copy(constants::fill_value<Real>,mask);
+          if (m_avg_type==OutputAvgType::Variance) {
+            m_stats_mean.at(field_name).deep_copy(constants::fill_value<Real>,mask);
+          }
         } else {
           // Divide by steps count only when the summation is complete
           f_out.scale(Real(1.0) / nsteps_since_last_output);
         }
       }
 
-      // Bring data to host
-      f_out.sync_to_host();
+      // Write using alias name for netcdf variable. At output steps, quantize
+      // a copy of the data, if requested (checkpoints must be exact)
+      if (output_step and m_quantized.count(field_name)==1) {
+        auto& q = m_quantized.at(field_name);
+        q.deep_copy(f_out);
+        bitround(q,m_quantize_nsb.at(field_name));
+        write_field(q,alias_name);
+      } else {
+        write_field(f_out,alias_name);
+      }
 
-      // Write using alias name for netcdf variable
-      auto func_start = std::chrono::steady_clock::now();
-      scorpio::write_var(filename,alias_name,f_out.get_internal_view_data<Real,Host>());
-      auto func_finish = std::chrono::steady_clock::now();
-      auto duration_loc = std::chrono::duration_cast<std::chrono::milliseconds>(func_finish - func_start);
-      duration_write += duration_loc.count();
+      // The Welford mean is needed for checkpoints, and is a useful output anyways
+      if (m_avg_type==OutputAvgType::Variance) {
+        const auto& mean = m_stats_mean.at(field_name);
+        if (output_step and m_quantized_mean.count(field_name)==1) {
+          auto& qm = m_quantized_mean.at(field_name);
+          qm.deep_copy(mean);
+          bitround(qm,m_quantize_nsb.at(field_name));
+          write_field(qm,mean.name());
+        } else {
+          write_field(mean,mean.name());
+        }
+      }
     }
   }
 
@@ -592,6 +1036,13 @@ res_dep_memory_footprint () const
     }
   }
 
+  for (const auto& [fname,q] : m_quantized) {
+    rdmf += q.get_header().get_alloc_properties().get_alloc_size();
+  }
+  for (const auto& [fname,qm] : m_quantized_mean) {
+    rdmf += qm.get_header().get_alloc_properties().get_alloc_size();
+  }
+
   return rdmf;
 }
 
@@ -651,6 +1102,9 @@ reset_scorpio_fields()
     case OutputAvgType::Min:
       value =  std::numeric_limits<Real>::infinity(); break;
     case OutputAvgType::Average:
+    case OutputAvgType::Variance:
+    case OutputAvgType::Histogram:
+    case OutputAvgType::Exceedance:
       value =  0.0;                                   break;
     default:
       EKAT_ERROR_MSG ("Unrecognized/unexpected averaging type.\n");
@@ -660,6 +1114,9 @@ reset_scorpio_fields()
   for (const auto& name : m_fields_names) {
     fm->get_field(name).deep_copy(value);
   }
+  for (auto& [fname,mean] : m_stats_mean) {
+    mean.deep_copy(0);
+  }
   for (auto& count : m_avg_counts) {
     count.deep_copy(0);
   }
@@ -668,7 +1125,8 @@ reset_scorpio_fields()
 void AtmosphereOutput::
 register_variables(const std::string& filename,
                    const std::string& fp_precision,
-                   const scorpio::FileMode mode)
+                   const scorpio::FileMode mode,
+                   const bool is_restart_file)
 {
   using namespace ShortFieldTagsNames;
 
@@ -677,6 +1135,31 @@ register_variables(const std::string& filename,
       "  - input value: " + fp_precision + "\n"
       "  - supported values: float, single, double, real\n");
 
+  // All floating point vars are written with the type of the file, so that scorpio
+  // never needs to convert them (see write_field in run)
+  const auto fp_dtype = scorpio::refine_dtype(fp_precision);
+  for (auto it=m_file_fp_dtype.begin(); it!=m_file_fp_dtype.end(); ) {
+    // Forget about files that were closed in the meantime
+    it = scorpio::is_file_open(it->first) ? std::next(it) : m_file_fp_dtype.erase(it);
+  }
+  m_file_fp_dtype[filename] = fp_dtype;
+
+  // Compression is lossless, so we can use it for restart files too
+  const bool compress = m_compression_level>0 and mode!=scorpio::FileMode::Append and
+                        scorpio::supports_compression(filename);
+  if (m_compression_level>0 and mode!=scorpio::FileMode::Append and not compress) {
+    m_atm_logger->info("[EAMxx::scorpio_output] The iotype of this file does not support compression.\n"
+                       "  file name: " + filename + "\n");
+  }
+  // If the netcdf/hdf5 build lacks parallel filters, the var is written uncompressed
+  auto set_compression = [&](const std::string& varname) {
+    if (not scorpio::set_var_compression(filename, varname, m_compression_level)) {
+      m_atm_logger->warn("[EAMxx::scorpio_output] Could not set compression for a variable; it will be written uncompressed.\n"
+                         "  file name: " + filename + "\n"
+                         "  var name : " + varname + "\n");
+    }
+  };
+
   // Cycle through all fields and register using alias names.
   for (size_t i = 0; i < m_fields_names.size(); ++i) {
     const auto& field_name = m_fields_names[i];
@@ -717,12 +1200,14 @@ register_variables(const std::string& filename,
           "  - var time dep from file: " + (var.time_dep ? "yes" : "no") + "\n");
     } else {
       scorpio::define_var (filename, alias_name, units, dimnames,
-                            "real",fp_precision, m_add_time_dim);
+                            fp_dtype, fp_dtype, m_add_time_dim);
+      if (compress) {
+        set_compression(alias_name);
+      }
 
       // Add FillValue as an attribute of each variable
       // FillValue is a protected metadata, do not add it if it already existed
-      if (fp_precision=="double" or
-          (fp_precision=="real" and std::is_same<Real,double>::value)) {
+      if (fp_dtype=="double") {
         scorpio::set_attribute(filename, alias_name, "_FillValue",constants::fill_value<double>);
       } else {
         scorpio::set_attribute(filename, alias_name, "_FillValue",constants::fill_value<float>);
@@ -790,6 +1275,22 @@ register_variables(const std::string& filename,
         case OutputAvgType::Average:
           scorpio::set_attribute(filename, alias_name, "cell_methods", "time: mean");
           break;
+        case OutputAvgType::Variance:
+          scorpio::set_attribute(filename, alias_name, "cell_methods", "time: variance");
+          break;
+        case OutputAvgType::Histogram:
+        {
+          // No CF cell method for these. Document the bins instead
+          std::vector<std::string> edges;
+          for (auto e : m_hist_edges) {
+            edges.push_back(std::to_string(e));
+          }
+          scorpio::set_attribute(filename, alias_name, "histogram_bin_edges", "[" + ekat::join(edges,",") + "]");
+          break;
+        }
+        case OutputAvgType::Exceedance:
+          scorpio::set_attribute(filename, alias_name, "exceedance_threshold", static_cast<double>(m_exceedance_threshold));
+          break;
         default:
           EKAT_ERROR_MSG ("Unexpected/unsupported averaging type.\n");
       }
@@ -799,6 +1300,44 @@ register_variables(const std::string& filename,
         scorpio::set_attribute(filename, alias_name, "coordinates", "lat lon");
       }
 
+      // Document the quantization (restart files store exact values)
+      if (m_quantize_nsb.count(field_name)==1 and not is_restart_file) {
+        scorpio::set_attribute(filename, alias_name, "quantization_algorithm", "bitround");
+        scorpio::set_attribute(filename, alias_name, "quantization_nsb", m_quantize_nsb.at(field_name));
+      }
+
+    }
+  }
+
+  // Register the Welford means (if any)
+  for (const auto& [field_name,mean] : m_stats_mean) {
+    const auto& name = mean.name();
+    const auto& dimnames = m_vars_dims.at(name);
+    if (mode==scorpio::FileMode::Append) {
+      EKAT_REQUIRE_MSG (scorpio::has_var(filename,name),
+          "Error! Cannot append, due to variable missing from the file.\n"
+          "  - filename : " + filename + "\n"
+          "  - varname  : " + name + "\n");
+    } else {
+      const auto units = mean.get_header().get_identifier().get_units().to_string();
+      scorpio::define_var (filename, name, units, dimnames,
+                           fp_dtype, fp_dtype, m_add_time_dim);
+      if (compress) {
+        set_compression(name);
+      }
+      if (fp_dtype=="double") {
+        scorpio::set_attribute(filename, name, "_FillValue",constants::fill_value<double>);
+      } else {
+        scorpio::set_attribute(filename, name, "_FillValue",constants::fill_value<float>);
+      }
+      scorpio::set_attribute(filename, name, "cell_methods", "time: mean");
+      if (mean.get_header().get_identifier().get_layout().has_tag(ShortFieldTagsNames::COL)) {
+        scorpio::set_attribute(filename, name, "coordinates", "lat lon");
+      }
+      if (m_quantize_nsb.count(field_name)==1 and not is_restart_file) {
+        scorpio::set_attribute(filename, name, "quantization_algorithm", "bitround");
+        scorpio::set_attribute(filename, name, "quantization_nsb", m_quantize_nsb.at(field_name));
+      }
     }
   }
 
@@ -830,6 +1369,9 @@ register_variables(const std::string& filename,
       // variables we don't need to add all of the extra metadata.  So we simply
       // define the variable.
       scorpio::define_var(filename, name, dimnames, "int", m_add_time_dim);
+      if (compress) {
+        set_compression(name);
+      }
     }
   }
 } // register_variables
@@ -854,7 +1396,8 @@ void AtmosphereOutput::set_decompositions(const std::string& filename)
 void AtmosphereOutput::
 setup_output_file(const std::string& filename,
                   const std::string& fp_precision,
-                  const scorpio::FileMode mode)
+                  const scorpio::FileMode mode,
+                  const bool is_restart_file)
 {
   // Register dimensions with netCDF file.
   for (const auto& [dimname,dimlen] : m_dims_len) {
@@ -876,7 +1419,7 @@ setup_output_file(const std::string& filename,
   }
 
   // Register variables with netCDF file.  Must come after dimensions are registered.
-  register_variables(filename,fp_precision,mode);
+  register_variables(filename,fp_precision,mode,is_restart_file);
 
   // Set the offsets of the local dofs in the global vector.
   set_decompositions(filename);
@@ -886,6 +1429,21 @@ void AtmosphereOutput::
 compute_diagnostics(const bool allow_invalid_fields)
 {
   for (auto diag : m_diagnostics) {
+    if (m_coordinator and m_coordinator->updated_in_step(diag.get())) {
+      // Another stream already computed this diag during this step
+      continue;
+    }
+
+    // If an input is the output of a diag whose global sum is pending, complete it
+    if (m_sum_batch) {
+      for (const auto& f : diag->get_fields_in()) {
+        if (m_sum_batch->is_pending(f)) {
+          m_sum_batch->wait();
+          break;
+        }
+      }
+    }
+
     // Check if all inputs are valid
     bool computable = true;
     bool computed = false;
@@ -907,6 +1465,7 @@ compute_diagnostics(const bool allow_invalid_fields)
     auto d = diag->get_diagnostic();
     if (computable) {
       computed = true;
+      diag->set_sum_batch(m_sum_batch);
       diag->compute_diagnostic();
       if (not d.get_header().get_tracking().get_time_stamp().is_valid()) {
         computed = false;
@@ -921,8 +1480,17 @@ compute_diagnostics(const bool allow_invalid_fields)
         "Error! Failed to compute diagnostic.\n"
         " - diag name: " + diag->get_diagnostic().name() + "\n");
       d.deep_copy(constants::fill_value<float>);
+    } else if (m_coordinator) {
+      // Only a successful compute can be reused by other streams
+      m_coordinator->mark_updated_in_step(diag.get());
     }
   }
+
+  // Launch the global sums of all diags at once. They are completed in run,
+  // so that they can overlap with the remaps that do not involve them.
+  if (m_sum_batch) {
+    m_sum_batch->start();
+  }
 }
 
 void AtmosphereOutput::
@@ -939,32 +1507,47 @@ init_diagnostics ()
   //       inside a std::function, so that the lambda body CAN call create_diag.
   std::function<void(const std::string&)> create_diag;
   create_diag = [&](const std::string& name) {
-    // Create the diag
-    auto diag = create_diagnostic(name,fm_model->get_grid());
+    // If another stream already created this diag, simply reuse it
+    auto diag = m_coordinator ? m_coordinator->get_diagnostic(name,fm_grid->name()) : nullptr;
+    if (diag) {
+      // Still add the deps diags, so that they are computed before this one
+      for (const auto& f : diag->get_fields_in()) {
+        if (not fm_model->has_field(f.name())) {
+          create_diag(f.name());
+        }
+      }
+    } else {
+      // Create the diag
+      diag = create_diagnostic(name,fm_model->get_grid());
 
-    // Set inputs in the diag (and recurse if inputs are also diags not yet created)
-    for (const auto& freq : diag->get_required_field_requests()) {
-      const auto& dep_name = freq.fid.name();
+      // Set inputs in the diag (and recurse if inputs are also diags not yet created)
+      for (const auto& freq : diag->get_required_field_requests()) {
+        const auto& dep_name = freq.fid.name();
+
+        if (not fm_model->has_field(dep_name)) {
+          // Not a field from the model, nor another diag we already created
+          create_diag(dep_name);
+        }
 
-      if (not fm_model->has_field(dep_name)) {
-        // Not a field from the model, nor another diag we already created
-        create_diag(dep_name);
+        auto dep = fm_model->get_field(dep_name);
+        diag->set_required_field(dep);
       }
 
-      auto dep = fm_model->get_field(dep_name);
-      diag->set_required_field(dep);
-    }
+      // Initialize the diag
+      diag->initialize(util::TimeStamp(),RunType::Initial);
 
-    // Initialize the diag
-    diag->initialize(util::TimeStamp(),RunType::Initial);
+      // Add the field to the diag group
+      diag->get_diagnostic().get_header().get_tracking().add_group("diagnostic");
+
+      if (m_coordinator) {
+        m_coordinator->add_diagnostic(name,fm_grid->name(),diag);
+      }
+    }
 
     // Set the diag field in the FM
     auto diag_field = diag->get_diagnostic();
     fm_model->add_field(diag_field);
 
-    // Add the field to the diag group
-    diag_field.get_header().get_tracking().add_group("diagnostic");
-
     // Some diags need some extra setup or trigger extra behaviors
     std::string diag_avg_cnt_name = "";
     auto& params = diag->get_params();
@@ -1009,6 +1592,57 @@ init_diagnostics ()
   }
 }
 
+std::shared_ptr<FieldManager> AtmosphereOutput::
+setup_remap (const std::string& remap_key,
+             const std::shared_ptr<fm_type>& fm_src,
+             const std::function<std::shared_ptr<remapper_type>()>& create_remapper,
+             std::shared_ptr<remapper_type>& remapper,
+             std::vector<std::shared_ptr<remapper_type>>& ext_remappers)
+{
+  const auto& src_grid_name = fm_src->get_grid()->name();
+
+  // If another stream already remaps a field with the same remap, we reuse
+  // its remapped field, and remember that we need to run its remapper.
+  // All other fields are registered in our own remapper.
+  std::vector<Field> tgt_fields;
+  for (const auto& fname : m_fields_names) {
+    if (m_coordinator and m_coordinator->has_remapped_field(remap_key,fname)) {
+      tgt_fields.push_back(m_coordinator->get_remapped_field(remap_key,fname));
+      const auto& r = m_coordinator->get_remapper(remap_key,fname);
+      if (not ekat::contains(ext_remappers,r)) {
+        ext_remappers.push_back(r);
+      }
+      continue;
+    }
+
+    if (remapper==nullptr) {
+      remapper = create_remapper();
+    }
+    auto src = fm_src->get_field(fname,src_grid_name);
+    auto tgt = remapper->register_field_from_src(src);
+    transfer_extra_data (src,tgt);
+    tgt_fields.push_back(tgt);
+    if (m_coordinator) {
+      m_coordinator->add_remapped_field(remap_key,fname,tgt,remapper);
+    }
+  }
+
+  // If there are no fields, we still create the remapper, to get the tgt grid
+  if (remapper==nullptr and ext_remappers.empty()) {
+    remapper = create_remapper();
+  }
+  if (remapper) {
+    remapper->registration_ends();
+  }
+
+  auto tgt_grid = remapper ? remapper->get_tgt_grid() : ext_remappers.front()->get_tgt_grid();
+  auto fm_tgt = std::make_shared<FieldManager>(tgt_grid,RepoState::Closed);
+  for (const auto& f : tgt_fields) {
+    fm_tgt->add_field(f);
+  }
+  return fm_tgt;
+}
+
 std::vector<std::string> AtmosphereOutput::
 get_var_dimnames (const FieldLayout& layout) const
 {
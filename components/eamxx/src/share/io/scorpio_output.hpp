@@ -3,7 +3,9 @@
 
 #include "share/io/eamxx_scorpio_interface.hpp"
 #include "share/io/eamxx_io_utils.hpp"
+#include "share/io/eamxx_output_coordinator.hpp"
 #include "share/field/field_manager.hpp"
+#include "share/field/field_tally.hpp"
 #include "share/grid/abstract_grid.hpp"
 #include "share/grid/grids_manager.hpp"
 #include "share/util/eamxx_time_stamp.hpp"
@@ -13,6 +15,10 @@
 #include <ekat_parameter_list.hpp>
 #include <ekat_comm.hpp>
 
+#include <functional>
+#include <future>
+#include <set>
+
 /*  The AtmosphereOutput class handles an output stream in SCREAM.
  *  Typical usage is to register an AtmosphereOutput object with the OutputManager (see eamxx_output_manager.hpp
  *
@@ -30,6 +36,13 @@
  *  filename_prefix:                    STRING
  *  averaging_type:                     STRING
  *  max_snapshots_per_file:             INT                   (default: 1)
+ *  async_write:                        BOOL                  (default: false)
+ *  histogram_bin_edges:                ARRAY OF REALS        (required if averaging_type=histogram)
+ *  exceedance_threshold:               REAL                  (required if averaging_type=exceedance)
+ *  significant_digits:                 INT                   (default: 0)
+ *  significant_digits_per_field:
+ *     VAR_NAME:                        INT                   (default: ${significant_digits})
+ *  compression_level:                  INT                   (default: 0)
  *  fields:
  *     GRID_NAME_1:
  *        field_names:                  ARRAY OF STRINGS
@@ -55,6 +68,11 @@
  *      average - average of the field over some interval.
  *      min     - minimum value of the field over time interval.
  *      max     - maximum value of the field over time interval.
+ *      variance   - (population) variance of the field over the time interval. The mean
+ *                   is also saved, in the variable ${field_name}_mean.
+ *      histogram  - number of samples of the field in each bin over the time interval,
+ *                   along an extra "bin" dimension (see histogram_bin_edges).
+ *      exceedance - number of samples of the field above exceedance_threshold over the time interval.
  *    Here, 'time interval' is described by ${Output frequency} and ${Output frequency_units}.
  *    E.g., with 'Output frequency'=10 and 'Output frequency_units'="Days", the time interval is 10 days.
  *  - fields: parameters specifying fields to output
@@ -64,6 +82,18 @@
  *                        SEGrid fields to PointGrid fields on the fly, to save on output size)
  *  - max_snapshots_per_file: the maximum number of snapshots saved per file. After this many
  *    snapshots, the current files is closed and a new file created.
+ *  - async_write: if true, at write steps the output data is copied in a host staging buffer,
+ *    and the scorpio calls are executed by a background thread, so that run returns right away.
+ *  - histogram_bin_edges: the (increasing) edges of the histogram bins. The k-th bin is [edge_k,edge_k+1),
+ *    and samples outside of [edge_0,edge_N) are not counted.
+ *  - exceedance_threshold: the threshold for the exceedance counts.
+ *  - significant_digits: if positive, at output steps vars are quantized (on device, via BitRound) keeping
+ *    only the mantissa bits needed for this many significant decimal digits. The trailing bits are zeroed,
+ *    which makes the data much more compressible. Checkpoint (rhist) data is never quantized.
+ *  - significant_digits_per_field: overrides significant_digits for some vars (use 0 to disable quantization).
+ *    The keys are the var names in the output file (i.e., aliases, if used).
+ *  - compression_level: the deflate level (1-9) of all vars, or 0 for no compression. Ignored if the
+ *    iotype of the file does not support compression (only netcdf4c/netcdf4p do).
  *  - Output: parameters for output control
  *    - frequency: the frequency of output writes (in the units specified by ${Output frequency_units})
  *    - frequency_units: the units of output frequency (nsteps, nmonths, nyears, nhours, ndays,...)
@@ -117,9 +147,12 @@ public:
   virtual ~AtmosphereOutput () = default;
 
   // Constructor
+  // If a coordinator is passed, diagnostics and remapped fields are shared with
+  // all the other streams using the same coordinator (see eamxx_output_coordinator.hpp)
   AtmosphereOutput(const ekat::Comm& comm, const ekat::ParameterList& params,
                    const std::shared_ptr<const fm_type>& field_mgr,
-                   const std::string& grid_name);
+                   const std::string& grid_name,
+                   const std::shared_ptr<OutputCoordinator>& coordinator = nullptr);
 
   // Short version for outputing a list of fields (no remapping supported)
   AtmosphereOutput(const ekat::Comm& comm,
@@ -130,7 +163,10 @@ public:
   void restart (const std::string& filename);
   void init();
   void reset_scorpio_fields();
-  void setup_output_file (const std::string& filename, const std::string& fp_precision, const scorpio::FileMode mode);
+  void setup_tally();
+  bool has_online_stats () const;
+  void setup_output_file (const std::string& filename, const std::string& fp_precision, const scorpio::FileMode mode,
+                          const bool is_restart_file = false);
 
   void init_timestep (const util::TimeStamp& start_of_step);
   void run (const std::string& filename,
@@ -144,6 +180,11 @@ public:
     return m_io_grid;
   }
 
+  // The names of the output vars (i.e., the field names, or their aliases)
+  const std::vector<std::string>& get_var_names () const {
+    return m_alias_names;
+  }
+
   void set_logger(const std::shared_ptr<ekat::logger::LoggerBase>& atm_logger);
 
 protected:
@@ -154,15 +195,34 @@ protected:
   using strvec_t = std::vector<std::string>;
 
   // Internal functions
-  void register_variables(const std::string& filename, const std::string& fp_precision, const scorpio::FileMode mode);
+  void register_variables(const std::string& filename, const std::string& fp_precision, const scorpio::FileMode mode,
+                          const bool is_restart_file);
   void set_decompositions(const std::string& filename);
   void compute_diagnostics (const bool allow_invalid_fields);
   void init_diagnostics ();
+  std::shared_ptr<fm_type>
+  setup_remap (const std::string& remap_key,
+               const std::shared_ptr<fm_type>& fm_src,
+               const std::function<std::shared_ptr<remapper_type>()>& create_remapper,
+               std::shared_ptr<remapper_type>& remapper,
+               std::vector<std::shared_ptr<remapper_type>>& ext_remappers);
   strvec_t get_var_dimnames (const FieldLayout& layout) const;
 
   // Tracking the averaging of any filled values:
   void set_avg_cnt_tracking(const std::string& name, const FieldLayout& layout);
 
+  // Write helpers: if the field storage cannot be written directly, it is packed on device
+  // in a contiguous array of the file type, which is copied to a host buffer in one shot
+  // In async mode, write_done becomes ready once the pending write of the buffer data is done.
+  struct HostBuffer {
+    std::vector<char>  data;
+    std::future<void>  write_done;
+  };
+  static bool can_write_directly (const Field& f, const std::string& fp_dtype);
+  std::shared_ptr<HostBuffer> get_host_buffer (const std::string& varname, const size_t nbytes);
+  template<typename ST, typename T>
+  const T* pack_to_host (const Field& f, const std::string& varname);
+
   // --- Internal variables --- //
   ekat::Comm                          m_comm;
 
@@ -176,14 +236,15 @@ protected:
   //         VERT_REMAP        HORIZ_REMAP       TALLY_UPDATE
   //  FromModel -> AfterVertRemap -> AfterHorizRemap -> Scorpio
   // The last 2 field mgrs contain DIFFERENT fields if 1+ of the following happens:
-  //  - fields are padded: we have PackSize>1 during remaps, but Scorpio needs CONTIGUOUS memory
-  //  - there's no remap (so the first 3 FM are the same), but the field is a subfield: again NOT CONTIGUOUS
+  //  - there's no remap (so the first 3 FM are the same), but the field is a subfield: NOT CONTIGUOUS
   //  - the avg type is NOT instant: we need a separate Field to store the tallies
+  // Padded fields (PackSize>1 during remaps) are instead packed in a contiguous buffer at write time,
+  // together with the conversion to the file fp type, so that we only copy data once.
   // Also, FromModel is NOT the same field mgr as stored in the AD. In particular, it is a "clone" of the AD field mgr
   // but restricted to the grid that this object is handling, AND we stuff all diags in this field mgr (so that we
   // do not pollute the AD field mgr with output-only fields).
   // NOTE: if avg_type!=Instant, then ALL fields in the last two field mgrs are different, otherwise SOME field
-  //       MAY be the same. E.g., field that are NOT subfields and are NOT padded can be "soft copies", to reduce
+  //       MAY be the same. E.g., fields that are NOT subfields can be "soft copies", to reduce
   //       memory footprint and runtime costs.
   enum Phase {
     FromModel,        // Output fields as from the model (or diags computed from model fields)
@@ -197,6 +258,13 @@ protected:
   std::shared_ptr<remapper_type>        m_horiz_remapper;
   std::shared_ptr<remapper_type>        m_vert_remapper;
 
+  // Remappers of other streams, whose output is (partly) used by this stream
+  std::vector<std::shared_ptr<remapper_type>> m_ext_horiz_remappers;
+  std::vector<std::shared_ptr<remapper_type>> m_ext_vert_remappers;
+
+  // If present, used to share diags/remaps with other output streams
+  std::shared_ptr<OutputCoordinator>    m_coordinator;
+
   // How to combine multiple snapshots in the output: instant, Max, Min, Average
   OutputAvgType                         m_avg_type;
   Real                                  m_avg_coeff_threshold = 0.5; // % of unfilled values required to not just assign value as FillValue
@@ -209,6 +277,28 @@ protected:
   strmap_t<strvec_t>                    m_vars_dims;
   strmap_t<int>                         m_dims_len;
   std::list<diag_ptr_type>              m_diagnostics;
+  std::shared_ptr<FieldSumBatch>        m_sum_batch;
+
+  // For non-instant output, accumulates (in one kernel) all fields and avg counts that
+  // it supports. The others are accumulated separately, one by one.
+  std::shared_ptr<FieldTally>           m_tally;
+  std::set<std::string>                 m_tallied_fields;
+  std::set<std::string>                 m_tallied_counts;
+
+  // For variance, histogram, and exceedance output (see field_online_stats.hpp)
+  strmap_t<Field>                       m_stats_mean;    // Welford mean (variance output only)
+  strmap_t<Field>                       m_stats_inputs;  // Contiguous copies of input subfields
+  std::vector<Real>                     m_hist_edges;
+  KokkosTypes<DefaultDevice>::view_1d<Real> m_hist_edges_d;
+  Real                                  m_exceedance_threshold;
+
+  // Lossy quantization of the output vars (see field_quantize.hpp) and compression
+  int                                   m_significant_digits = 0;
+  strmap_t<int>                         m_significant_digits_per_var;
+  strmap_t<int>                         m_quantize_nsb;  // Num of significant bits kept for each field
+  strmap_t<Field>                       m_quantized;     // Scratch copies where we quantize the output
+  strmap_t<Field>                       m_quantized_mean;// Same as above, for the Welford means
+  int                                   m_compression_level = 0;
 
   // Field aliasing support
   strmap_t<std::string>                 m_alias_to_field_map;  // Map from alias names to internal field names
@@ -218,6 +308,19 @@ protected:
 
   bool m_add_time_dim;
   bool m_track_avg_cnt = false;
+
+  // If true, write_var calls are executed asynchronously, on copies of the data.
+  bool m_async_write = false;
+
+  // Host buffers for the data of vars that are packed (or staged, in async mode) before
+  // being written, and device buffers for packing (if device memory is not host-accessible).
+  // They are stored, so we can reuse them at the next write.
+  strmap_t<std::shared_ptr<HostBuffer>>               m_host_buffers;
+  strmap_t<KokkosTypes<DefaultDevice>::view_1d<char>> m_pack_buffers;
+
+  // The floating point type of the vars in each open file we write to
+  strmap_t<std::string>                 m_file_fp_dtype;
+
   std::string m_decomp_dimname = "";
 
   std::shared_ptr<ekat::logger::LoggerBase> m_atm_logger = console_logger(ekat::logger::LogLevel::warn);
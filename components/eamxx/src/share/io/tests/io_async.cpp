@@ -0,0 +1,126 @@
+#define CATCH_CONFIG_RUNNER
+#include <catch2/catch.hpp>
+
+#include "share/io/eamxx_scorpio_interface.hpp"
+#include "share/eamxx_session.hpp"
+
+#include <ekat_comm.hpp>
+
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace scream {
+
+using namespace scorpio;
+
+TEST_CASE ("async_write") {
+  ekat::Comm comm (MPI_COMM_WORLD);
+
+  // See main below: tasks run on the worker thread only with MPI_THREAD_MULTIPLE
+  int provided;
+  MPI_Query_thread(&provided);
+  REQUIRE (async_tasks_supported()==(provided==MPI_THREAD_MULTIPLE));
+  if (not async_tasks_supported()) {
+    WARN ("MPI does not support MPI_THREAD_MULTIPLE. Async tasks are run synchronously.");
+  }
+
+  init_subsystem (comm);
+
+  const std::string filename = "io_async_np" + std::to_string(comm.size()) + ".nc";
+  const int ldim = 3;
+  const int dim  = ldim * comm.size();
+  const int nslices = 5;
+
+  std::vector<offset_t> my_offsets (ldim);
+  std::iota (my_offsets.begin(),my_offsets.end(),ldim*comm.rank());
+
+  auto slice_data = [&](const int n) {
+    std::vector<double> data (ldim);
+    std::iota (data.begin(),data.end(),100*n + ldim*comm.rank());
+    return data;
+  };
+
+  // Write phase: all time slices are written by async tasks
+  {
+    register_file (filename,Write);
+    define_dim (filename,"dim",dim);
+    define_time (filename,"days");
+    define_var (filename,"var",{"dim"},"double",true);
+    set_dim_decomp (filename,"dim",my_offsets);
+    enddef (filename);
+
+    // Only accessed by the tasks, until we wait for them
+    std::vector<int> order;
+    std::vector<std::thread::id> ids;
+    for (int n=0; n<nslices; ++n) {
+      auto data = slice_data(n);
+      enqueue_async_task([filename,n,data,&order,&ids](){
+        update_time (filename,n);
+        write_var (filename,"var",data.data());
+        order.push_back(n);
+        ids.push_back(std::this_thread::get_id());
+      });
+    }
+
+    // Interface calls from the main thread wait for all pending tasks
+    REQUIRE (get_time_len(filename)==nslices);
+
+    std::vector<int> tgt_order (nslices);
+    std::iota (tgt_order.begin(),tgt_order.end(),0);
+    REQUIRE (order==tgt_order);
+    for (const auto& id : ids) {
+      REQUIRE ((id!=std::this_thread::get_id())==async_tasks_supported());
+    }
+
+    // An error in a task is rethrown (once) when waiting, and the tasks enqueued
+    // after the failed one are skipped
+    bool skipped = true;
+    auto bad_task = [](){ throw std::runtime_error("bad task"); };
+    if (async_tasks_supported()) {
+      enqueue_async_task(bad_task);
+      enqueue_async_task([&skipped](){ skipped = false; });
+      REQUIRE_THROWS (wait_async_tasks());
+      REQUIRE (skipped);
+    } else {
+      REQUIRE_THROWS (enqueue_async_task(bad_task));
+    }
+    wait_async_tasks();
+
+    release_file (filename);
+  }
+
+  // Read phase: check that the slices were written in order
+  {
+    register_file (filename,Read);
+    set_dim_decomp (filename,"dim",my_offsets);
+    REQUIRE (get_time_len(filename)==nslices);
+
+    std::vector<double> data (ldim);
+    for (int n=0; n<nslices; ++n) {
+      REQUIRE (get_time(filename,n)==n);
+      read_var (filename,"var",data.data(),n);
+      REQUIRE (data==slice_data(n));
+    }
+    release_file (filename);
+  }
+
+  finalize_subsystem ();
+}
+
+} // namespace scream
+
+// The default test main initializes MPI without thread support, which makes
+// async tasks run synchronously. Here we request MPI_THREAD_MULTIPLE instead.
+int main (int argc, char** argv) {
+  int provided;
+  MPI_Init_thread(&argc,&argv,MPI_THREAD_MULTIPLE,&provided);
+  scream::initialize_eamxx_session(argc,argv);
+
+  const int ret = Catch::Session().run(argc,argv);
+
+  scream::finalize_eamxx_session();
+  MPI_Finalize();
+  return ret;
+}
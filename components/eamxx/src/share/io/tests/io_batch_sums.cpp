@@ -0,0 +1,180 @@
+#include <catch2/catch.hpp>
+
+#include "diagnostics/register_diagnostics.hpp"
+
+#include "share/io/eamxx_output_manager.hpp"
+#include "share/io/eamxx_scorpio_interface.hpp"
+
+#include "share/grid/mesh_free_grids_manager.hpp"
+
+#include "share/field/field_utils.hpp"
+#include "share/field/field.hpp"
+#include "share/field/field_manager.hpp"
+
+#include "share/util/eamxx_setup_random_test.hpp"
+#include "share/util/eamxx_time_stamp.hpp"
+#include "share/eamxx_types.hpp"
+
+#include <ekat_units.hpp>
+#include <ekat_parameter_list.hpp>
+#include <ekat_comm.hpp>
+
+#include <memory>
+
+namespace scream {
+
+constexpr int num_output_steps = 3;
+constexpr int nlevs = 4;
+
+util::TimeStamp get_t0 () {
+  return util::TimeStamp({2023,2,17},{0,0,0});
+}
+
+std::shared_ptr<const GridsManager>
+get_gm (const ekat::Comm& comm)
+{
+  const int nlcols = 3;
+  const int ngcols = nlcols*comm.size();
+  auto gm = create_mesh_free_grids_manager(comm,0,0,nlevs,ngcols);
+  gm->build_grids();
+  return gm;
+}
+
+std::shared_ptr<FieldManager>
+get_fm (const std::shared_ptr<const AbstractGrid>& grid,
+        const util::TimeStamp& t0)
+{
+  using FL  = FieldLayout;
+  using FID = FieldIdentifier;
+  using namespace ShortFieldTagsNames;
+
+  const int nlcols = grid->get_num_local_dofs();
+
+  std::vector<FL> layouts =
+  {
+    FL({COL    }, {nlcols      }),
+    FL({COL,LEV}, {nlcols,nlevs})
+  };
+
+  auto fm = std::make_shared<FieldManager>(grid);
+
+  const auto units = ekat::units::Units::nondimensional();
+  for (const auto& fl : layouts) {
+    FID fid("f_"+std::to_string(fl.rank()),fl,units,grid->name());
+    Field f(fid);
+    f.allocate_view();
+    f.get_header().get_tracking().update_time_stamp(t0);
+    fm->add_field(f);
+  }
+
+  return fm;
+}
+
+std::string get_filename (const std::string& prefix, const ekat::Comm& comm)
+{
+  return prefix + ".INSTANT.nsteps_x1"
+       + ".np" + std::to_string(comm.size())
+       + "." + get_t0().to_string()
+       + ".nc";
+}
+
+// Write the horiz avg of the fields, with and without batching the global sums
+void write (const int seed, const ekat::Comm& comm)
+{
+  auto gm = get_gm(comm);
+  auto grid = gm->get_grid("point_grid");
+  auto t0 = get_t0();
+
+  auto fm = get_fm(grid,t0);
+  std::vector<std::string> diags;
+  for (auto it : fm->get_repo()) {
+    diags.push_back(it.second->name() + "_horiz_avg");
+  }
+
+  std::vector<std::shared_ptr<OutputManager>> oms;
+  for (const bool batch : {false, true}) {
+    ekat::ParameterList om_pl;
+    om_pl.set("filename_prefix",std::string(batch ? "io_batch_sums" : "io_no_batch_sums"));
+    om_pl.set("field_names",diags);
+    om_pl.set("averaging_type",std::string("INSTANT"));
+    om_pl.set("floating_point_precision",std::string("real"));
+    om_pl.set("max_snapshots_per_file",num_output_steps+1);
+    om_pl.set("batch_global_sums",batch);
+    auto& ctrl_pl = om_pl.sublist("output_control");
+    ctrl_pl.set("frequency_units",std::string("nsteps"));
+    ctrl_pl.set("frequency",1);
+    ctrl_pl.set("save_grid_data",false);
+
+    auto om = std::make_shared<OutputManager>();
+    om->initialize(comm,om_pl,t0,false);
+    om->setup(fm,gm->get_grid_names());
+    oms.push_back(om);
+  }
+
+  // Use different values on each rank, so the sums are not trivial
+  std::mt19937_64 engine(seed+comm.rank());
+  std::uniform_real_distribution<Real> pdf (-100,100);
+
+  const int dt = 1;
+  auto t = t0;
+  for (int n=0; n<num_output_steps; ++n) {
+    for (auto& om : oms) {
+      om->init_timestep(t,dt);
+    }
+    t += dt;
+    for (auto it : fm->get_repo()) {
+      randomize(*it.second,engine,pdf);
+    }
+    for (auto& om : oms) {
+      om->run(t);
+    }
+  }
+
+  for (auto& om : oms) {
+    om->finalize();
+  }
+}
+
+void read (const ekat::Comm& comm)
+{
+  // MPI may use a different reduction algorithm for the packed buffer than
+  // for the single fields, so the results need not be bit-for-bit
+  const auto tol = std::numeric_limits<Real>::epsilon() * 100;
+
+  const auto ref_file   = get_filename("io_no_batch_sums",comm);
+  const auto batch_file = get_filename("io_batch_sums",comm);
+  scorpio::register_file(ref_file,scorpio::Read);
+  scorpio::register_file(batch_file,scorpio::Read);
+  REQUIRE (scorpio::get_time_len(batch_file)==num_output_steps+1);
+
+  for (const auto& [name,size] : {std::make_pair("f_1_horiz_avg",1),
+                                  std::make_pair("f_2_horiz_avg",nlevs)}) {
+    std::vector<Real> ref(size), batch(size);
+    for (int n=0; n<=num_output_steps; ++n) {
+      scorpio::read_var(ref_file,name,ref.data(),n);
+      scorpio::read_var(batch_file,name,batch.data(),n);
+      for (int i=0; i<size; ++i) {
+        REQUIRE_THAT(batch[i], Catch::Matchers::WithinRel(ref[i], tol));
+      }
+    }
+  }
+
+  scorpio::release_file(ref_file);
+  scorpio::release_file(batch_file);
+}
+
+TEST_CASE ("io_batch_sums") {
+  ekat::Comm comm(MPI_COMM_WORLD);
+  scorpio::init_subsystem(comm);
+
+  register_diagnostics();
+
+  auto seed = get_random_test_seed(&comm);
+
+  write(seed,comm);
+  read(comm);
+
+  scorpio::finalize_subsystem();
+}
+
+} // namespace scream
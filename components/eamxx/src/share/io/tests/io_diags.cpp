@@ -20,8 +20,11 @@
 #include <ekat_assert.hpp>
 #include <ekat_comm.hpp>
 
+#include <algorithm>
 #include <iomanip>
+#include <list>
 #include <memory>
+#include <numeric>
 
 namespace scream {
 
@@ -36,6 +39,9 @@ public:
 
   std::string name() const override { return "MyDiag"; }
 
+  // Number of calls to compute_diagnostic_impl, across all instances
+  static int num_computes;
+
   void set_grids (const std::shared_ptr<const GridsManager> gm) override {
     using namespace ekat::units;
     using namespace ShortFieldTagsNames;
@@ -70,6 +76,7 @@ public:
 protected:
 
   void compute_diagnostic_impl () override {
+    ++num_computes;
     const auto& f_in  = get_field_in(m_f_in);
 
     const auto& t = f_in.get_header().get_tracking().get_time_stamp();
@@ -95,6 +102,8 @@ protected:
   Field m_one;
 };
 
+int MyDiag::num_computes = 0;
+
 util::TimeStamp get_t0 () {
   return util::TimeStamp({2023,2,17},{0,0,0});
 }
@@ -164,7 +173,8 @@ get_fm (const std::shared_ptr<const AbstractGrid>& grid,
 }
 
 // Returns fields after initialization
-void write (const int seed, const ekat::Comm& comm)
+// If shared=true, two output managers sharing diags (via an OutputCoordinator) are used
+void write (const int seed, const ekat::Comm& comm, const bool shared)
 {
   // Create grid
   auto gm = get_gm(comm);
@@ -184,19 +194,35 @@ void write (const int seed, const ekat::Comm& comm)
   fnames.push_back("MyDiag");
 
   // Create output params
-  ekat::ParameterList om_pl;
-  om_pl.set("filename_prefix",std::string("io_diags"));
-  om_pl.set("field_names",fnames);
-  om_pl.set("averaging_type", std::string("instant"));
-  auto& ctrl_pl = om_pl.sublist("output_control");
-  ctrl_pl.set("frequency_units",std::string("nsteps"));
-  ctrl_pl.set("frequency",1);
-  ctrl_pl.set("save_grid_data",false);
-
-  // Create Output manager
-  OutputManager om;
-  om.initialize(comm, om_pl, t0, false);
-  om.setup(fm,gm->get_grid_names());
+  auto get_om_pl = [&](const std::string& prefix) {
+    ekat::ParameterList om_pl;
+    om_pl.set("filename_prefix",prefix);
+    om_pl.set("field_names",fnames);
+    om_pl.set("averaging_type", std::string("instant"));
+    auto& ctrl_pl = om_pl.sublist("output_control");
+    ctrl_pl.set("frequency_units",std::string("nsteps"));
+    ctrl_pl.set("frequency",1);
+    ctrl_pl.set("save_grid_data",false);
+    return om_pl;
+  };
+
+  // Create Output manager(s)
+  std::vector<std::string> prefixes;
+  if (shared) {
+    prefixes = {"io_diags_shared_a","io_diags_shared_b"};
+  } else {
+    prefixes = {"io_diags"};
+  }
+  auto coordinator = shared ? std::make_shared<OutputCoordinator>() : nullptr;
+  std::list<OutputManager> oms;
+  for (const auto& prefix : prefixes) {
+    auto& om = oms.emplace_back();
+    om.initialize(comm, get_om_pl(prefix), t0, false);
+    if (shared) {
+      om.set_output_coordinator(coordinator);
+    }
+    om.setup(fm,gm->get_grid_names());
+  }
 
   // Run output manager
   for (auto it : fm->get_repo()) {
@@ -206,14 +232,144 @@ void write (const int seed, const ekat::Comm& comm)
     f.get_header().get_tracking().update_time_stamp(t0+dt);
     f.update(one,1.0,1.0);
   }
-  om.init_timestep(t0,dt);
-  om.run (t0+dt);
+  for (auto& om : oms) {
+    om.init_timestep(t0,dt);
+  }
+  for (auto& om : oms) {
+    om.run (t0+dt);
+  }
+  if (shared) {
+    coordinator->end_step();
+  }
+
+  // Close file and cleanup
+  for (auto& om : oms) {
+    om.finalize();
+  }
+}
+
+// Two streams, with different frequencies, output MyDiag remapped with the same map.
+// MyDiag must be computed once per step, and the remap done by the first stream
+// must be reused by the second one.
+void write_shared_remap (const int seed, const ekat::Comm& comm)
+{
+  // Create grid
+  auto gm = get_gm(comm);
+  auto grid = gm->get_grid("point_grid");
+  const int nlcols = grid->get_num_local_dofs();
+  const int ngcols = grid->get_num_global_dofs();
+
+  // Create an identity map file
+  const std::string map_file = "io_diags_map_np" + std::to_string(comm.size()) + ".nc";
+  scorpio::register_file(map_file,scorpio::FileMode::Write);
+  scorpio::define_dim(map_file,"n_a",ngcols);
+  scorpio::define_dim(map_file,"n_b",ngcols);
+  scorpio::define_dim(map_file,"n_s",ngcols);
+  scorpio::define_var(map_file,"col",{"n_s"},"int");
+  scorpio::define_var(map_file,"row",{"n_s"},"int");
+  scorpio::define_var(map_file,"S",  {"n_s"},"real");
+  scorpio::set_dim_decomp(map_file,"n_s",comm.rank()*nlcols,nlcols);
+  scorpio::enddef(map_file);
+  std::vector<int> idx (nlcols);
+  std::iota(idx.begin(),idx.end(),comm.rank()*nlcols);
+  std::vector<Real> S (nlcols,1.0);
+  scorpio::write_var(map_file,"row",idx.data());
+  scorpio::write_var(map_file,"col",idx.data());
+  scorpio::write_var(map_file,"S",  S.data());
+  scorpio::release_file(map_file);
+
+  // Time advance parameters
+  auto t0 = get_t0();
+  auto dt = get_dt();
+
+  // Create some fields
+  auto fm = get_fm(grid,t0,seed);
+  std::vector<std::string> fnames;
+  for (auto it : fm->get_repo()) {
+    fnames.push_back(it.second->name());
+  }
+  fnames.push_back("MyDiag");
+
+  // Create output managers, with the same coordinator
+  auto coordinator = std::make_shared<OutputCoordinator>();
+  std::list<OutputManager> oms;
+  for (const auto& [prefix,freq] : {std::make_pair("io_diags_remap_a",1),
+                                    std::make_pair("io_diags_remap_b",2)}) {
+    ekat::ParameterList om_pl;
+    om_pl.set("filename_prefix",std::string(prefix));
+    om_pl.set("field_names",fnames);
+    om_pl.set("averaging_type", std::string("instant"));
+    om_pl.set("horiz_remap_file",map_file);
+    auto& ctrl_pl = om_pl.sublist("output_control");
+    ctrl_pl.set("frequency_units",std::string("nsteps"));
+    ctrl_pl.set("frequency",freq);
+    ctrl_pl.set("save_grid_data",false);
+
+    auto& om = oms.emplace_back();
+    om.initialize(comm, om_pl, t0, false);
+    om.set_output_coordinator(coordinator);
+    om.setup(fm,gm->get_grid_names());
+  }
+  auto& om_a = oms.front();
+  auto& om_b = oms.back();
+
+  // MyDiag is registered in the remapper of the first stream, and the second one reuses it
+  const std::string remap_key = grid->name() + "|horiz_remap:" + map_file;
+  REQUIRE (coordinator->get_diagnostic("MyDiag",grid->name())!=nullptr);
+  REQUIRE (coordinator->has_remapped_field(remap_key,"MyDiag"));
+  const auto remapper = coordinator->get_remapper(remap_key,"MyDiag");
+  REQUIRE (coordinator->is_shared(*remapper));
+  Field tgt = coordinator->get_remapped_field(remap_key,"MyDiag");
+
+  // Count the entries of the remapped diag equal to val
+  auto count = [&](const Real val) {
+    tgt.sync_to_host();
+    const auto data = tgt.get_internal_view_data<const Real,Host>();
+    const int size = tgt.get_header().get_alloc_properties().get_num_scalars();
+    return std::count(data,data+size,val);
+  };
+  const int tgt_size = tgt.get_header().get_alloc_properties().get_num_scalars();
+  const Real marker = -123;
+
+  MyDiag::num_computes = 0;
+  const int nsteps = 4;
+  auto t = t0;
+  for (int n=1; n<=nsteps; ++n) {
+    for (auto it : fm->get_repo()) {
+      auto& f = *it.second;
+      Field one = f.clone("one");
+      one.deep_copy(1.0);
+      f.get_header().get_tracking().update_time_stamp(t+dt);
+      f.update(one,1.0,1.0);
+    }
+    for (auto& om : oms) {
+      om.init_timestep(t,dt);
+    }
+    t += dt;
+
+    // The first stream writes at every step, so it computes and remaps MyDiag
+    om_a.run(t);
+    REQUIRE (MyDiag::num_computes==n);
+    REQUIRE (coordinator->updated_in_step(remapper.get()));
+    REQUIRE (count(marker)==0);
+
+    // Mark the remapped diag. The second stream (which only writes at even steps)
+    // must write it as is, without computing MyDiag or remapping it again.
+    tgt.deep_copy(marker);
+    om_b.run(t);
+    REQUIRE (MyDiag::num_computes==n);
+    REQUIRE (count(marker)==tgt_size);
+
+    coordinator->end_step();
+  }
 
   // Close file and cleanup
-  om.finalize();
+  for (auto& om : oms) {
+    om.finalize();
+  }
 }
 
-void read (const int seed, const ekat::Comm& comm)
+void read (const int seed, const ekat::Comm& comm, const std::string& casename)
 {
   // Time quantities
   auto t0 = get_t0();
@@ -244,7 +400,6 @@ void read (const int seed, const ekat::Comm& comm)
 
   // Create reader pl
   ekat::ParameterList reader_pl;
-  std::string casename = "io_diags";
   auto filename = casename
     + ".INSTANT.nsteps_x1"
     + ".np" + std::to_string(comm.size())
@@ -296,8 +451,18 @@ TEST_CASE ("io_diags") {
   };
 
   print ("-> Write diagnostic output ", 40);
-  write(seed,comm);
-  read(seed,comm);
+  write(seed,comm,false);
+  read(seed,comm,"io_diags");
+  print(" PASS\n");
+
+  print ("-> Write shared diagnostic output ", 40);
+  write(seed,comm,true);
+  read(seed,comm,"io_diags_shared_a");
+  read(seed,comm,"io_diags_shared_b");
+  print(" PASS\n");
+
+  print ("-> Write shared remapped diagnostic output ", 40);
+  write_shared_remap(seed,comm);
   print(" PASS\n");
   scorpio::finalize_subsystem();
 }
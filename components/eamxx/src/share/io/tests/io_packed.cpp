@@ -1,3 +1,4 @@
+#define CATCH_CONFIG_RUNNER
 #include <catch2/catch.hpp>
 
 #include "share/io/eamxx_output_manager.hpp"
@@ -12,6 +13,7 @@
 #include "share/util/eamxx_setup_random_test.hpp"
 #include "share/util/eamxx_time_stamp.hpp"
 #include "share/eamxx_types.hpp"
+#include "share/eamxx_session.hpp"
 
 #include <ekat_units.hpp>
 #include <ekat_parameter_list.hpp>
@@ -90,11 +92,23 @@ get_fm (const std::shared_ptr<const AbstractGrid>& grid,
     fm->add_field(f);
   }
 
+  // A padded int field: the padding must not end up in the file
+  FID ifid("i_"+std::to_string(layouts.back().size()),layouts.back(),units,grid->name(),DataType::IntType);
+  Field fi(ifid);
+  fi.get_header().get_alloc_properties().request_allocation(ps);
+  fi.allocate_view();
+  randomize (fi,engine,[&](std::mt19937_64& engine) {
+    std::uniform_int_distribution<int> pdf (0,100);
+    return pdf(engine);
+  });
+  fi.get_header().get_tracking().update_time_stamp(t0);
+  fm->add_field(fi);
+
   return fm;
 }
 
 // Returns fields after initialization
-void write (const int freq, const int seed, const int ps, const ekat::Comm& comm)
+void write (const int freq, const int seed, const int ps, const bool async, const ekat::Comm& comm)
 {
   // Create grid
   auto gm = get_gm(comm);
@@ -115,6 +129,7 @@ void write (const int freq, const int seed, const int ps, const ekat::Comm& comm
   om_pl.set("filename_prefix","io_packed_ps"+std::to_string(ps));
   om_pl.set("field_names",fnames);
   om_pl.set("averaging_type", std::string("instant"));
+  om_pl.set("async_write", async);
   auto& ctrl_pl = om_pl.sublist("output_control");
   ctrl_pl.set("frequency_units",std::string("nsteps"));
   ctrl_pl.set("frequency",freq);
@@ -193,16 +208,39 @@ TEST_CASE ("io_packs") {
     }
   };
 
-  for (const auto ps_write : {1,2,4,8}) {
-    print ("-> Pack size write: " + std::to_string(ps_write) + "\n");
-    write(freq,seed,ps_write,comm);
-    for (const auto ps_read : {1,2,4,8,16}) {
-      print ("  -> Pack size read: " + std::to_string(ps_read) + " ",40);
-      read(freq,seed,ps_write,ps_read,comm);
-      print(" PASS\n");
+  // Async writes are only async with MPI_THREAD_MULTIPLE (see main below),
+  // otherwise the output manager falls back to synchronous writes
+  if (not scorpio::async_tasks_supported()) {
+    WARN ("MPI does not support MPI_THREAD_MULTIPLE. Async writes are done synchronously.");
+  }
+
+  // Padded fields are packed on device at write time (in a host staging buffer, if async)
+  for (const bool async : {false, true}) {
+    for (const auto ps_write : {1,2,4,8}) {
+      print ("-> Pack size write: " + std::to_string(ps_write) + (async ? " (async)" : "") + "\n");
+      write(freq,seed,ps_write,async,comm);
+      for (const auto ps_read : {1,2,4,8,16}) {
+        print ("  -> Pack size read: " + std::to_string(ps_read) + " ",40);
+        read(freq,seed,ps_write,ps_read,comm);
+        print(" PASS\n");
+      }
     }
   }
   scorpio::finalize_subsystem();
 }
 
 } // anonymous namespace
+
+// The default test main initializes MPI without thread support, which would
+// turn async writes off. Here we request MPI_THREAD_MULTIPLE instead.
+int main (int argc, char** argv) {
+  int provided;
+  MPI_Init_thread(&argc,&argv,MPI_THREAD_MULTIPLE,&provided);
+  scream::initialize_eamxx_session(argc,argv);
+
+  const int ret = Catch::Session().run(argc,argv);
+
+  scream::finalize_eamxx_session();
+  MPI_Finalize();
+  return ret;
+}
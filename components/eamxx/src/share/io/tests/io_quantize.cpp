@@ -0,0 +1,278 @@
+#include <catch2/catch.hpp>
+
+#include "share/io/eamxx_output_manager.hpp"
+#include "share/io/scorpio_input.hpp"
+
+#include "share/grid/mesh_free_grids_manager.hpp"
+
+#include "share/field/field_utils.hpp"
+#include "share/field/field_quantize.hpp"
+#include "share/field/field.hpp"
+#include "share/field/field_manager.hpp"
+
+#include "share/util/eamxx_setup_random_test.hpp"
+#include "share/util/eamxx_time_stamp.hpp"
+#include "share/eamxx_types.hpp"
+
+#include <ekat_units.hpp>
+#include <ekat_parameter_list.hpp>
+#include <ekat_comm.hpp>
+
+#include <cmath>
+#include <iomanip>
+#include <memory>
+
+namespace scream {
+
+constexpr int num_output_steps = 3;
+constexpr int compression_level = 4;
+
+// Number of significant digits of each output var (0 means no quantization)
+const std::map<std::string,int> sig_digits = {
+  {"f_0", 3},   // Stream default
+  {"f_1", 0},   // Per-field override: no quantization
+  {"f_2", 6}    // Per-field override
+};
+
+util::TimeStamp get_t0 () {
+  return util::TimeStamp({2023,2,17},{0,0,0});
+}
+
+std::shared_ptr<const GridsManager>
+get_gm (const ekat::Comm& comm)
+{
+  const int ngcols = std::max(comm.size()-1,1);
+  const int nlevs = 4;
+  auto gm = create_mesh_free_grids_manager(comm,0,0,nlevs,ngcols);
+  gm->build_grids();
+  return gm;
+}
+
+std::shared_ptr<FieldManager>
+get_fm (const std::shared_ptr<const AbstractGrid>& grid,
+        const util::TimeStamp& t0, const int seed)
+{
+  using FL  = FieldLayout;
+  using FID = FieldIdentifier;
+  using namespace ShortFieldTagsNames;
+
+  // Use non-integer values, so that quantization actually changes them
+  std::mt19937_64 engine(seed);
+  std::uniform_real_distribution<Real> pdf (-100,100);
+
+  const int nlcols = grid->get_num_local_dofs();
+  const int nlevs  = grid->get_num_vertical_levels();
+
+  std::vector<FL> layouts =
+  {
+    FL({COL         }, {nlcols        }),
+    FL({COL,     LEV}, {nlcols,  nlevs}),
+    FL({COL,CMP,ILEV}, {nlcols,2,nlevs+1})
+  };
+
+  auto fm = std::make_shared<FieldManager>(grid);
+
+  const auto units = ekat::units::Units::nondimensional();
+  int count=0;
+  for (const auto& fl : layouts) {
+    FID fid("f_"+std::to_string(count),fl,units,grid->name());
+    Field f(fid);
+    f.allocate_view();
+    randomize (f,engine,pdf);
+    f.get_header().get_tracking().update_time_stamp(t0);
+    fm->add_field(f);
+    ++count;
+  }
+
+  return fm;
+}
+
+std::string get_prefix (const std::string& iotype)
+{
+  return iotype=="default" ? "io_quantize" : "io_quantize_" + iotype;
+}
+
+std::string get_filename (const std::string& avg_type, const int freq,
+                          const std::string& iotype, const ekat::Comm& comm)
+{
+  return get_prefix(iotype) + "." + avg_type
+       + ".nsteps_x" + std::to_string(freq)
+       + ".np" + std::to_string(comm.size())
+       + "." + get_t0().to_string()
+       + ".nc";
+}
+
+void write (const std::string& avg_type, const int freq, const std::string& iotype,
+            const int seed, const ekat::Comm& comm)
+{
+  auto gm = get_gm(comm);
+  auto grid = gm->get_grid("point_grid");
+  auto t0 = get_t0();
+
+  // The fields are constant in time, so the output should always be the initial fields
+  auto fm = get_fm(grid,t0,seed);
+  std::vector<std::string> fnames;
+  for (auto it : fm->get_repo()) {
+    fnames.push_back(it.second->name());
+  }
+
+  ekat::ParameterList om_pl;
+  om_pl.set("filename_prefix",get_prefix(iotype));
+  om_pl.set("iotype",iotype);
+  om_pl.set("field_names",fnames);
+  om_pl.set("averaging_type", avg_type);
+  om_pl.set("floating_point_precision",std::string("real"));
+  om_pl.set("max_snapshots_per_file",num_output_steps+1);
+  om_pl.set("significant_digits",sig_digits.at("f_0"));
+  auto& digits_pl = om_pl.sublist("significant_digits_per_field");
+  digits_pl.set("f_1",sig_digits.at("f_1"));
+  digits_pl.set("f_2",sig_digits.at("f_2"));
+  // With non-netcdf4 iotypes, this has no effect, but should not hurt
+  om_pl.set("compression_level",compression_level);
+  auto& ctrl_pl = om_pl.sublist("output_control");
+  ctrl_pl.set("frequency_units",std::string("nsteps"));
+  ctrl_pl.set("frequency",freq);
+  ctrl_pl.set("save_grid_data",false);
+
+  // Negative digits, or digits for a var not in the stream, are an error
+  for (const std::string bad_var : {"f_1", "f_3"}) {
+    auto bad_pl = om_pl;
+    bad_pl.sublist("significant_digits_per_field").set(bad_var,bad_var=="f_1" ? -1 : 2);
+    OutputManager bad_om;
+    bad_om.initialize(comm,bad_pl,t0,false);
+    REQUIRE_THROWS (bad_om.setup(fm,gm->get_grid_names()));
+  }
+
+  OutputManager om;
+  om.initialize(comm,om_pl,t0,false);
+  om.setup(fm,gm->get_grid_names());
+
+  std::map<std::string,Field> orig;
+  for (const auto& name : fnames) {
+    orig[name] = fm->get_field(name).clone();
+  }
+
+  const int nsteps = num_output_steps*freq;
+  const int dt = 1;
+  auto t = t0;
+  for (int n=0; n<nsteps; ++n) {
+    om.init_timestep(t,dt);
+    t += dt;
+    om.run (t);
+
+    // Quantization must not alter the model fields (which instant output aliases)
+    for (const auto& name : fnames) {
+      REQUIRE (views_are_equal(fm->get_field(name),orig.at(name)));
+    }
+  }
+
+  om.finalize();
+}
+
+void read (const std::string& avg_type, const int freq, const std::string& iotype,
+           const int seed, const ekat::Comm& comm)
+{
+  const bool instant = avg_type=="INSTANT";
+  const int num_writes = num_output_steps + (instant ? 1 : 0);
+
+  auto gm = get_gm (comm);
+  auto grid = gm->get_grid("point_grid");
+  auto t0 = get_t0();
+
+  // Use wrong seed for fm, so fields are not inited with right data
+  auto fm0 = get_fm(grid,t0,seed);
+  auto fm  = get_fm(grid,t0,-seed-1);
+  std::vector<std::string> fnames;
+  for (auto it : fm->get_repo()) {
+    fnames.push_back(it.second->name());
+  }
+
+  const auto filename = get_filename(avg_type,freq,iotype,comm);
+  ekat::ParameterList reader_pl;
+  reader_pl.set("filename",filename);
+  reader_pl.set("iotype",iotype);
+  reader_pl.set("field_names",fnames);
+  AtmosphereInput reader(reader_pl,fm);
+
+  for (int n=0; n<num_writes; ++n) {
+    reader.read_variables(n);
+    for (const auto& fn : fnames) {
+      const int digits = sig_digits.at(fn);
+      auto f0 = fm0->get_field(fn);
+      auto f  = fm->get_field(fn);
+      if (digits==0) {
+        REQUIRE (views_are_equal(f,f0));
+        continue;
+      }
+
+      // BitRound guarantees a relative error of at most 2^-(nsb+1)
+      const int nsb = significant_digits_to_bits(digits);
+      const auto& layout = f.get_header().get_identifier().get_layout();
+      f.sync_to_host();
+      f0.sync_to_host();
+      auto v  = f.get_internal_view_data<const Real,Host>();
+      auto v0 = f0.get_internal_view_data<const Real,Host>();
+      for (int i=0; i<layout.size(); ++i) {
+        REQUIRE (std::abs(v[i]-v0[i])<=std::ldexp(std::abs(v0[i]),-(nsb+1)));
+      }
+      // For 3 digits, the rounding must have changed at least some values
+      if (digits==3) {
+        REQUIRE (not views_are_equal(f,f0));
+      }
+    }
+  }
+
+  // The quantized vars document the number of significant bits
+  for (const auto& fn: fnames) {
+    const int digits = sig_digits.at(fn);
+    const bool has_att = scorpio::has_attribute(filename,fn,"quantization_nsb");
+    REQUIRE (has_att==(digits>0));
+    if (has_att) {
+      REQUIRE (scorpio::get_attribute<int>(filename,fn,"quantization_nsb")==significant_digits_to_bits(digits));
+    }
+  }
+
+  // With netcdf4 files, all vars are compressed with the requested settings
+  if (scorpio::supports_compression(filename)) {
+    for (const auto& fn: fnames) {
+      int level;
+      bool shuffle;
+      if (scorpio::get_var_compression(filename,fn,level,shuffle)) {
+        REQUIRE (level==compression_level);
+        REQUIRE (shuffle);
+      } else {
+        // The netcdf/hdf5 build may lack parallel filters, in which case vars are not compressed
+        WARN ("Variable " + fn + " was not compressed (parallel filters may be unavailable).");
+      }
+    }
+  }
+}
+
+TEST_CASE ("io_quantize") {
+  ekat::Comm comm(MPI_COMM_WORLD);
+  scorpio::init_subsystem(comm);
+
+  auto seed = get_random_test_seed(&comm);
+
+  const int freq = 2;
+  for (const std::string iotype : {"default", "netcdf4p"}) {
+    if (not scorpio::is_iotype_available(scorpio::str2iotype(iotype))) {
+      WARN ("The " + iotype + " iotype is not available. Skipping it.");
+      continue;
+    }
+    for (const std::string avg : {"INSTANT", "AVERAGE"}) {
+      if (comm.am_i_root()) {
+        std::cout << std::left << std::setw(60) << std::setfill('.')
+                  << ("-> IO type: " + iotype + ", averaging type: " + avg + " ");
+      }
+      write(avg,freq,iotype,seed,comm);
+      read (avg,freq,iotype,seed,comm);
+      if (comm.am_i_root()) {
+        std::cout << " PASS\n";
+      }
+    }
+  }
+  scorpio::finalize_subsystem();
+}
+
+} // namespace scream
@@ -114,8 +114,12 @@ TEST_CASE("output_restart","io")
       }
     }
   };
+  // Only used by some avg types. Note: the fields values increase by dt at each step
+  output_params.set<std::vector<double>>("histogram_bin_edges",{0,5,10,15,20,25});
+  output_params.set<double>("exceedance_threshold",10);
+
   // Run test for different avg type choices
-  for (const std::string avg_type : {"INSTANT","AVERAGE"}) {
+  for (const std::string avg_type : {"INSTANT","AVERAGE","VARIANCE","HISTOGRAM","EXCEEDANCE"}) {
     {
       // In normal runs, the OM for the model restart takes care of nuking rpointer.atm,
       // and re-creating a new one. Here, we don't have that, so we must nuke it manually
@@ -37,6 +37,9 @@ public:
 
   PropertyType type () const override { return PropertyType::PointWise; }
 
+  double lower_bound () const { return m_lb; }
+  double upper_bound () const { return m_ub; }
+
   ResultAndMsg check() const override;
 
 // CUDA requires the parent fcn of a KOKKOS_LAMBDA to have public access
@@ -0,0 +1,130 @@
+#include "share/property_checks/fused_property_checks.hpp"
+#include "share/property_checks/field_nan_check.hpp"
+#include "share/property_checks/field_within_interval_check.hpp"
+
+#include <limits>
+
+namespace scream
+{
+
+void FusedPropertyChecks::
+set_checks (const std::vector<prop_check_ptr>& checks)
+{
+  const int nchecks = checks.size();
+  m_needs_check.assign(nchecks,true);
+  m_fused_idx.assign(nchecks,-1);
+
+  std::vector<FusedCheckInfo> infos;
+  std::vector<int> offsets(1,0);
+  for (int i=0; i<nchecks; ++i) {
+    const auto& pc = checks[i];
+    auto nan_check = std::dynamic_pointer_cast<FieldNaNCheck>(pc);
+    auto int_check = std::dynamic_pointer_cast<FieldWithinIntervalCheck>(pc);
+    if (nan_check==nullptr and int_check==nullptr) {
+      continue;
+    }
+
+    const auto& f = pc->fields().front();
+    const auto& fh = f.get_header();
+    const auto& ap = fh.get_alloc_properties();
+    if (f.data_type()!=get_data_type<Real>() or ap.is_subfield()) {
+      continue;
+    }
+
+    const auto& layout = fh.get_identifier().get_layout();
+    const auto size = layout.size();
+    EKAT_REQUIRE_MSG (static_cast<long long>(offsets.back())+size<=std::numeric_limits<int>::max(),
+        "Error! Total size of fused property checks exceeds int capacity.\n");
+
+    FusedCheckInfo info;
+    info.data        = f.get_internal_view_data_unsafe<const Real>();
+    info.last_dim    = layout.rank()==0 ? 1 : layout.dims().back();
+    info.last_extent = layout.rank()==0 ? 1 : ap.get_last_extent();
+    info.nan_check   = nan_check!=nullptr;
+    info.lb          = int_check ? int_check->lower_bound() : 0;
+    info.ub          = int_check ? int_check->upper_bound() : 0;
+
+    m_fused_idx[i] = infos.size();
+    infos.push_back(info);
+    offsets.push_back(offsets.back()+size);
+  }
+
+  m_num_fused  = infos.size();
+  m_total_size = offsets.back();
+
+  m_infos   = decltype(m_infos)("fused_checks_infos",m_num_fused);
+  m_offsets = decltype(m_offsets)("fused_checks_offsets",m_num_fused+1);
+  m_flags   = decltype(m_flags)("fused_checks_flags",m_num_fused);
+  m_flags_h = Kokkos::create_mirror_view(m_flags);
+  m_stamp   = 0;
+
+  auto infos_h   = Kokkos::create_mirror_view(m_infos);
+  auto offsets_h = Kokkos::create_mirror_view(m_offsets);
+  for (int i=0; i<m_num_fused; ++i) {
+    infos_h(i) = infos[i];
+  }
+  for (int i=0; i<=m_num_fused; ++i) {
+    offsets_h(i) = offsets[i];
+  }
+  Kokkos::deep_copy(m_infos,infos_h);
+  Kokkos::deep_copy(m_offsets,offsets_h);
+}
+
+const std::vector<bool>& FusedPropertyChecks::screen ()
+{
+  if (m_num_fused==0) {
+    return m_needs_check;
+  }
+
+  if (m_stamp==std::numeric_limits<int>::max()) {
+    Kokkos::deep_copy(m_flags,0);
+    m_stamp = 0;
+  }
+  ++m_stamp;
+
+  screen_impl();
+
+  Kokkos::deep_copy(m_flags_h,m_flags);
+  for (int i=0; i<num_checks(); ++i) {
+    const int idx = m_fused_idx[i];
+    if (idx>=0) {
+      m_needs_check[i] = m_flags_h(idx)==m_stamp;
+    }
+  }
+  return m_needs_check;
+}
+
+void FusedPropertyChecks::screen_impl ()
+{
+  const auto infos   = m_infos;
+  const auto offsets = m_offsets;
+  const auto flags   = m_flags;
+  const int  nfused  = m_num_fused;
+  const int  stamp   = m_stamp;
+  Kokkos::parallel_for(KT::RangePolicy(0,m_total_size),
+                       KOKKOS_LAMBDA(const int idx) {
+    // Bisect to find the check this entry belongs to
+    int beg = 0, end = nfused;
+    while (end-beg>1) {
+      const int mid = (beg+end)/2;
+      if (offsets(mid)<=idx) {
+        beg = mid;
+      } else {
+        end = mid;
+      }
+    }
+    const auto& info = infos(beg);
+    const int i = idx - offsets(beg);
+    const Real v = info.data[(i/info.last_dim)*info.last_extent + i%info.last_dim];
+
+    // NOTE: NaN values fail the within-interval check as well
+    const bool ok = info.nan_check ? not Kokkos::isnan(v)
+                                   : (v>=info.lb and v<=info.ub);
+    if (not ok) {
+      // All threads write the same value, so no need for atomics
+      flags(beg) = stamp;
+    }
+  });
+}
+
+} // namespace scream
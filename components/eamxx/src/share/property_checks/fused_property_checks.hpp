@@ -0,0 +1,82 @@
+#ifndef SCREAM_FUSED_PROPERTY_CHECKS_HPP
+#define SCREAM_FUSED_PROPERTY_CHECKS_HPP
+
+#include "share/property_checks/property_check.hpp"
+#include "share/eamxx_types.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace scream
+{
+
+/*
+ * A class to screen several pointwise property checks in a single kernel
+ *
+ * Running each NaN/bounds check separately costs one reduction (and one fence)
+ * per field. This class collects all the FieldNaNCheck and FieldWithinIntervalCheck
+ * checks (including lower/upper bound checks) it is given, and, with one kernel
+ * over all their fields, flags the ones that are not satisfied everywhere.
+ *
+ * The class does not replace the checks: a flagged check must still be run
+ * (and, if needed, repaired) via its own check() method, which will produce
+ * the usual detailed message. Checks that cannot be fused (other check types,
+ * non-Real fields, subfields) are always flagged. Since failures are rare,
+ * most of the time this costs one kernel and one small device-to-host copy.
+ */
+
+class FusedPropertyChecks {
+public:
+  using prop_check_ptr = std::shared_ptr<PropertyCheck>;
+
+  FusedPropertyChecks () = default;
+
+  // Set the checks to screen. Their fields must already be allocated.
+  void set_checks (const std::vector<prop_check_ptr>& checks);
+
+  // Number of checks (fused or not) set in this object
+  int num_checks () const { return m_needs_check.size(); }
+
+  // Run the fused kernel, and return, for each check, whether it
+  // needs to be run individually.
+  const std::vector<bool>& screen ();
+
+// CUDA requires the parent fcn of a KOKKOS_LAMBDA to have public access
+#ifndef EAMXX_ENABLE_GPU
+protected:
+#endif
+
+  void screen_impl ();
+
+protected:
+  using KT = KokkosTypes<DefaultDevice>;
+
+  struct FusedCheckInfo {
+    const Real* data;
+    int         last_dim;     // Extent of the last dim
+    int         last_extent;  // Allocated extent of the last dim (including padding)
+    bool        nan_check;    // If false, it's a within-interval check
+    double      lb, ub;
+  };
+
+  // For each check: whether it must be run individually, and, if fused, its fused index
+  std::vector<bool>           m_needs_check;
+  std::vector<int>            m_fused_idx;
+
+  // Data of the fused checks. The entries of the i-th fused check
+  // are in the range [m_offsets(i), m_offsets(i+1)) of the fused kernel
+  KT::view_1d<FusedCheckInfo> m_infos;
+  KT::view_1d<int>            m_offsets;
+  int                         m_num_fused = 0;
+  int                         m_total_size = 0;
+
+  // Each fused check which is not satisfied gets its flag set to the current stamp,
+  // so that we don't have to reset the flags at every screening
+  KT::view_1d<int>            m_flags;
+  KT::view_1d<int>::HostMirror m_flags_h;
+  int                         m_stamp = 0;
+};
+
+} // namespace scream
+
+#endif // SCREAM_FUSED_PROPERTY_CHECKS_HPP
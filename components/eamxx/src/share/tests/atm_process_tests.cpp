@@ -263,6 +263,34 @@ protected:
   }
 };
 
+class ScaleBy : public DummyProcess
+{
+public:
+  ScaleBy (const ekat::Comm& comm,const ekat::ParameterList& params)
+   : DummyProcess(comm,params)
+  {
+    m_factor = params.get<double>("factor");
+  }
+
+  // The type of the atm proc
+  AtmosphereProcessType type () const { return AtmosphereProcessType::Physics; }
+
+  void set_grids (const std::shared_ptr<const GridsManager> gm) {
+    using namespace ekat::units;
+
+    const auto grid = gm->get_grid(m_grid_name);
+    const auto lt = grid->get_2d_scalar_layout ();
+
+    add_field<Updated>("Field A",lt,K,m_grid_name);
+  }
+protected:
+  void run_impl (const double /* dt */) {
+    get_field_out("Field A", m_grid_name).scale(static_cast<Real>(m_factor));
+  }
+
+  double m_factor;
+};
+
 // ================================ TESTS ============================== //
 
 TEST_CASE("process_factory", "") {
@@ -511,6 +539,80 @@ TEST_CASE ("subcycling") {
   }
 }
 
+TEST_CASE ("parallel_splitting") {
+  using namespace scream;
+  using strvec_t = std::vector<std::string>;
+
+  // A world comm
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  // A time stamp
+  util::TimeStamp t0 ({2022,1,1},{0,0,0});
+
+  // Create a grids manager
+  auto gm = create_gm(comm);
+
+  auto& factory = AtmosphereProcessFactory::instance();
+  factory.register_product("ScaleBy",&create_atmosphere_process<ScaleBy>);
+
+  // Two procs that update the same field: f*2 and f*3
+  auto create_group = [&](const std::string& sched_type) {
+    ekat::ParameterList params ("Group");
+    params.set<std::string>("schedule_type",sched_type);
+    params.set<strvec_t>("atm_procs_list",{"Double","Triple"});
+
+    auto& p0 = params.sublist("Double");
+    p0.set<std::string>("type", "ScaleBy");
+    p0.set<std::string>("grid_name", "point_grid");
+    p0.set<double>("factor", 2);
+
+    auto& p1 = params.sublist("Triple");
+    p1.set<std::string>("type", "ScaleBy");
+    p1.set<std::string>("grid_name", "point_grid");
+    p1.set<double>("factor", 3);
+
+    auto group = std::make_shared<AtmosphereProcessGroup>(comm,params);
+    group->set_grids(gm);
+
+    // Both procs request the same field, so create it only once
+    const auto& req = group->get_required_field_requests().front();
+    Field f(req.fid);
+    f.allocate_view();
+    f.deep_copy(1.0);
+    f.get_header().get_tracking().update_time_stamp(t0);
+    group->set_required_field(f.get_const());
+    group->set_computed_field(f);
+
+    group->initialize(t0,RunType::Initial);
+    return group;
+  };
+
+  auto seq = create_group("sequential");
+  auto par = create_group("parallel");
+  REQUIRE (seq->get_schedule_type()==ScheduleType::Sequential);
+  REQUIRE (par->get_schedule_type()==ScheduleType::Parallel);
+
+  // The DAG must not complain about dependencies between the parallel procs
+  AtmProcDAG dag;
+  dag.create_dag(*par);
+  REQUIRE (not dag.has_unmet_dependencies());
+
+  seq->run(1);
+  par->run(1);
+
+  // Sequential: 1*2*3=6. Parallel: 1 + (2-1) + (3-1) = 4
+  auto f_seq = seq->get_fields_out().front();
+  auto f_par = par->get_fields_out().front();
+  f_seq.sync_to_host();
+  f_par.sync_to_host();
+  auto v_seq = f_seq.get_view<const Real*,Host>();
+  auto v_par = f_par.get_view<const Real*,Host>();
+  for (size_t i=0; i<v_seq.size(); ++i) {
+    REQUIRE (v_seq[i]==6);
+    REQUIRE (v_par[i]==4);
+  }
+}
+
 TEST_CASE ("diagnostics") {
 
   //TODO: This test needs a field manager so that changes in Field A are seen everywhere.
@@ -6,6 +6,11 @@
 #include "share/util/eamxx_setup_random_test.hpp"
 #include "share/field/field_utils.hpp"
 
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+
 namespace scream {
 
 class CoarseningRemapperTester : public CoarseningRemapper {
@@ -366,7 +371,10 @@ TEST_CASE("coarsening_remap")
     return std::distance(data,it);
   };
   for (int irun=0; irun<5; ++irun) {
-    root_print (" -> Run " + std::to_string(irun) + "\n",comm);
+    // Alternate sparse formats, to check they all give the same answer
+    const auto fmt = irun%2==0 ? SparseFormat::CRS : SparseFormat::ELL;
+    remap->set_sparse_format(fmt);
+    root_print (" -> Run " + std::to_string(irun) + " (" + e2str(fmt) + " format)\n",comm);
     remap->remap_fwd();
 
     // Recall, tgt gid K should be the avg of local src_gids
@@ -514,4 +522,149 @@ TEST_CASE("coarsening_remap")
   scorpio::finalize_subsystem();
 }
 
+TEST_CASE("horiz_remap_data_cache")
+{
+  namespace fs = std::filesystem;
+  using gid_type = AbstractGrid::gid_type;
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  root_print ("\n +---------------------------------+\n",comm);
+  root_print (" |   Testing horiz remap cache     |\n",comm);
+  root_print (" +---------------------------------+\n\n",comm);
+
+  scorpio::init_subsystem(comm);
+  auto engine = setup_random_test (&comm);
+
+  const std::string map_file = "cr_cache_tests_map." + std::to_string(comm.size()) + ".nc";
+  const int ngdofs_tgt = 2*comm.size();
+  create_remap_file(map_file, ngdofs_tgt);
+  auto src_grid = build_src_grid(comm, ngdofs_tgt+1, engine);
+
+  // Reference data, built from the map file
+  HorizRemapperData::set_cache_dir("");
+  HorizRemapperData ref;
+  ref.build(map_file,src_grid,comm,InterpType::Coarsen);
+
+  const std::string cache_dir = "cr_cache_np" + std::to_string(comm.size());
+  if (comm.am_i_root()) {
+    fs::remove_all(cache_dir);
+  }
+  comm.barrier();
+  HorizRemapperData::set_cache_dir(cache_dir);
+
+  auto same_view = [](const auto& v1, const auto& v2) {
+    auto v1_h = cmvdc(v1);
+    auto v2_h = cmvdc(v2);
+    if (v1_h.size()!=v2_h.size()) {
+      return false;
+    }
+    for (size_t i=0; i<v1_h.size(); ++i) {
+      if (v1_h.data()[i]!=v2_h.data()[i]) {
+        return false;
+      }
+    }
+    return true;
+  };
+  auto same_gids = [&](const AbstractGrid& g1, const AbstractGrid& g2) {
+    return same_view(g1.get_dofs_gids().get_view<const gid_type*>(),
+                     g2.get_dofs_gids().get_view<const gid_type*>());
+  };
+  auto check_same_as_ref = [&](const HorizRemapperData& data) {
+    REQUIRE (same_gids(*data.coarse_grid,*ref.coarse_grid));
+    REQUIRE (same_gids(*data.ov_coarse_grid,*ref.ov_coarse_grid));
+    REQUIRE (same_view(data.row_offsets,ref.row_offsets));
+    REQUIRE (same_view(data.col_lids,ref.col_lids));
+    REQUIRE (same_view(data.weights,ref.weights));
+    REQUIRE (data.format==ref.format);
+  };
+
+  auto read_bytes = [](const std::string& fname) {
+    std::ifstream ifs(fname,std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(ifs),std::istreambuf_iterator<char>());
+  };
+  auto write_bytes = [](const std::string& fname, const std::vector<char>& bytes) {
+    std::ofstream ofs(fname,std::ios::binary);
+    ofs.write(bytes.data(),bytes.size());
+  };
+
+  // No cache file yet: the data is built from the map file, and the cache is written
+  {
+    HorizRemapperData data;
+    data.build(map_file,src_grid,comm,InterpType::Coarsen);
+    check_same_as_ref(data);
+  }
+  const std::string suffix = ".rank" + std::to_string(comm.rank()) + ".bin";
+  std::vector<std::string> my_files;
+  for (const auto& entry : fs::directory_iterator(cache_dir)) {
+    const auto fname = entry.path().string();
+    if (fname.size()>suffix.size() and
+        fname.compare(fname.size()-suffix.size(),suffix.size(),suffix)==0) {
+      my_files.push_back(fname);
+    }
+  }
+  REQUIRE (my_files.size()==1);
+  const auto cache_file = my_files[0];
+  const auto orig_bytes = read_bytes(cache_file);
+
+  // Round trip: the data loaded from the cache matches the one built from the map file
+  {
+    HorizRemapperData data;
+    data.build(map_file,src_grid,comm,InterpType::Coarsen);
+    check_same_as_ref(data);
+  }
+
+  // Change the last weight in the cache file (if any), to make sure the cache is used
+  const int nnz = ref.weights.size();
+  const Real bad_weight = 12345;
+  auto tampered_bytes = orig_bytes;
+  if (nnz>0) {
+    std::memcpy(tampered_bytes.data()+tampered_bytes.size()-sizeof(Real),&bad_weight,sizeof(Real));
+  }
+  write_bytes(cache_file,tampered_bytes);
+  {
+    HorizRemapperData data;
+    data.build(map_file,src_grid,comm,InterpType::Coarsen);
+    auto weights_h = cmvdc(data.weights);
+    auto ref_weights_h = cmvdc(ref.weights);
+    REQUIRE (static_cast<int>(weights_h.size())==nnz);
+    for (int i=0; i<nnz; ++i) {
+      REQUIRE (weights_h(i)==(i==nnz-1 ? bad_weight : ref_weights_h(i)));
+    }
+  }
+
+  // A cache file with a bad magic number, version, or fine grid hash is rejected, and
+  // the data is rebuilt from the map file. Since all ranks must take the same path,
+  // corrupting the header on the last rank only is enough. The other ranks keep the
+  // bad weight, so using their cache would be detected.
+  // NOTE: the header starts with the uint64 magic, version, and fine grid hash
+  for (const int offset : {0,8,16}) {
+    auto bad_bytes = tampered_bytes;
+    if (comm.rank()==comm.size()-1) {
+      bad_bytes[offset] ^= 0x1;
+    }
+    write_bytes(cache_file,bad_bytes);
+
+    HorizRemapperData data;
+    data.build(map_file,src_grid,comm,InterpType::Coarsen);
+    check_same_as_ref(data);
+
+    // The cache was rewritten with the rebuilt data
+    REQUIRE (read_bytes(cache_file)==orig_bytes);
+    write_bytes(cache_file,tampered_bytes);
+  }
+
+  // A truncated file is rejected too
+  write_bytes(cache_file,std::vector<char>(orig_bytes.begin(),orig_bytes.begin()+orig_bytes.size()/2));
+  {
+    HorizRemapperData data;
+    data.build(map_file,src_grid,comm,InterpType::Coarsen);
+    check_same_as_ref(data);
+    REQUIRE (read_bytes(cache_file)==orig_bytes);
+  }
+
+  HorizRemapperData::set_cache_dir("");
+  scorpio::finalize_subsystem();
+}
+
 } // namespace scream
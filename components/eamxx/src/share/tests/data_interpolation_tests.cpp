@@ -52,7 +52,8 @@ void root_print (const ekat::Comm& comm,
 void run_tests (const std::shared_ptr<const AbstractGrid>& grid,
                 const strvec_t& input_files, util::TimeStamp t_beg,
                 const util::TimeLine timeline,
-                const DataInterpolation::VRemapType vr_type = DataInterpolation::None)
+                const DataInterpolation::VRemapType vr_type = DataInterpolation::None,
+                const bool prefetch = false)
 {
   auto t_end = t_beg + t_beg.days_in_curr_month()*spd;
   auto t0 = t_beg + (t_end-t_beg)/2;
@@ -124,6 +125,7 @@ void run_tests (const std::shared_ptr<const AbstractGrid>& grid,
   interp->setup_time_database(input_files,util::TimeLine::YearlyPeriodic);
   interp->create_horiz_remappers (map_file);
   interp->create_vert_remapper (vremap_data);
+  interp->set_prefetch(prefetch);
   interp->init_data_interval(t0);
 
   // We jump ahead by 2 months, but the shift interval logic cannot keep up with
@@ -223,6 +225,13 @@ void run_tests (const std::shared_ptr<const AbstractGrid>& grid,
       REQUIRE (frobenius_norm<Real>(diff[i])<tol);
     }
   }
+
+  // Make sure the prefetched data was actually used (or not read at all, if not prefetching)
+  if (prefetch) {
+    REQUIRE (interp->get_num_prefetched_reads()>0);
+  } else {
+    REQUIRE (interp->get_num_prefetched_reads()==0);
+  }
 }
 
 TEST_CASE ("exceptions")
@@ -275,7 +284,7 @@ TEST_CASE ("interpolation")
     SECTION ("no-horiz") {
       SECTION ("no-vert") {
         root_print(comm,"  timeline=PERIODIC, horiz_remap=NO,  vert_remap=NO ..........\n");
-        run_tests (data_grid,files,t_beg,timeline);
+        run_tests (data_grid,files,t_beg,timeline,NOP,true);
         root_print(comm,"  timeline=PERIODIC, horiz_remap=NO,  vert_remap=NO .......... PASS\n");
       }
       SECTION ("p1d-vert") {
@@ -313,7 +322,7 @@ TEST_CASE ("interpolation")
       }
       SECTION ("p3d-vert") {
         root_print(comm,"  timeline=PERIODIC, horiz_remap=YES, vert_remap=p3d .........\n");
-        run_tests (hvfine_grid,files_no_ilev,t_beg,timeline,P3D);
+        run_tests (hvfine_grid,files_no_ilev,t_beg,timeline,P3D,true);
         root_print(comm,"  timeline=PERIODIC, horiz_remap=YES, vert_remap=p3d ......... PASS\n");
       }
     }
@@ -329,7 +338,7 @@ TEST_CASE ("interpolation")
     SECTION ("no-horiz") {
       SECTION ("no-vert") {
         root_print(comm,"  timeline=LINEAR,   horiz_remap=NO,  vert_remap=NO ..........\n");
-        run_tests (data_grid,files,t_beg,timeline);
+        run_tests (data_grid,files,t_beg,timeline,NOP,true);
         root_print(comm,"  timeline=LINEAR,   horiz_remap=NO,  vert_remap=NO .......... PASS\n");
       }
       SECTION ("p1d-vert") {
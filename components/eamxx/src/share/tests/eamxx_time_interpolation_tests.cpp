@@ -177,6 +177,8 @@ TEST_CASE ("eamxx_time_interpolation_data_from_file") {
     time_interpolator.add_field(ff);
     time_interpolator_deep.add_field(ff_deep,true);
   }
+  // Use the deep copy interpolator to also check that prefetching data gives the same answer
+  time_interpolator_deep.set_prefetch(true);
   time_interpolator.initialize_data_from_files();
   time_interpolator_deep.initialize_data_from_files();
   printf(  "Constructing a time interpolation object ... DONE\n");
@@ -224,6 +226,10 @@ TEST_CASE ("eamxx_time_interpolation_data_from_file") {
   }
 
 
+  // Make sure the deep copy interpolator did use prefetched data
+  REQUIRE (time_interpolator.get_num_prefetched_reads()==0);
+  REQUIRE (time_interpolator_deep.get_num_prefetched_reads()>0);
+
   time_interpolator.finalize();
   time_interpolator_deep.finalize();
   printf("                        ... DONE\n");
@@ -0,0 +1,144 @@
+#include <catch2/catch.hpp>
+
+#include "share/util/eamxx_timing.hpp"
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+namespace {
+
+struct ParsedEvent {
+  std::string name;
+  double ts, dur;
+  int pid;
+  int subcycle = -1;
+};
+
+// Events are written one per line, as {"name":"...","cat":...,"ts":...,...}
+ParsedEvent parse_event (const std::string& line)
+{
+  auto get_num = [&](const std::string& key) {
+    const auto pos = line.find("\"" + key + "\":");
+    REQUIRE (pos!=std::string::npos);
+    return std::strtod(line.c_str()+pos+key.size()+3,nullptr);
+  };
+  ParsedEvent e;
+  const std::string name_beg = "{\"name\":\"";
+  const auto name_end = line.find("\",\"cat\"");
+  REQUIRE (line.compare(0,name_beg.size(),name_beg)==0);
+  REQUIRE (name_end!=std::string::npos);
+  e.name = line.substr(name_beg.size(),name_end-name_beg.size());
+  e.ts  = get_num("ts");
+  e.dur = get_num("dur");
+  e.pid = static_cast<int>(get_num("pid"));
+  if (line.find("\"subcycle\"")!=std::string::npos) {
+    e.subcycle = static_cast<int>(get_num("subcycle"));
+  }
+  return e;
+}
+
+} // anonymous namespace
+
+TEST_CASE("event_tracer") {
+  using namespace scream;
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  // Not inited: tracing is a no-op
+  REQUIRE (not is_event_tracer_inited());
+  start_trace_event("foo");
+  stop_trace_event("foo");
+  REQUIRE_THROWS (finalize_event_tracer("foo.json"));
+  REQUIRE_THROWS (init_event_tracer(comm,0));
+
+  const int capacity = 5;
+  const int too_deep = 6;
+  const int depth = 64 + too_deep;
+  init_event_tracer(comm,capacity);
+  REQUIRE (is_event_tracer_inited());
+  REQUIRE_THROWS (init_event_tracer(comm,capacity));
+
+  // Regions nested too deeply are not traced, and the others fill the ring buffer
+  for (int i=0; i<depth; ++i) {
+    start_trace_event("deep");
+  }
+  for (int i=0; i<depth; ++i) {
+    stop_trace_event("deep");
+  }
+
+  // These overwrite the deep events in the ring buffer
+  const std::string esc_name = "esc\"ape\\d\tname";
+  start_trace_event("outer",3);
+  for (const auto& n : {"inner",esc_name.c_str()}) {
+    start_trace_event(n);
+    stop_trace_event(n);
+  }
+  stop_trace_event("outer");
+
+  // Regions closed out of order are still recorded
+  start_trace_event("x");
+  start_trace_event("y");
+  stop_trace_event("x");
+  stop_trace_event("y");
+
+  // Stopping a region that is not open is a no-op
+  stop_trace_event("not_open");
+
+  const std::string fname = "event_tracer_np" + std::to_string(comm.size()) + ".json";
+  finalize_event_tracer(fname);
+  REQUIRE (not is_event_tracer_inited());
+
+  if (comm.am_i_root()) {
+    std::ifstream ifs(fname);
+    std::string line;
+    std::vector<std::string> lines;
+    while (std::getline(ifs,line)) {
+      lines.push_back(line);
+    }
+
+    const int nranks = comm.size();
+    const int nevents = capacity;
+    // Header, per rank a metadata line and the events, and 3 footer lines
+    REQUIRE (lines.size()==static_cast<size_t>(1 + nranks*(1+nevents) + 3));
+    REQUIRE (lines.front()=="{\"traceEvents\":[");
+    // The 64 deep events that were stored got overwritten, the others were not stored
+    const long long num_dropped = nranks*(64 + too_deep);
+    REQUIRE (lines.back()=="\"otherData\":{\"num_ranks\":" + std::to_string(nranks) +
+                           ",\"num_dropped_events\":" + std::to_string(num_dropped) + "}}");
+
+    const std::vector<std::string> names = {"inner","esc\\\"ape\\\\d\\u0009name","outer","x","y"};
+    int iline = 1;
+    for (int pid=0; pid<nranks; ++pid) {
+      REQUIRE (lines[iline].find("\"ph\":\"M\",\"pid\":" + std::to_string(pid) + ",")!=std::string::npos);
+      ++iline;
+
+      // Events are listed oldest first, and all are properly separated
+      std::vector<ParsedEvent> events;
+      for (int i=0; i<nevents; ++i, ++iline) {
+        const auto& l = lines[iline];
+        const bool last = pid==nranks-1 and i==nevents-1;
+        REQUIRE ((l.back()==',')==(not last));
+        events.push_back(parse_event(last ? l : l.substr(0,l.size()-1)));
+        REQUIRE (events.back().pid==pid);
+        REQUIRE (events.back().name==names[i]);
+        REQUIRE (events.back().dur>=0);
+      }
+
+      // The inner regions are within the outer one, and only it has a subcycle
+      const auto& outer = events[2];
+      const double tol = 2e-3; // Times are written with 3 decimal digits
+      REQUIRE (outer.subcycle==3);
+      for (int i : {0,1}) {
+        REQUIRE (events[i].subcycle==-1);
+        REQUIRE (events[i].ts>=outer.ts-tol);
+        REQUIRE (events[i].ts+events[i].dur<=outer.ts+outer.dur+tol);
+      }
+      // x was stopped first, but started first too
+      REQUIRE (events[3].ts<=events[4].ts+tol);
+      REQUIRE (events[3].ts+events[3].dur<=events[4].ts+events[4].dur+tol);
+    }
+  }
+  comm.barrier();
+}
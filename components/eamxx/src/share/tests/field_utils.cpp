@@ -1,11 +1,17 @@
 #include <catch2/catch.hpp>
 #include <numeric>
+#include <cmath>
+#include <cstring>
+#include <limits>
 
 #include "share/field/field_identifier.hpp"
 #include "share/field/field_header.hpp"
 #include "share/field/field.hpp"
 #include "share/field/field_manager.hpp"
 #include "share/field/field_utils.hpp"
+#include "share/field/field_tally.hpp"
+#include "share/field/field_online_stats.hpp"
+#include "share/field/field_quantize.hpp"
 #include "share/util/eamxx_setup_random_test.hpp"
 #include "share/util/eamxx_universal_constants.hpp"
 
@@ -906,4 +912,309 @@ TEST_CASE ("compute_mask") {
   }
 }
 
+TEST_CASE ("field_tally") {
+  using namespace scream;
+  using namespace ShortFieldTagsNames;
+
+  using RPDF = std::uniform_real_distribution<Real>;
+  using P8 = ekat::Pack<Real,8>;
+
+  auto engine = setup_random_test();
+  RPDF pdf(0,1);
+
+  const int ncols = 5;
+  const int ncmps = 2;
+  const int nlevs = 13;
+  const auto units = ekat::units::Units::nondimensional();
+
+  // A scalar, a padded field that may be filled, and a non padded field
+  FieldIdentifier fid0 ("f0", {{},{}}, units, "some_grid");
+  FieldIdentifier fid1 ("f1", {{COL,LEV},{ncols,nlevs}}, units, "some_grid");
+  FieldIdentifier fid2 ("f2", {{COL,CMP},{ncols,ncmps}}, units, "some_grid");
+  FieldIdentifier fidc ("count", {{COL,LEV},{ncols,nlevs}}, units, "some_grid", DataType::IntType);
+
+  std::vector<Field> x, y, y_ref;
+  for (const auto& fid : {fid0, fid1, fid2}) {
+    Field xf (fid);
+    if (fid.get_layout().rank()==2 and fid.get_layout().tags().back()==LEV) {
+      xf.get_header().get_alloc_properties().request_allocation(P8::n);
+    }
+    xf.allocate_view();
+    x.push_back(xf);
+
+    Field yf (fid);
+    yf.allocate_view();
+    y.push_back(yf);
+    y_ref.push_back(yf.clone());
+  }
+  x[1].get_header().set_may_be_filled(true);
+
+  auto randomize_inputs = [&]() {
+    for (auto& f : x) {
+      randomize(f,engine,pdf);
+    }
+    // Put some fill values in the field that may be filled
+    auto v = x[1].get_view<Real**,Host>();
+    x[1].sync_to_host();
+    for (int icol=0; icol<ncols; ++icol) {
+      v(icol,icol % nlevs) = constants::fill_value<Real>;
+    }
+    x[1].sync_to_dev();
+  };
+
+  SECTION ("exceptions") {
+    REQUIRE_THROWS (FieldTally(CombineMode::Replace)); // Unsupported combine mode
+
+    FieldTally tally (CombineMode::Update);
+    REQUIRE_THROWS (tally.run()); // Not closed yet
+    REQUIRE_THROWS (tally.add_field(x[1],y[2])); // Incompatible layouts
+    tally.close();
+    REQUIRE_THROWS (tally.add_field(x[1],y[1])); // Already closed
+  }
+
+  SECTION ("unsupported") {
+    FieldTally tally (CombineMode::Update);
+    Field x_int (fidc);
+    x_int.allocate_view();
+    REQUIRE (not tally.add_field(x_int,x_int.clone())); // Not Real
+    auto x_sub = x[2].get_component(0);
+    REQUIRE (not tally.add_field(x_sub,x_sub.clone())); // Subfield
+    REQUIRE (tally.empty());
+  }
+
+  SECTION ("check") {
+    for (auto cm : {CombineMode::Update, CombineMode::Max, CombineMode::Min}) {
+      FieldTally tally (cm);
+      for (int i=0; i<3; ++i) {
+        y[i].deep_copy(0.5);
+        y_ref[i].deep_copy(0.5);
+        REQUIRE (tally.add_field(x[i],y[i]));
+      }
+
+      Field count (fidc), mask(fidc);
+      count.allocate_view();
+      mask.allocate_view();
+      auto count_ref = count.clone();
+      auto mask_ref  = mask.clone();
+      count.deep_copy(0);
+      count_ref.deep_copy(0);
+      REQUIRE (tally.add_count(x[1],count,mask));
+      tally.close();
+      REQUIRE (tally.size()==4);
+
+      for (int step=0; step<3; ++step) {
+        randomize_inputs();
+        tally.run();
+        for (int i=0; i<3; ++i) {
+          switch (cm) {
+            case CombineMode::Update: y_ref[i].update(x[i],1,1); break;
+            case CombineMode::Max:    y_ref[i].max(x[i]);        break;
+            default:                  y_ref[i].min(x[i]);        break;
+          }
+          REQUIRE (views_are_equal(y[i],y_ref[i]));
+        }
+        compute_mask<Comparison::NE>(x[1],constants::fill_value<Real>,mask_ref);
+        count_ref.update(mask_ref,1,1);
+        REQUIRE (views_are_equal(mask,mask_ref));
+        REQUIRE (views_are_equal(count,count_ref));
+      }
+    }
+  }
+}
+
+TEST_CASE ("field_online_stats") {
+  using namespace scream;
+  using namespace ShortFieldTagsNames;
+
+  using RPDF = std::uniform_real_distribution<Real>;
+  using P8 = ekat::Pack<Real,8>;
+  using KT = KokkosTypes<DefaultDevice>;
+
+  auto engine = setup_random_test();
+  RPDF pdf(0,1);
+
+  const int ncols = 5;
+  const int nlevs = 13;
+  const int nsteps = 4;
+  const auto units = ekat::units::Units::nondimensional();
+  const auto fv = constants::fill_value<Real>;
+
+  // A padded input, which may contain fill values
+  FieldLayout layout ({COL,LEV},{ncols,nlevs});
+  FieldIdentifier fid ("x", layout, units, "some_grid");
+  FieldIdentifier fidc ("count", layout, units, "some_grid", DataType::IntType);
+  FieldIdentifier fidh ("hist", layout.clone().append_dim(CMP,3,"bin"), units, "some_grid");
+  Field x (fid);
+  x.get_header().get_alloc_properties().request_allocation(P8::n);
+  x.allocate_view();
+
+  Field mean (fid.alias("mean")), m2 (fid.alias("m2")), exceed (fid.alias("exceed"));
+  Field count (fidc), hist (fidh);
+  for (auto f : {&mean, &m2, &exceed, &count, &hist}) {
+    f->allocate_view();
+    f->deep_copy(0);
+  }
+
+  std::vector<Real> edges = {0.0, 0.25, 0.5, 0.75};
+  KT::view_1d<Real> edges_d ("edges",edges.size());
+  auto edges_h = Kokkos::create_mirror_view(edges_d);
+  for (size_t k=0; k<edges.size(); ++k) {
+    edges_h(k) = edges[k];
+  }
+  Kokkos::deep_copy(edges_d,edges_h);
+  const Real thresh = 0.6;
+
+  SECTION ("exceptions") {
+    REQUIRE_THROWS (update_exceedance(x,thresh,hist)); // Incompatible layouts
+    REQUIRE_THROWS (update_histogram(x,edges_d,exceed)); // Incompatible layouts
+    REQUIRE_THROWS (update_welford(x,Field(),0,mean,m2)); // Invalid nsamples
+    auto x_sub = x.subfield(COL,0);
+    REQUIRE_THROWS (update_exceedance(x_sub,thresh,exceed.subfield(COL,0))); // Subfield
+  }
+
+  SECTION ("check") {
+    std::vector<std::vector<Real>> samples(ncols*nlevs);
+    for (int step=0; step<nsteps; ++step) {
+      randomize(x,engine,pdf);
+      auto v = x.get_view<Real**,Host>();
+      x.sync_to_host();
+      // Put some fill values (even some entries with no valid sample at all)
+      for (int icol=0; icol<ncols; ++icol) {
+        v(icol,(icol+step) % nlevs) = fv;
+        v(icol,nlevs-1) = fv;
+      }
+      // Some values outside of the histogram range
+      v(0,1) = 0.9;
+      x.sync_to_dev();
+      for (int icol=0; icol<ncols; ++icol) {
+        for (int ilev=0; ilev<nlevs; ++ilev) {
+          if (v(icol,ilev)!=fv) {
+            samples[icol*nlevs+ilev].push_back(v(icol,ilev));
+          }
+        }
+      }
+
+      Field mask (fidc);
+      mask.allocate_view();
+      compute_mask<Comparison::NE>(x,fv,mask);
+      count.update(mask,1,1);
+      update_welford(x,count,step+1,mean,m2);
+      update_histogram(x,edges_d,hist);
+      update_exceedance(x,thresh,exceed);
+    }
+
+    for (auto f : {&mean, &m2, &exceed, &count, &hist}) {
+      f->sync_to_host();
+    }
+    auto mean_h = mean.get_view<const Real**,Host>();
+    auto m2_h   = m2.get_view<const Real**,Host>();
+    auto exc_h  = exceed.get_view<const Real**,Host>();
+    auto cnt_h  = count.get_view<const int**,Host>();
+    auto hist_h = hist.get_view<const Real***,Host>();
+    for (int icol=0; icol<ncols; ++icol) {
+      for (int ilev=0; ilev<nlevs; ++ilev) {
+        const auto& s = samples[icol*nlevs+ilev];
+        const int n = s.size();
+        REQUIRE (cnt_h(icol,ilev)==n);
+
+        // Two-pass mean/variance, counts of bins and exceedances
+        Real avg = 0, var = 0;
+        int nexc = 0;
+        std::vector<int> nbin(3,0);
+        for (auto val : s) {
+          avg += val/n;
+          nexc += val>thresh ? 1 : 0;
+          for (int k=0; k<3; ++k) {
+            nbin[k] += (val>=edges[k] and val<edges[k+1]) ? 1 : 0;
+          }
+        }
+        for (auto val : s) {
+          var += (val-avg)*(val-avg);
+        }
+        REQUIRE (mean_h(icol,ilev)==Approx(avg).margin(1e-6));
+        REQUIRE (m2_h(icol,ilev)==Approx(var).margin(1e-6));
+        REQUIRE (exc_h(icol,ilev)==nexc);
+        for (int k=0; k<3; ++k) {
+          REQUIRE (hist_h(icol,ilev,k)==nbin[k]);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE ("field_quantize") {
+  using namespace scream;
+  using namespace ShortFieldTagsNames;
+
+  using RPDF = std::uniform_real_distribution<Real>;
+  using P8 = ekat::Pack<Real,8>;
+
+  auto engine = setup_random_test();
+  RPDF pdf(-1000,1000);
+
+  const int ncols = 5;
+  const int nlevs = 13;
+  const auto units = ekat::units::Units::nondimensional();
+  const auto fv = constants::fill_value<Real>;
+
+  FieldLayout layout ({COL,LEV},{ncols,nlevs});
+  FieldIdentifier fid ("x", layout, units, "some_grid");
+  Field x (fid);
+  x.get_header().get_alloc_properties().request_allocation(P8::n);
+  x.allocate_view();
+  randomize(x,engine,pdf);
+  x.sync_to_host();
+  auto v = x.get_view<Real**,Host>();
+  for (int icol=0; icol<ncols; ++icol) {
+    v(icol,icol) = fv;
+  }
+  v(0,1) = 0;
+  x.sync_to_dev();
+
+  SECTION ("exceptions") {
+    REQUIRE_THROWS (significant_digits_to_bits(0));
+    REQUIRE_THROWS (bitround(x,0));
+    REQUIRE_THROWS (bitround(x.subfield(COL,0),10));
+  }
+
+  SECTION ("check") {
+    using uint_t = std::conditional_t<sizeof(Real)==8,std::uint64_t,std::uint32_t>;
+    constexpr int mantissa_bits = std::numeric_limits<Real>::digits - 1;
+
+    REQUIRE (significant_digits_to_bits(3)==10);
+    for (int digits : {1, 3, 5}) {
+      const int nsb = significant_digits_to_bits(digits);
+      auto y = x.clone();
+      bitround(y,nsb);
+      y.sync_to_host();
+      auto vy = y.get_view<const Real**,Host>();
+      for (int icol=0; icol<ncols; ++icol) {
+        for (int ilev=0; ilev<nlevs; ++ilev) {
+          const auto orig = v(icol,ilev);
+          const auto q = vy(icol,ilev);
+          if (orig==fv) {
+            REQUIRE (q==fv);
+            continue;
+          }
+          // Error bound, and trailing bits are zeroed
+          REQUIRE (std::abs(q-orig)<=std::ldexp(std::abs(orig),-(nsb+1)));
+          uint_t bits;
+          std::memcpy(&bits,&q,sizeof(Real));
+          REQUIRE ((bits & ((uint_t(1) << (mantissa_bits-nsb))-1))==0);
+        }
+      }
+
+      // Quantizing twice gives the same result
+      auto z = y.clone();
+      bitround(z,nsb);
+      REQUIRE (views_are_equal(y,z));
+    }
+
+    // Keeping all mantissa bits is a no-op
+    auto y = x.clone();
+    bitround(y,mantissa_bits);
+    REQUIRE (views_are_equal(x,y));
+  }
+}
+
 } // anonymous namespace
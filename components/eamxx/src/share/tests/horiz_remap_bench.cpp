@@ -0,0 +1,102 @@
+// This is a small program to compare the performance of the sparse matrix formats
+// available in the horizontal interpolation remappers, using a real map file.
+// Usage:
+//   horiz_remap_bench map_file=/path/to/map.nc [nlevs=128] [nruns=20]
+
+#include "share/grid/remap/coarsening_remapper.hpp"
+#include "share/grid/point_grid.hpp"
+#include "share/io/eamxx_scorpio_interface.hpp"
+#include "share/field/field_utils.hpp"
+#include "share/eamxx_session.hpp"
+
+#include <ekat_comm.hpp>
+#include <ekat_string_utils.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <map>
+#include <random>
+
+int main (int argc, char** argv) {
+  using namespace scream;
+  using namespace ShortFieldTagsNames;
+
+  MPI_Init(&argc,&argv);
+  scream::initialize_eamxx_session(argc, argv);
+  {
+    ekat::Comm comm(MPI_COMM_WORLD);
+
+    // Parse key=value args
+    std::map<std::string,std::string> args = {{"nlevs","128"},{"nruns","20"}};
+    for (int i=1; i<argc; ++i) {
+      auto tokens = ekat::split(argv[i],'=');
+      if (tokens.size()==2) {
+        args[tokens[0]] = tokens[1];
+      }
+    }
+    EKAT_REQUIRE_MSG (args.count("map_file")==1,
+        "Error! Missing map file. Usage: horiz_remap_bench map_file=<file> [nlevs=<int>] [nruns=<int>]\n");
+    const auto map_file = args["map_file"];
+    const int  nlevs    = std::stoi(args["nlevs"]);
+    const int  nruns    = std::stoi(args["nruns"]);
+
+    scorpio::init_subsystem(comm);
+
+    // Create the fine grid, with the size of the map src grid
+    scorpio::register_file(map_file,scorpio::FileMode::Read);
+    const int ncols_src = scorpio::get_dimlen(map_file,"n_a");
+    scorpio::release_file(map_file);
+    auto src_grid = create_point_grid("src",ncols_src,nlevs,comm);
+
+    auto remap = std::make_shared<CoarseningRemapper>(src_grid,map_file);
+
+    // Remap a 2d and a 3d field, with random values
+    std::mt19937_64 engine(comm.rank());
+    std::uniform_real_distribution<Real> pdf(0,1);
+    const auto units = ekat::units::Units::nondimensional();
+    auto s2d = src_grid->get_2d_scalar_layout();
+    auto s3d = src_grid->get_3d_scalar_layout(true);
+    for (const auto& fl : {s2d,s3d}) {
+      Field src(FieldIdentifier("f"+std::to_string(fl.rank()),fl,units,src_grid->name()));
+      src.get_header().get_alloc_properties().request_allocation(SCREAM_PACK_SIZE);
+      src.allocate_view();
+      randomize(src,engine,pdf);
+      remap->register_field_from_src(src);
+    }
+    remap->registration_ends();
+
+    const auto default_fmt = remap->get_sparse_format();
+    for (auto fmt : {SparseFormat::CRS, SparseFormat::ELL}) {
+      remap->set_sparse_format(fmt);
+
+      // Warm up
+      remap->remap_fwd();
+      Kokkos::fence();
+
+      comm.barrier();
+      auto start = std::chrono::steady_clock::now();
+      for (int i=0; i<nruns; ++i) {
+        remap->remap_fwd();
+      }
+      Kokkos::fence();
+      comm.barrier();
+      auto finish = std::chrono::steady_clock::now();
+
+      double elapsed = std::chrono::duration<double,std::milli>(finish-start).count() / nruns;
+      double max_elapsed;
+      comm.all_reduce(&elapsed,&max_elapsed,1,MPI_MAX);
+      if (comm.am_i_root()) {
+        std::cout << " format: " << e2str(fmt)
+                  << (fmt==default_fmt ? " (default)" : "")
+                  << ", avg remap_fwd time: " << max_elapsed << " ms\n";
+      }
+    }
+
+    remap = nullptr;
+    scorpio::finalize_subsystem();
+  }
+  scream::finalize_eamxx_session();
+  MPI_Finalize();
+
+  return 0;
+}
@@ -5,6 +5,7 @@
 #include "share/property_checks/field_lower_bound_check.hpp"
 #include "share/property_checks/field_upper_bound_check.hpp"
 #include "share/property_checks/field_nan_check.hpp"
+#include "share/property_checks/fused_property_checks.hpp"
 #include "share/util/eamxx_setup_random_test.hpp"
 #include "share/grid/point_grid.hpp"
 #include "share/field/field_utils.hpp"
@@ -309,6 +310,50 @@ TEST_CASE("property_checks", "") {
       REQUIRE(f_data[i] == 1.0);
     }
   }
+
+  SECTION ("fused_property_checks") {
+    // An int field cannot be fused, so its check must always be run
+    FieldIdentifier ifid ("int_field", {tags_data,dims_data}, m/s, "some_grid", DataType::IntType);
+    Field fi(ifid);
+    fi.allocate_view();
+    fi.deep_copy(0);
+
+    f.deep_copy(0.5);
+    data.deep_copy(0.5);
+    auto nan_check = std::make_shared<FieldNaNCheck>(f,grid);
+    auto lb_check  = std::make_shared<FieldLowerBoundCheck>(f,grid,0);
+    auto int_check = std::make_shared<FieldWithinIntervalCheck>(data,grid,0,1);
+    auto int_fi_check = std::make_shared<FieldWithinIntervalCheck>(fi,grid,0,1);
+
+    FusedPropertyChecks fused;
+    fused.set_checks({nan_check,lb_check,int_check,int_fi_check});
+    REQUIRE (fused.num_checks()==4);
+
+    auto needs_check = fused.screen();
+    REQUIRE (needs_check==std::vector<bool>{false,false,false,true});
+
+    // A negative value fails the lower bound check only
+    f.sync_to_host();
+    auto f_view = f.get_strided_view<Real***,Host>();
+    f_view(1,2,3) = -1;
+    f.sync_to_dev();
+    needs_check = fused.screen();
+    REQUIRE (needs_check==std::vector<bool>{false,true,false,true});
+
+    // A NaN fails both the NaN and the lower bound checks
+    f_view(1,2,3) = std::numeric_limits<Real>::quiet_NaN();
+    f.sync_to_dev();
+    data.deep_copy(2.0);
+    needs_check = fused.screen();
+    REQUIRE (needs_check==std::vector<bool>{true,true,true,true});
+    REQUIRE (nan_check->check().result==CheckResult::Fail);
+
+    // Once the fields are fixed, the flags are reset
+    f.deep_copy(0.5);
+    data.deep_copy(0.5);
+    needs_check = fused.screen();
+    REQUIRE (needs_check==std::vector<bool>{false,false,false,true});
+  }
 }
 
 } // anonymous namespace
@@ -26,7 +26,8 @@ public:
     REQUIRE (m_col_size.size()==n);
     REQUIRE (m_col_stride.size()==n);
     REQUIRE (m_col_offset.size()==n);
-    REQUIRE (m_mpi_win.size()==n);
+    REQUIRE (m_mpi_win!=MPI_WIN_NULL);
+    REQUIRE (m_remote_addr.size()==n*static_cast<size_t>(m_comm.size()));
     REQUIRE (m_remote_lids.size()==static_cast<size_t>(m_ov_coarse_grid->get_num_local_dofs()));
     REQUIRE (m_remote_pids.size()==static_cast<size_t>(m_ov_coarse_grid->get_num_local_dofs()));
 
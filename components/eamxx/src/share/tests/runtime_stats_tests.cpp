@@ -0,0 +1,61 @@
+#include <catch2/catch.hpp>
+
+#include "share/util/eamxx_runtime_stats.hpp"
+
+#include <fstream>
+#include <sstream>
+
+TEST_CASE("runtime_stats") {
+  using namespace scream;
+  using namespace ekat::logger;
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  // Not inited: recording is a no-op
+  REQUIRE (not is_runtime_stats_inited());
+  record_runtime_stat("mem",1,"B");
+  REQUIRE (not runtime_stats_end_step(1));
+  finalize_runtime_stats();
+
+  const std::string log_fname = "runtime_stats_tests.np" + std::to_string(comm.size()) + ".log";
+  {
+    using logger_t = Logger<LogBasicFile,LogRootRank>;
+    auto logger = std::make_shared<logger_t>(log_fname,LogLevel::info,comm,"");
+    logger->set_no_format();
+    logger->flush_on(LogLevel::info);
+    logger->set_console_level(LogLevel::off);
+
+    REQUIRE_THROWS (init_runtime_stats(comm,0,logger));
+    REQUIRE_THROWS (init_runtime_stats(comm,1,nullptr));
+
+    const int freq = 3;
+    const int nsteps = 8;
+    init_runtime_stats(comm,freq,logger);
+    REQUIRE (is_runtime_stats_inited());
+    for (int step=1; step<=nsteps; ++step) {
+      // Each rank records a different value, to check the max across ranks
+      record_runtime_stat("mem",step*(comm.rank()+1),"B");
+      REQUIRE (runtime_stats_end_step(step)==(step%freq==0));
+    }
+
+    // The last window (steps 7-8) is only logged at finalization
+    finalize_runtime_stats();
+    REQUIRE (not is_runtime_stats_inited());
+  }
+
+  if (comm.am_i_root()) {
+    std::ifstream ifs(log_fname);
+    std::stringstream ss;
+    ss << ifs.rdbuf();
+    const auto log = ss.str();
+
+    const int n = comm.size();
+    auto expected = [&](const int val, const int beg, const int end) {
+      return "mem: " + std::to_string(val*n) + "B (max over steps " +
+             std::to_string(beg) + "-" + std::to_string(end) + ")";
+    };
+    REQUIRE (log.find(expected(3,1,3))!=std::string::npos);
+    REQUIRE (log.find(expected(6,4,6))!=std::string::npos);
+    REQUIRE (log.find(expected(8,7,8))!=std::string::npos);
+  }
+}
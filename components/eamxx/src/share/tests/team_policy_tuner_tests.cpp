@@ -0,0 +1,173 @@
+#include <catch2/catch.hpp>
+
+#include "share/util/eamxx_team_policy_tuner.hpp"
+#include "share/eamxx_types.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace {
+
+using KT       = scream::KokkosTypes<scream::DefaultDevice>;
+using ExeSpace = KT::ExeSpace;
+
+// Expose the candidate configs
+struct TunedTeamPolicyTester : public scream::TunedTeamPolicy<ExeSpace> {
+  using base_t = scream::TunedTeamPolicy<ExeSpace>;
+  using base_t::base_t;
+  using base_t::get_candidates;
+};
+
+void write_file (const ekat::Comm& comm, const std::string& fname, const std::string& content)
+{
+  if (comm.am_i_root()) {
+    std::ofstream ofs(fname);
+    ofs << content;
+  }
+  comm.barrier();
+}
+
+std::string read_file (const std::string& fname)
+{
+  std::ifstream ifs(fname);
+  std::stringstream ss;
+  ss << ifs.rdbuf();
+  return ss.str();
+}
+
+bool same_config (const scream::TeamPolicyConfig& c1, const scream::TeamPolicyConfig& c2)
+{
+  return c1.team_size==c2.team_size and
+         c1.vector_length==c2.vector_length and
+         c1.chunk_size==c2.chunk_size;
+}
+
+} // anonymous namespace
+
+TEST_CASE("team_policy_tuner") {
+  using namespace scream;
+
+  ekat::Comm comm(MPI_COMM_WORLD);
+
+  const int league_size = 10;
+  const int team_work   = 4;
+  const int conc = ExeSpace().concurrency();
+  const std::string cache_file = "team_policy_cache_np" + std::to_string(comm.size()) + ".txt";
+  const auto key = team_policy_cache_key("test_kernel",conc,league_size,team_work);
+
+  SECTION ("invalid_inputs") {
+    REQUIRE_THROWS (init_team_policy_tuner(comm,"foo",cache_file));
+    REQUIRE_THROWS (init_team_policy_tuner(comm,"use",""));
+    REQUIRE_THROWS (team_policy_cache_key("bad kernel",conc,league_size,team_work));
+
+    // A malformed line in the cache file
+    write_file(comm,cache_file,"bad_kernel 1 2\n");
+    REQUIRE_THROWS (init_team_policy_tuner(comm,"use",cache_file));
+    REQUIRE (not is_team_policy_tuner_inited());
+  }
+
+  SECTION ("off") {
+    init_team_policy_tuner(comm,"off",cache_file);
+    REQUIRE (not is_team_policy_tuner_inited());
+
+    TunedTeamPolicyTester p(comm,"test_kernel",league_size,team_work);
+    REQUIRE (not p.is_tuning());
+    finalize_team_policy_tuner();
+  }
+
+  SECTION ("parse") {
+    write_file(comm,cache_file,
+               "# kernel concurrency league_size team_work team_size vector_length chunk_size\n"
+               "\n"
+               "other_kernel 1 2 3 4 5 6\n");
+    init_team_policy_tuner(comm,"use",cache_file);
+    REQUIRE (is_team_policy_tuner_inited());
+    REQUIRE (not is_team_policy_tuning_on());
+
+    TeamPolicyConfig cfg;
+    REQUIRE (get_cached_team_policy(team_policy_cache_key("other_kernel",1,2,3),cfg));
+    REQUIRE (same_config(cfg,TeamPolicyConfig{4,5,6}));
+    REQUIRE (not get_cached_team_policy(key,cfg));
+
+    // No config for this kernel, and not tuning: use the default policy
+    TunedTeamPolicyTester p(comm,"test_kernel",league_size,team_work);
+    REQUIRE (not p.is_tuning());
+    finalize_team_policy_tuner();
+  }
+
+  SECTION ("tune_and_use") {
+    if (comm.am_i_root()) {
+      std::remove(cache_file.c_str());
+    }
+    comm.barrier();
+
+    using TPF = ekat::TeamPolicyFactory<ExeSpace>;
+    const auto def = TPF::get_default_team_policy(league_size,team_work);
+    const auto candidates = TunedTeamPolicyTester::get_candidates(def);
+    REQUIRE (candidates.size()>1);
+
+    // The default config goes first
+    REQUIRE (candidates[0].team_size==def.team_size());
+    REQUIRE (candidates[0].chunk_size==0);
+
+    init_team_policy_tuner(comm,"tune",cache_file);
+    REQUIRE (is_team_policy_tuning_on());
+
+    TunedTeamPolicyTester p(comm,"test_kernel",league_size,team_work);
+    REQUIRE (p.is_tuning());
+
+    // Launch until all candidates are timed. Results must not depend on the config
+    KT::view_1d<int> v("v",league_size);
+    int num_launches = 0;
+    while (p.is_tuning()) {
+      p.launch("test_kernel", KOKKOS_LAMBDA (const KT::MemberType& team) {
+        Kokkos::single(Kokkos::PerTeam(team),[&]{
+          v(team.league_rank()) += 1;
+        });
+      });
+      ++num_launches;
+    }
+    REQUIRE (num_launches==TunedTeamPolicyTester::num_reps*static_cast<int>(candidates.size()));
+
+    auto v_h = Kokkos::create_mirror_view_and_copy(Kokkos::HostSpace(),v);
+    for (int i=0; i<league_size; ++i) {
+      REQUIRE (v_h(i)==num_launches);
+    }
+
+    // The selected config is one of the candidates, and it is used from now on
+    TeamPolicyConfig best;
+    REQUIRE (get_cached_team_policy(key,best));
+    bool found = false;
+    for (const auto& c : candidates) {
+      found |= same_config(c,best);
+    }
+    REQUIRE (found);
+    REQUIRE (p.get_policy().team_size()==best.team_size);
+
+    // The new entry is written at finalization
+    finalize_team_policy_tuner();
+    REQUIRE (not is_team_policy_tuner_inited());
+    if (comm.am_i_root()) {
+      std::stringstream entry;
+      entry << key << " " << best.team_size << " " << best.vector_length << " " << best.chunk_size << "\n";
+      REQUIRE (read_file(cache_file).find(entry.str())!=std::string::npos);
+    }
+    comm.barrier();
+
+    // In "use" mode, the stored config is picked up without tuning
+    init_team_policy_tuner(comm,"use",cache_file);
+    TeamPolicyConfig cfg;
+    REQUIRE (get_cached_team_policy(key,cfg));
+    REQUIRE (same_config(cfg,best));
+
+    TunedTeamPolicyTester p2(comm,"test_kernel",league_size,team_work);
+    REQUIRE (not p2.is_tuning());
+    const auto policy = p2.get_policy();
+    REQUIRE (policy.team_size()==best.team_size);
+    if (best.chunk_size>0) {
+      REQUIRE (policy.chunk_size()==best.chunk_size);
+    }
+    finalize_team_policy_tuner();
+  }
+}
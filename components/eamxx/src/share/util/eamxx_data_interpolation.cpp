@@ -49,6 +49,17 @@ set_logger (const std::shared_ptr<ekat::logger::LoggerBase>& logger)
   m_logger = logger;
 }
 
+void DataInterpolation::
+set_prefetch (const bool prefetch)
+{
+  m_prefetch = prefetch;
+  if (m_prefetch and not scorpio::async_tasks_supported()) {
+    // The prefetch logic still works, but the reads are done when they are started
+    m_logger->warn("[DataInterpolation] Background data reads require MPI_THREAD_MULTIPLE,\n"
+                   "  which MPI does not provide. Prefetched data will be read synchronously.\n");
+  }
+}
+
 void DataInterpolation::run (const util::TimeStamp& ts)
 {
   EKAT_REQUIRE_MSG (m_data_initialized,
@@ -145,35 +156,83 @@ void DataInterpolation::shift_data_interval ()
   update_end_fields ();
 }
 
-void DataInterpolation::
-update_end_fields ()
+std::vector<Field> DataInterpolation::
+get_reader_fields (const AbstractRemapper& horiz_remapper) const
 {
-  // First, set the correct fields in the reader
   std::vector<Field> fields;
   for (int i=0; i<m_nfields; ++i) {
-    fields.push_back(m_horiz_remapper_end->get_src_field(i));
+    fields.push_back(horiz_remapper.get_src_field(i));
   }
 
   if (m_vr_type==Dynamic3D or m_vr_type==Dynamic3DRef) {
     // We also need to read the src pressure profile
-    fields.push_back(m_horiz_remapper_end->get_src_field(m_nfields));
+    fields.push_back(horiz_remapper.get_src_field(m_nfields));
   }
-  m_reader->set_fields(fields);
+  return fields;
+}
 
-  // If we're also changing the file, must (re)init the scorpio structures
+void DataInterpolation::
+update_end_fields ()
+{
   const auto& slice_beg = m_time_database.slices[m_curr_interval_idx.first];
   const auto& slice_end = m_time_database.slices[m_curr_interval_idx.second];
-  if (m_reader->get_filename()!=slice_end.filename) {
-    m_reader->reset_filename(slice_end.filename);
-  }
 
-  // Read and interpolate fields
   m_logger->info("[DataInterpolation] Reading end of interval fields.");
   m_logger->info(" - interval: [" + slice_beg.time.to_string() + ", " + slice_end.time.to_string() + "]");
   m_logger->info(" - filename: " + slice_end.filename);
   m_logger->info(" - file time idx: " + std::to_string(slice_end.time_idx));
-  m_reader->read_variables(slice_end.time_idx);
+
+  // The prefetch targets the src fields of the beg remapper at the time it was started,
+  // which, after the swap in shift_data_interval, are the src fields of the end remapper.
+  bool prefetched = false;
+  if (m_reader->has_pending_read()) {
+    // If we did not prefetch the right slice (e.g., the model jumped in time), the data
+    // is simply overwritten by the read below
+    m_reader->finish_read_variables();
+    prefetched = m_prefetch_idx==m_curr_interval_idx.second;
+    m_prefetch_idx = -1;
+  }
+
+  if (prefetched) {
+    m_logger->info(" - data was prefetched");
+    ++m_num_prefetched_reads;
+  } else {
+    // First, set the correct fields in the reader
+    m_reader->set_fields(get_reader_fields(*m_horiz_remapper_end));
+
+    // If we're also changing the file, must (re)init the scorpio structures
+    if (m_reader->get_filename()!=slice_end.filename) {
+      m_reader->reset_filename(slice_end.filename);
+    }
+
+    m_reader->read_variables(slice_end.time_idx);
+  }
   m_horiz_remapper_end->remap_fwd();
+
+  if (m_prefetch) {
+    prefetch_next_slice ();
+  }
+}
+
+void DataInterpolation::
+prefetch_next_slice ()
+{
+  // Nothing to prefetch if we are at the end of the data
+  const int curr = m_curr_interval_idx.second;
+  if (curr+1>=m_time_database.size() and m_time_database.timeline!=util::TimeLine::YearlyPeriodic) {
+    return;
+  }
+  const int next = m_time_database.get_next_idx(curr);
+  const auto& slice = m_time_database.slices[next];
+
+  // The beg fields will be the end ones after the next shift. Their src fields are no longer
+  // needed (and, if they alias the tgt ones, the data is only overwritten when finishing the read)
+  m_reader->set_fields(get_reader_fields(*m_horiz_remapper_beg));
+  if (m_reader->get_filename()!=slice.filename) {
+    m_reader->reset_filename(slice.filename);
+  }
+  m_reader->start_read_variables(slice.time_idx);
+  m_prefetch_idx = next;
 }
 
 void DataInterpolation::
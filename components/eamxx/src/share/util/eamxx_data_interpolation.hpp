@@ -63,6 +63,15 @@ public:
 
   void register_fields_in_remappers ();
 
+  // If on, after loading the end-of-interval slice, the following slice is read in the
+  // background (see AtmosphereInput::start_read_variables), so that, when the model crosses
+  // the interval end, only the host-to-device copy and the remaps are left to do.
+  // Must be called before init_data_interval.
+  void set_prefetch (const bool prefetch);
+
+  // Number of end-of-interval slices that were loaded from a prefetch
+  int get_num_prefetched_reads () const { return m_num_prefetched_reads; }
+
   void init_data_interval (const util::TimeStamp& t0);
 
   void run (const util::TimeStamp& ts);
@@ -73,6 +82,8 @@ protected:
 
   void shift_data_interval ();
   void update_end_fields ();
+  void prefetch_next_slice ();
+  std::vector<Field> get_reader_fields (const AbstractRemapper& horiz_remapper) const;
 
   int get_input_files_dimlen (const std::string& dimname) const;
 
@@ -132,6 +143,11 @@ protected:
   bool                  m_time_db_created   = false;
   bool                  m_data_initialized  = false;
 
+  // If prefetching, the index of the slice being read in the background (-1 if none)
+  bool                  m_prefetch          = false;
+  int                   m_prefetch_idx      = -1;
+  int                   m_num_prefetched_reads = 0;
+
   std::shared_ptr<ekat::logger::LoggerBase> m_logger;
 };
 
@@ -0,0 +1,186 @@
+#include "share/util/eamxx_runtime_stats.hpp"
+
+#include <ekat_assert.hpp>
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+namespace scream {
+
+namespace {
+
+using LogLevel = ekat::logger::LogLevel;
+
+struct RuntimeStat {
+  long long   value;
+  std::string units;
+  LogLevel    level;
+};
+
+struct RuntimeStats {
+  bool        inited = false;
+  ekat::Comm  comm;
+  int         frequency;
+  std::shared_ptr<ekat::logger::LoggerBase> logger;
+
+  // Metrics recorded since the last reduction. Using an ordered map ensures
+  // that all ranks pack the metrics in the same order.
+  std::map<std::string,RuntimeStat> window;
+  int window_beg = -1;
+  int last_step  = -1;
+
+  // The reduction in flight (if any), and the metadata needed to log its results
+  MPI_Request request = MPI_REQUEST_NULL;
+  std::vector<std::string>  pending_names;
+  std::vector<RuntimeStat>  pending_stats;
+  std::vector<long long>    send_buf;
+  std::vector<long long>    recv_buf;
+  int pending_beg, pending_end;
+};
+
+RuntimeStats& get_stats () {
+  static RuntimeStats stats;
+  return stats;
+}
+
+// Complete the pending reduction (if any) and log its results.
+// If wait=false, only complete it if it is already done.
+void complete_reduction (RuntimeStats& s, const bool wait) {
+  if (s.request==MPI_REQUEST_NULL) {
+    return;
+  }
+  int done = 1;
+  if (wait) {
+    MPI_Wait(&s.request,MPI_STATUS_IGNORE);
+  } else {
+    MPI_Test(&s.request,&done,MPI_STATUS_IGNORE);
+  }
+  if (not done) {
+    return;
+  }
+
+  std::string steps;
+  if (s.pending_end>s.pending_beg) {
+    steps = " (max over steps " + std::to_string(s.pending_beg) + "-" + std::to_string(s.pending_end) + ")";
+  }
+  for (size_t i=0; i<s.pending_names.size(); ++i) {
+    const auto& stat = s.pending_stats[i];
+    s.logger->log(stat.level, s.pending_names[i] + ": " + std::to_string(s.recv_buf[i]) + stat.units + steps);
+  }
+}
+
+// Post the reduction of the metrics recorded in the current window
+void post_reduction (RuntimeStats& s, const int step) {
+  EKAT_REQUIRE_MSG (s.request==MPI_REQUEST_NULL,
+      "Error! Cannot post a runtime stats reduction while another is still pending.\n");
+  if (s.window.size()==0) {
+    return;
+  }
+
+  s.pending_names.clear();
+  s.pending_stats.clear();
+  s.send_buf.clear();
+  for (const auto& it : s.window) {
+    s.pending_names.push_back(it.first);
+    s.pending_stats.push_back(it.second);
+    s.send_buf.push_back(it.second.value);
+  }
+  s.recv_buf.resize(s.send_buf.size());
+  s.pending_beg = s.window_beg;
+  s.pending_end = step;
+  s.window.clear();
+  s.window_beg = -1;
+
+  MPI_Iallreduce(s.send_buf.data(),s.recv_buf.data(),static_cast<int>(s.send_buf.size()),
+                 MPI_LONG_LONG,MPI_MAX,s.comm.mpi_comm(),&s.request);
+}
+
+} // anonymous namespace
+
+void init_runtime_stats (const ekat::Comm& comm, const int frequency,
+                         const std::shared_ptr<ekat::logger::LoggerBase>& logger)
+{
+  auto& s = get_stats();
+  EKAT_REQUIRE_MSG (not s.inited,
+      "Error! Runtime stats were already inited.\n");
+  EKAT_REQUIRE_MSG (frequency>0,
+      "Error! Invalid runtime stats frequency (" + std::to_string(frequency) + "). Must be positive.\n");
+  EKAT_REQUIRE_MSG (logger!=nullptr,
+      "Error! Invalid logger pointer for runtime stats.\n");
+
+  s.comm = comm;
+  s.frequency = frequency;
+  s.logger = logger;
+  s.inited = true;
+}
+
+void finalize_runtime_stats ()
+{
+  auto& s = get_stats();
+  if (not s.inited) {
+    return;
+  }
+
+  // Log whatever is left, so that the last (partial) window is not lost.
+  // Metrics recorded after the last step are attributed to that step.
+  complete_reduction(s,true);
+  if (s.window.size()>0) {
+    if (s.window_beg<0) {
+      s.window_beg = s.last_step;
+    }
+    post_reduction(s,s.last_step);
+    complete_reduction(s,true);
+  }
+
+  s = RuntimeStats();
+}
+
+bool is_runtime_stats_inited ()
+{
+  return get_stats().inited;
+}
+
+void record_runtime_stat (const std::string& name, const long long value,
+                          const std::string& units, const LogLevel level)
+{
+  auto& s = get_stats();
+  if (not s.inited) {
+    return;
+  }
+
+  auto it = s.window.find(name);
+  if (it==s.window.end()) {
+    s.window.emplace(name,RuntimeStat{value,units,level});
+  } else {
+    it->second.value = std::max(it->second.value,value);
+  }
+}
+
+bool runtime_stats_end_step (const int step)
+{
+  auto& s = get_stats();
+  if (not s.inited) {
+    return false;
+  }
+
+  if (s.window_beg<0) {
+    s.window_beg = step;
+  }
+  s.last_step = step;
+
+  // Log the previous reduction as soon as it is done, without blocking
+  complete_reduction(s,false);
+
+  if (step % s.frequency != 0) {
+    return false;
+  }
+
+  // In the unlikely event that the previous reduction is still in flight,
+  // wait for it, since we only keep one reduction pending at a time.
+  complete_reduction(s,true);
+  post_reduction(s,step);
+  return true;
+}
+
+} // namespace scream
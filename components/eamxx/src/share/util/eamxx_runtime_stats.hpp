@@ -0,0 +1,35 @@
+#ifndef SCREAM_RUNTIME_STATS_HPP
+#define SCREAM_RUNTIME_STATS_HPP
+
+#include <ekat_comm.hpp>
+#include <ekat_logger.hpp>
+
+#include <memory>
+#include <string>
+
+namespace scream {
+
+// Lightweight accumulation of per-step runtime metrics (e.g., memory usage),
+// which are logged without inserting a global synchronization point in every step.
+// On each rank, record_runtime_stat keeps the max of the values recorded for a
+// metric since the last reduction. Every `frequency` steps, runtime_stats_end_step
+// posts a non-blocking max-reduction of all metrics across ranks. The reduction
+// is completed as soon as it is found done at the end of a later step (or, at
+// the latest, when the next reduction is posted), and its results are logged,
+// each at the level given when the metric was recorded.
+// If the subsystem is not inited, recording is a no-op.
+// NOTE: all ranks must record the same metrics. init and finalize are collective.
+void init_runtime_stats (const ekat::Comm& comm, const int frequency,
+                         const std::shared_ptr<ekat::logger::LoggerBase>& logger);
+void finalize_runtime_stats ();
+bool is_runtime_stats_inited ();
+void record_runtime_stat (const std::string& name, const long long value,
+                          const std::string& units = "",
+                          const ekat::logger::LogLevel level = ekat::logger::LogLevel::info);
+
+// Returns true if this step closed a window of the reduction cadence
+bool runtime_stats_end_step (const int step);
+
+} // namespace scream
+
+#endif // SCREAM_RUNTIME_STATS_HPP
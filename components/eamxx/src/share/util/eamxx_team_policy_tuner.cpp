@@ -0,0 +1,153 @@
+#include "share/util/eamxx_team_policy_tuner.hpp"
+
+#include <ekat_assert.hpp>
+
+#include <fstream>
+#include <map>
+#include <sstream>
+
+namespace scream {
+
+namespace {
+
+struct TeamPolicyTuner {
+  bool        inited = false;
+  bool        tune;
+  ekat::Comm  comm;
+  std::string cache_file;
+
+  std::map<std::string,TeamPolicyConfig> configs;
+  bool        modified = false;
+};
+
+TeamPolicyTuner& get_tuner () {
+  static TeamPolicyTuner tuner;
+  return tuner;
+}
+
+} // anonymous namespace
+
+void init_team_policy_tuner (const ekat::Comm& comm, const std::string& mode,
+                             const std::string& cache_file)
+{
+  auto& t = get_tuner();
+  EKAT_REQUIRE_MSG (not t.inited,
+      "Error! The team policy tuner was already inited.\n");
+  EKAT_REQUIRE_MSG (mode=="off" or mode=="use" or mode=="tune",
+      "Error! Invalid team policy tuning mode.\n"
+      "  - input value: " + mode + "\n"
+      "  - valid values: off, use, tune\n");
+  if (mode=="off") {
+    return;
+  }
+  EKAT_REQUIRE_MSG (cache_file!="",
+      "Error! Team policy tuning is on, but the cache file name is empty.\n");
+
+  t.comm = comm;
+  t.tune = mode=="tune";
+  t.cache_file = cache_file;
+
+  // Root reads the cache (if any), and broadcasts its content
+  std::string content;
+  if (comm.am_i_root()) {
+    std::ifstream ifs(cache_file);
+    if (ifs.good()) {
+      std::stringstream ss;
+      ss << ifs.rdbuf();
+      content = ss.str();
+    }
+  }
+  int size = content.size();
+  comm.broadcast(&size,1,comm.root_rank());
+  content.resize(size);
+  if (size>0) {
+    MPI_Bcast(&content[0],size,MPI_CHAR,comm.root_rank(),comm.mpi_comm());
+  }
+
+  // Each line is: kernel concurrency league_size team_work team_size vector_length chunk_size
+  std::map<std::string,TeamPolicyConfig> configs;
+  std::istringstream iss(content);
+  std::string line;
+  while (std::getline(iss,line)) {
+    if (line.empty() or line[0]=='#') {
+      continue;
+    }
+    std::istringstream ls(line);
+    std::string kernel;
+    int conc, league, work;
+    TeamPolicyConfig cfg;
+    ls >> kernel >> conc >> league >> work >> cfg.team_size >> cfg.vector_length >> cfg.chunk_size;
+    EKAT_REQUIRE_MSG (not ls.fail(),
+        "Error! Invalid line in team policy cache file.\n"
+        "  - file name: " + cache_file + "\n"
+        "  - line: " + line + "\n");
+    configs[team_policy_cache_key(kernel,conc,league,work)] = cfg;
+  }
+
+  t.configs = configs;
+  t.inited = true;
+}
+
+void finalize_team_policy_tuner ()
+{
+  auto& t = get_tuner();
+  if (not t.inited) {
+    return;
+  }
+
+  // All ranks select the same configs, so root has all the entries
+  if (t.tune and t.modified and t.comm.am_i_root()) {
+    std::ofstream ofs(t.cache_file);
+    EKAT_REQUIRE_MSG (ofs.good(),
+        "Error! Could not open team policy cache file for writing.\n"
+        "  - file name: " + t.cache_file + "\n");
+    ofs << "# kernel concurrency league_size team_work team_size vector_length chunk_size\n";
+    for (const auto& it : t.configs) {
+      const auto& cfg = it.second;
+      ofs << it.first << " " << cfg.team_size << " " << cfg.vector_length << " " << cfg.chunk_size << "\n";
+    }
+  }
+
+  t = TeamPolicyTuner();
+}
+
+bool is_team_policy_tuning_on ()
+{
+  const auto& t = get_tuner();
+  return t.inited and t.tune;
+}
+
+bool is_team_policy_tuner_inited ()
+{
+  return get_tuner().inited;
+}
+
+std::string team_policy_cache_key (const std::string& kernel, const int concurrency,
+                                   const int league_size, const int team_work)
+{
+  EKAT_REQUIRE_MSG (kernel.find_first_of(" \t\n")==std::string::npos,
+      "Error! Kernel names registered for team policy tuning cannot contain whitespaces.\n"
+      "  - kernel name: " + kernel + "\n");
+  return kernel + " " + std::to_string(concurrency) + " " +
+         std::to_string(league_size) + " " + std::to_string(team_work);
+}
+
+bool get_cached_team_policy (const std::string& key, TeamPolicyConfig& cfg)
+{
+  const auto& t = get_tuner();
+  auto it = t.configs.find(key);
+  if (it==t.configs.end()) {
+    return false;
+  }
+  cfg = it->second;
+  return true;
+}
+
+void set_cached_team_policy (const std::string& key, const TeamPolicyConfig& cfg)
+{
+  auto& t = get_tuner();
+  t.configs[key] = cfg;
+  t.modified = true;
+}
+
+} // namespace scream
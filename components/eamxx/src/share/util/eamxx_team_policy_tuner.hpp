@@ -0,0 +1,186 @@
+#ifndef SCREAM_TEAM_POLICY_TUNER_HPP
+#define SCREAM_TEAM_POLICY_TUNER_HPP
+
+#include <ekat_comm.hpp>
+#include <ekat_kokkos_types.hpp>
+#include <ekat_team_policy_utils.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <string>
+#include <vector>
+
+namespace scream {
+
+// The launch configuration of a team policy. A chunk_size of 0 means the Kokkos default.
+struct TeamPolicyConfig {
+  int team_size;
+  int vector_length;
+  int chunk_size;
+};
+
+// A persistent cache of tuned team policy configurations. Entries are keyed by
+// the kernel name, the exec space concurrency, the league size, and the amount
+// of work per team (e.g., the number of level packs), so that the same cache file
+// can hold the optima of different partitions and column counts per rank.
+//  - mode "off": kernels use the default policy of ekat::TeamPolicyFactory;
+//  - mode "use": kernels use the config in the cache file, if present;
+//  - mode "tune": like "use", but kernels without a cached config are tuned
+//    online, and the new entries are added to the cache file at finalization.
+// NOTE: init and finalize are collective over the input comm.
+void init_team_policy_tuner (const ekat::Comm& comm, const std::string& mode,
+                             const std::string& cache_file);
+void finalize_team_policy_tuner ();
+bool is_team_policy_tuning_on ();
+bool is_team_policy_tuner_inited ();
+
+std::string team_policy_cache_key (const std::string& kernel, const int concurrency,
+                                   const int league_size, const int team_work);
+bool get_cached_team_policy (const std::string& key, TeamPolicyConfig& cfg);
+void set_cached_team_policy (const std::string& key, const TeamPolicyConfig& cfg);
+
+// A team policy for a registered kernel. If a tuned config is cached, it is used
+// right away. Otherwise, if tuning is on, each launch (via the launch method) uses
+// the next candidate config and times it, until all candidates have been timed
+// num_reps times. Then the fastest config (based on the max time across ranks)
+// is selected, and cached. Since tuning happens on the actual launches, the
+// kernel does not need to be idempotent. However, the kernel results must not
+// depend on the team size and vector length (e.g., no team-level reductions),
+// otherwise answers would change during tuning.
+// NOTE: if the tuner is inited, the constructor is collective over the input comm,
+//       and all ranks must launch the kernel the same number of times.
+template<typename ExeSpace>
+class TunedTeamPolicy {
+public:
+  using policy_t = Kokkos::TeamPolicy<ExeSpace>;
+  using TPF      = ekat::TeamPolicyFactory<ExeSpace>;
+
+  static constexpr int num_reps = 3;
+
+  TunedTeamPolicy () = default;
+
+  TunedTeamPolicy (const ekat::Comm& comm, const std::string& kernel,
+                   const int league_size, const int team_work)
+   : m_comm (comm)
+   , m_league_size (league_size)
+   , m_policy (TPF::get_default_team_policy(league_size,team_work))
+  {
+    if (not is_team_policy_tuner_inited()) {
+      return;
+    }
+
+    // Key on the largest league size across ranks, so that all ranks agree on the config
+    int max_league_size;
+    m_comm.all_reduce(&league_size,&max_league_size,1,MPI_MAX);
+    m_key = team_policy_cache_key(kernel,ExeSpace().concurrency(),max_league_size,team_work);
+
+    TeamPolicyConfig cfg;
+    if (get_cached_team_policy(m_key,cfg)) {
+      m_policy = make_policy(cfg);
+    } else if (is_team_policy_tuning_on()) {
+      m_candidates = get_candidates(m_policy);
+      m_times.resize(m_candidates.size(),std::numeric_limits<double>::max());
+      m_curr = 0;
+    }
+  }
+
+  bool is_tuning () const { return m_curr>=0; }
+
+  // The policy to use for the next launch
+  policy_t get_policy () const {
+    return is_tuning() ? make_policy(m_candidates[m_curr % m_candidates.size()]) : m_policy;
+  }
+
+  template<typename Functor>
+  void launch (const std::string& label, const Functor& f) {
+    if (not is_tuning()) {
+      Kokkos::parallel_for(label,m_policy,f);
+      return;
+    }
+
+    using clock = std::chrono::steady_clock;
+    const int icand = m_curr % m_candidates.size();
+    const auto policy = make_policy(m_candidates[icand]);
+    if (policy.team_size()>policy.team_size_max(f,Kokkos::ParallelForTag())) {
+      // This candidate cannot be launched for this functor: use the default one (and never pick it)
+      Kokkos::parallel_for(label,m_policy,f);
+    } else {
+      Kokkos::fence();
+      const auto t0 = clock::now();
+      Kokkos::parallel_for(label,policy,f);
+      Kokkos::fence();
+      const double t = std::chrono::duration<double>(clock::now()-t0).count();
+      m_times[icand] = std::min(m_times[icand],t);
+    }
+
+    ++m_curr;
+    if (m_curr==num_reps*static_cast<int>(m_candidates.size())) {
+      select_best();
+    }
+  }
+
+protected:
+
+  policy_t make_policy (const TeamPolicyConfig& cfg) const {
+    policy_t p(m_league_size,cfg.team_size,cfg.vector_length);
+    if (cfg.chunk_size>0) {
+      p.set_chunk_size(cfg.chunk_size);
+    }
+    return p;
+  }
+
+  static std::vector<TeamPolicyConfig> get_candidates (const policy_t& default_policy) {
+    // The default config goes first, so it wins ties
+    std::vector<TeamPolicyConfig> candidates;
+    const TeamPolicyConfig def {default_policy.team_size(),default_policy.impl_vector_length(),0};
+    candidates.push_back(def);
+    if (ekat::OnGpu<ExeSpace>::value) {
+      // On GPU, try different team sizes (one vector lane per thread)
+      for (int ts : {32, 64, 128, 256}) {
+        if (ts!=def.team_size or def.vector_length!=1) {
+          candidates.push_back(TeamPolicyConfig{ts,1,0});
+        }
+      }
+    } else {
+      // On CPU, try different scheduling chunks of the league over the threads
+      for (int chunk : {1, 4, 16}) {
+        candidates.push_back(TeamPolicyConfig{def.team_size,def.vector_length,chunk});
+      }
+    }
+    return candidates;
+  }
+
+  void select_best () {
+    // Use the max time across ranks, so that all ranks select the same config
+    const int n = m_times.size();
+    std::vector<double> max_times(n);
+    m_comm.all_reduce(m_times.data(),max_times.data(),n,MPI_MAX);
+    int best = 0;
+    for (int i=1; i<n; ++i) {
+      if (max_times[i]<max_times[best]) {
+        best = i;
+      }
+    }
+    m_policy = make_policy(m_candidates[best]);
+    set_cached_team_policy(m_key,m_candidates[best]);
+
+    m_candidates.clear();
+    m_times.clear();
+    m_curr = -1;
+  }
+
+  ekat::Comm    m_comm;
+  std::string   m_key;
+  int           m_league_size = 0;
+  policy_t      m_policy;
+
+  // Tuning state: m_curr is the number of timed launches, or -1 if not tuning
+  std::vector<TeamPolicyConfig> m_candidates;
+  std::vector<double>           m_times;
+  int                           m_curr = -1;
+};
+
+} // namespace scream
+
+#endif // SCREAM_TEAM_POLICY_TUNER_HPP
@@ -304,6 +304,26 @@ void TimeInterpolation::set_file_data_triplets(const vos_type& list_of_files) {
 void TimeInterpolation::read_data()
 {
   const auto triplet_curr = m_file_data_triplets[m_triplet_idx];
+
+  // The prefetch was started while m_fm_time1 stored the current time1 data. The data is
+  // copied in the fields of the field manager set at this point, which, after shift_data,
+  // is the new m_fm_time1. If it's not the triplet we need, the data is overwritten below.
+  if (m_file_data_atm_input and m_file_data_atm_input->has_pending_read()) {
+    m_file_data_atm_input->finish_read_variables();
+    const bool prefetched = m_prefetch_idx==m_triplet_idx;
+    m_prefetch_idx = -1;
+    if (prefetched) {
+      m_logger->info(m_header);
+      m_logger->info("[EAMxx:time_interpolation] Using prefetched data at time " + triplet_curr.timestamp.to_string());
+      m_time1 = triplet_curr.timestamp;
+      ++m_num_prefetched_reads;
+      if (m_prefetch) {
+        prefetch_data();
+      }
+      return;
+    }
+  }
+
   if (not m_file_data_atm_input or triplet_curr.filename != m_file_data_atm_input->get_filename()) {
     // Then we need to close this input stream and open a new one
     ekat::ParameterList input_params;
@@ -317,6 +337,31 @@ void TimeInterpolation::read_data()
   m_logger->info("[EAMxx:time_interpolation] Reading data at time " + triplet_curr.timestamp.to_string());
   m_file_data_atm_input->read_variables(triplet_curr.time_idx);
   m_time1 = triplet_curr.timestamp;
+
+  if (m_prefetch) {
+    prefetch_data();
+  }
+}
+/*-----------------------------------------------------------------------------------------------*/
+/* Function to start reading the data of the triplet following the current one in the background.
+ * The data is copied in the fields at the next call to read_data.
+ */
+void TimeInterpolation::prefetch_data()
+{
+  const int next = m_triplet_idx+1;
+  if (next>=static_cast<int>(m_file_data_triplets.size())) {
+    return;
+  }
+  const auto triplet_next = m_file_data_triplets[next];
+  if (triplet_next.filename != m_file_data_atm_input->get_filename()) {
+    ekat::ParameterList input_params;
+    input_params.set("field_names",m_field_names);
+    input_params.set("filename",triplet_next.filename);
+    m_file_data_atm_input = std::make_shared<AtmosphereInput>(input_params,m_fm_time1);
+    m_file_data_atm_input->set_logger(m_logger);
+  }
+  m_file_data_atm_input->start_read_variables(triplet_next.time_idx);
+  m_prefetch_idx = next;
 }
 /*-----------------------------------------------------------------------------------------------*/
 /* Function to check the current set of interpolation data against a timestamp and, if needed,
@@ -380,6 +425,16 @@ set_logger(const std::shared_ptr<ekat::logger::LoggerBase>& logger,
   m_header = header;
 }
 
+void TimeInterpolation::set_prefetch(const bool prefetch)
+{
+  m_prefetch = prefetch;
+  if (m_prefetch and not scorpio::async_tasks_supported()) {
+    // The prefetch logic still works, but the reads are done when they are started
+    m_logger->warn("[EAMxx:time_interpolation] Background data reads require MPI_THREAD_MULTIPLE,\n"
+                   "  which MPI does not provide. Prefetched data will be read synchronously.\n");
+  }
+}
+
 /*-----------------------------------------------------------------------------------------------*/
 
 } // namespace util
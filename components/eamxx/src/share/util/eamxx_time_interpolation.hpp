@@ -50,6 +50,13 @@ public:
   void set_logger(const std::shared_ptr<ekat::logger::LoggerBase>& logger,
                   const std::string& header);
 
+  // If on (and data comes from files), after reading a new time snap, the following one is
+  // read in the background (see AtmosphereInput::start_read_variables)
+  void set_prefetch(const bool prefetch);
+
+  // Number of time snaps that were loaded from a prefetch
+  int get_num_prefetched_reads() const { return m_num_prefetched_reads; }
+
 protected:
 
   // Internal structure to store data source triplets (when using data from file)
@@ -72,6 +79,7 @@ protected:
   // For the case where forcing data comes from files
   void set_file_data_triplets(const vos_type& list_of_files);
   void read_data();
+  void prefetch_data();
   void check_and_update_data(const TimeStamp& ts_in);
 
   // Local field managers used to store two time snaps of data for interpolation
@@ -90,6 +98,11 @@ protected:
   std::shared_ptr<AtmosphereInput>           m_file_data_atm_input;
   bool                                       m_is_data_from_file=false;
 
+  // If prefetching, the index of the triplet being read in the background (-1 if none)
+  bool                                       m_prefetch=false;
+  int                                        m_prefetch_idx=-1;
+  int                                        m_num_prefetched_reads=0;
+
   std::shared_ptr<ekat::logger::LoggerBase>  m_logger = console_logger(ekat::logger::LogLevel::warn);
   std::string                                m_header;
 }; // class TimeInterpolation
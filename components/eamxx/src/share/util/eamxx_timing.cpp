@@ -1,9 +1,92 @@
 #include "share/util/eamxx_timing.hpp"
 
+#include <ekat_assert.hpp>
+
 #include <gptl.h>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+#include <vector>
+
 namespace scream {
 
+namespace {
+
+// Events only store the id of their name, to keep start/stop allocation-free
+struct TraceEvent {
+  int    name_id;
+  int    subcycle;
+  double begin;  // Microseconds since tracer init
+  double end;
+};
+
+struct EventTracer {
+  using clock = std::chrono::steady_clock;
+
+  // Max nesting depth of the traced regions. Regions nested deeper are not traced.
+  static constexpr int max_depth = 64;
+
+  double now () const {
+    return std::chrono::duration<double,std::micro>(clock::now()-t0).count();
+  }
+
+  int get_name_id (const std::string& name) {
+    auto it = name_ids.find(name);
+    if (it==name_ids.end()) {
+      it = name_ids.emplace(name,static_cast<int>(names.size())).first;
+      names.push_back(name);
+    }
+    return it->second;
+  }
+
+  bool                      inited = false;
+  ekat::Comm                comm;
+  clock::time_point         t0;
+
+  // Names of the traced regions, indexed by their id
+  std::vector<std::string>              names;
+  std::unordered_map<std::string,int>   name_ids;
+
+  // Completed events (ring buffer)
+  std::vector<TraceEvent>   events;
+  long long                 num_events = 0;
+
+  // Stack of the events started but not yet stopped. The depth can exceed
+  // max_depth, in which case the deepest regions are not stored.
+  TraceEvent                open_events[max_depth];
+  int                       depth = 0;
+  long long                 num_too_deep = 0;
+};
+
+EventTracer& get_tracer () {
+  static EventTracer tracer;
+  return tracer;
+}
+
+std::string json_escape (const std::string& s) {
+  std::string out;
+  out.reserve(s.size());
+  for (char c : s) {
+    if (c=='"' or c=='\\') {
+      out += '\\';
+      out += c;
+    } else if (static_cast<unsigned char>(c)<0x20) {
+      char buf[8];
+      std::snprintf(buf,sizeof(buf),"\\u%04x",static_cast<unsigned>(c));
+      out += buf;
+    } else {
+      out += c;
+    }
+  }
+  return out;
+}
+
+} // anonymous namespace
+
 void init_gptl (bool& was_already_inited) {
 #ifdef SCREAM_CIME_BUILD
   was_already_inited = true;
@@ -17,15 +100,168 @@ void finalize_gptl () {
 }
 
 void start_timer (const std::string& name) {
+  start_trace_event(name);
   GPTLstart(name.c_str());
 }
 
 void stop_timer (const std::string& name) {
   GPTLstop(name.c_str());
+  stop_trace_event(name);
 }
 
 void write_timers_to_file (const ekat::Comm& comm, const std::string& fname) {
   GPTLpr_summary_file (comm.mpi_comm(),fname.c_str());
 }
 
+void init_event_tracer (const ekat::Comm& comm, const int capacity) {
+  auto& tracer = get_tracer();
+  EKAT_REQUIRE_MSG (not tracer.inited,
+      "Error! Event tracer was already inited.\n");
+  EKAT_REQUIRE_MSG (capacity>0,
+      "Error! Invalid event tracer capacity.\n"
+      " - capacity: " + std::to_string(capacity) + "\n");
+
+  tracer.comm = comm;
+  tracer.events.resize(capacity);
+  tracer.num_events = 0;
+  tracer.depth = 0;
+  tracer.num_too_deep = 0;
+
+  // Sync, so that the time origin is (roughly) the same on all ranks
+  comm.barrier();
+  tracer.t0 = EventTracer::clock::now();
+  tracer.inited = true;
+}
+
+bool is_event_tracer_inited () {
+  return get_tracer().inited;
+}
+
+void start_trace_event (const std::string& name, const int subcycle) {
+  auto& tracer = get_tracer();
+  if (not tracer.inited) {
+    return;
+  }
+  if (tracer.depth<EventTracer::max_depth) {
+    tracer.open_events[tracer.depth] = TraceEvent{tracer.get_name_id(name),subcycle,tracer.now(),0};
+  }
+  ++tracer.depth;
+}
+
+void stop_trace_event (const std::string& name) {
+  auto& tracer = get_tracer();
+  if (not tracer.inited) {
+    return;
+  }
+  const auto t = tracer.now();
+
+  if (tracer.depth>EventTracer::max_depth) {
+    // The innermost regions were not stored
+    --tracer.depth;
+    ++tracer.num_too_deep;
+    return;
+  }
+
+  // Regions are usually nested, so the event is normally the innermost open one.
+  // If not, look for it further down the stack, and close the gap.
+  auto& open = tracer.open_events;
+  for (int i=tracer.depth-1; i>=0; --i) {
+    if (tracer.names[open[i].name_id]==name) {
+      auto& e = tracer.events[tracer.num_events % tracer.events.size()];
+      e = open[i];
+      e.end = t;
+      ++tracer.num_events;
+      std::copy(open+i+1,open+tracer.depth,open+i);
+      --tracer.depth;
+      return;
+    }
+  }
+}
+
+void finalize_event_tracer (const std::string& fname) {
+  auto& tracer = get_tracer();
+  EKAT_REQUIRE_MSG (tracer.inited,
+      "Error! Event tracer was not inited.\n");
+
+  const auto& comm = tracer.comm;
+  const int rank = comm.rank();
+  const long long capacity = tracer.events.size();
+  const long long nevents  = std::min(tracer.num_events,capacity);
+  const long long first    = tracer.num_events - nevents;
+
+  // Serialize this rank's events, oldest first. Ranks other than the first
+  // also serialize the separator from the previous rank's events.
+  std::ostringstream ss;
+  ss.precision(3);
+  ss << std::fixed;
+  ss << (rank>0 ? ",\n" : "")
+     << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << rank
+     << ",\"args\":{\"name\":\"rank " << rank << "\"}}";
+  for (long long i=first; i<tracer.num_events; ++i) {
+    const auto& e = tracer.events[i % capacity];
+    ss << ",\n{\"name\":\"" << json_escape(tracer.names[e.name_id]) << "\",\"cat\":\"eamxx\",\"ph\":\"X\""
+       << ",\"ts\":" << e.begin << ",\"dur\":" << e.end-e.begin
+       << ",\"pid\":" << rank << ",\"tid\":0";
+    if (e.subcycle>=0) {
+      ss << ",\"args\":{\"subcycle\":" << e.subcycle << "}";
+    }
+    ss << "}";
+  }
+  const auto my_str = ss.str();
+
+  long long num_dropped = first + tracer.num_too_deep;
+  comm.all_reduce(&num_dropped,1,MPI_SUM);
+
+  const std::string header = "{\"traceEvents\":[\n";
+  std::ostringstream footer_ss;
+  footer_ss << "\n],\n\"displayTimeUnit\":\"ms\",\n"
+            << "\"otherData\":{\"num_ranks\":" << comm.size()
+            << ",\"num_dropped_events\":" << num_dropped << "}}\n";
+  const auto footer = footer_ss.str();
+
+  // Each rank writes its events directly into the file, at an offset given by the
+  // sizes of the events of the ranks before it, so that no rank has to hold them all
+  MPI_Offset my_len = my_str.size();
+  MPI_Offset my_offset = 0;
+  MPI_Exscan(&my_len,&my_offset,1,MPI_OFFSET,MPI_SUM,comm.mpi_comm());
+  if (rank==0) {
+    my_offset = 0; // MPI_Exscan leaves the output undefined on rank 0
+  }
+  MPI_Offset tot_len;
+  MPI_Allreduce(&my_len,&tot_len,1,MPI_OFFSET,MPI_SUM,comm.mpi_comm());
+
+  MPI_File fh;
+  int err = MPI_File_open(comm.mpi_comm(),fname.c_str(),MPI_MODE_CREATE | MPI_MODE_WRONLY,
+                          MPI_INFO_NULL,&fh);
+  EKAT_REQUIRE_MSG (err==MPI_SUCCESS,
+      "Error! Could not open event trace file.\n"
+      " - file name: " + fname + "\n");
+  MPI_File_set_size(fh,0);
+
+  // Write in chunks, since MPI counts are int
+  auto write_at = [&](MPI_Offset offset, const std::string& str) {
+    constexpr MPI_Offset max_chunk = std::numeric_limits<int>::max();
+    for (MPI_Offset pos=0; pos<static_cast<MPI_Offset>(str.size()); pos+=max_chunk) {
+      const int count = std::min<MPI_Offset>(max_chunk,str.size()-pos);
+      err = MPI_File_write_at(fh,offset+pos,str.data()+pos,count,MPI_CHAR,MPI_STATUS_IGNORE);
+      EKAT_REQUIRE_MSG (err==MPI_SUCCESS,
+          "Error! Could not write to event trace file.\n"
+          " - file name: " + fname + "\n");
+    }
+  };
+  if (rank==0) {
+    write_at(0,header);
+    write_at(header.size()+tot_len,footer);
+  }
+  write_at(header.size()+my_offset,my_str);
+  MPI_File_close(&fh);
+
+  tracer.events.clear();
+  tracer.names.clear();
+  tracer.name_ids.clear();
+  tracer.num_events = 0;
+  tracer.depth = 0;
+  tracer.inited = false;
+}
+
 } // namespace scream
@@ -10,6 +10,7 @@ namespace scream {
 // The following simply wrap GPTL calls. We encourage using
 // these (rather than raw GPTL calls), to make SCREAM insensitive
 // to any future refactor that might change how we do timing.
+// If the event tracer is inited, start/stop_timer also trace the timed region.
 void init_gptl (bool& was_already_inited);
 void finalize_gptl ();
 void start_timer (const std::string& name);
@@ -17,6 +18,23 @@ void stop_timer (const std::string& name);
 
 void write_timers_to_file (const ekat::Comm& comm, const std::string& fname);
 
+// A low-overhead event tracer. On each rank, the begin/end times of the traced
+// regions are stored in a ring buffer with fixed capacity (once full, the oldest
+// events are overwritten). Region names are stored once, and events refer to them
+// by id; regions nested more than 64 levels deep are not traced. At finalization, the events of all ranks are written
+// to a single JSON file in Chrome trace format (one row per rank), which can be
+// opened with chrome://tracing or Perfetto, to inspect load imbalance and
+// serialization across ranks. If the tracer is not inited, tracing is a no-op.
+// The subcycle index (if non-negative) is stored as an argument of the event.
+// Callers that build the region name on the fly should check is_event_tracer_inited
+// first, to avoid the cost when tracing is off.
+// NOTE: init and finalize are collective over the input comm.
+void init_event_tracer (const ekat::Comm& comm, const int capacity);
+void finalize_event_tracer (const std::string& fname);
+bool is_event_tracer_inited ();
+void start_trace_event (const std::string& name, const int subcycle = -1);
+void stop_trace_event (const std::string& name);
+
 } // namespace scream
 
 #endif // SCREAM_TIMING_HPP
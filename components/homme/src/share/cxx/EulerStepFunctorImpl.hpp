@@ -23,6 +23,7 @@
 #include "mpi/BoundaryExchange.hpp"
 #include "mpi/MpiBuffersManager.hpp"
 #include "mpi/Connectivity.hpp"
+#include "mpi/ExchangeScheduler.hpp"
 #include "utilities/SubviewUtils.hpp"
 #include "utilities/VectorUtils.hpp"
 #include "vector/vector_pragmas.hpp"
@@ -60,7 +61,7 @@ struct SerialLimiter<HommexxGPU> {
 class EulerStepFunctorImpl {
   struct EulerStepData {
     EulerStepData ()
-      : qsize(-1), limiter_option(0), nu_p(0), nu_q(0), consthv(1)
+      : qsize(-1), limiter_option(0), nu_p(0), nu_q(0), consthv(1), fuse_exchanges(false)
     {}
 
     int   qsize;
@@ -78,6 +79,7 @@ class EulerStepFunctorImpl {
     DSSOption   DSSopt;
 
     bool consthv;
+    bool fuse_exchanges;
   };
 
   struct Buffers {
@@ -112,6 +114,7 @@ class EulerStepFunctorImpl {
 
   std::shared_ptr<BoundaryExchange> m_mm_be, m_mmqb_be;
   Kokkos::Array<std::shared_ptr<BoundaryExchange>, 3*Q_NUM_TIME_LEVELS> m_bes;
+  ExchangeScheduler m_exchange_scheduler;
 
   enum { m_mem_per_team = 2 * NP * NP * sizeof(Real) };
 
@@ -165,6 +168,7 @@ public:
     m_data.nu_p = params.nu_p;
     m_data.nu_q = params.nu_q;
     m_data.consthv = (params.hypervis_scaling == 0);
+    m_data.fuse_exchanges = params.be_fuse_exchanges;
 
     if (m_data.limiter_option == 4) {
       std::string msg = "[EulerStepFunctorImpl::reset]:";
@@ -271,6 +275,9 @@ public:
       be.register_min_max_fields(m_tracers.qlim, m_data.qsize, 0);
       be.registration_completed();
     }
+
+    // The BE's above were (re)created, so the fused BE's must be rebuilt
+    m_exchange_scheduler.set_buffers_manager(bm_exchange);
   }
 
   static size_t limiter_team_shmem_size (const int team_size) {
@@ -588,6 +595,17 @@ public:
   }
 
   void minmax_and_biharmonic() {
+    if (m_data.fuse_exchanges) {
+      // qlim is not used by the biharmonic, so the min/max exchange can be
+      // done in the same message round as the biharmonic DSS.
+      compute_biharmonic_pre();
+      m_exchange_scheduler.defer(m_mm_be);
+      m_exchange_scheduler.defer(m_mmqb_be,true);
+      m_exchange_scheduler.flush(m_geometry.m_rspheremp);
+      compute_biharmonic_post();
+      return;
+    }
+
     neighbor_minmax_start();
     compute_biharmonic_pre();
     m_mmqb_be->exchange(m_geometry.m_rspheremp);
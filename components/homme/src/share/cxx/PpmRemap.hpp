@@ -67,6 +67,9 @@ static constexpr int DMA_LEV = DMA_PHYSICAL_LEV / VECTOR_SIZE;
 static constexpr int AI_PHYSICAL_LEV = NUM_PHYSICAL_LEV + 1;
 static constexpr int AI_LEV = AI_PHYSICAL_LEV / VECTOR_SIZE;
 
+// number of fields remapped together by the batched remap phase
+static constexpr int FIELD_BLOCK = 8;
+
 } // namespace _ppm_consts
 
 struct PpmBoundaryConditions {};
@@ -75,19 +78,23 @@ struct PpmBoundaryConditions {};
 struct PpmMirrored : public PpmBoundaryConditions {
   static constexpr int fortran_remap_alg = 1;
 
+  // The cell means and coefficients views are templated, since the batched
+  // remap phase passes strided subviews of its buffers.
+  template <typename CellMeansView, typename CoeffsView>
   KOKKOS_INLINE_FUNCTION
   static void apply_ppm_boundary(
-      ExecViewUnmanaged<const Real[_ppm_consts::AO_PHYSICAL_LEV]> /* cell_means */,
-      ExecViewUnmanaged<Real[3][NUM_PHYSICAL_LEV]> /* parabola_coeffs */)
+      const CellMeansView& /* cell_means */,
+      const CoeffsView& /* parabola_coeffs */)
   {
     // Nothing to do here
   }
 
+  template <typename CellMeansView>
   KOKKOS_INLINE_FUNCTION
   static void fill_cell_means_gs(
       KernelVariables &kv,
       const ExecViewUnmanaged<Real[_ppm_consts::DPO_PHYSICAL_LEV]>&,
-      ExecViewUnmanaged<Real[_ppm_consts::AO_PHYSICAL_LEV]> cell_means) {
+      const CellMeansView& cell_means) {
     const int gs = _ppm_consts::gs;
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, gs),
                          [&](const int &k_0) {
@@ -108,9 +115,9 @@ struct PpmMirrored : public PpmBoundaryConditions {
 struct PpmLimitedExtrap : public PpmBoundaryConditions {
   static constexpr int fortran_remap_alg = 10;
 
+  template <typename CellMeansView, typename CoeffsView>
   KOKKOS_INLINE_FUNCTION static void apply_ppm_boundary (
-    const ExecViewUnmanaged<const Real[_ppm_consts::AO_PHYSICAL_LEV]>&,
-    const ExecViewUnmanaged<Real[3][NUM_PHYSICAL_LEV]>&)
+    const CellMeansView&, const CoeffsView&)
   {
     // Nothing to do here
   }
@@ -133,9 +140,10 @@ struct PpmLimitedExtrap : public PpmBoundaryConditions {
     y4 = max(lo, min(hi, y4));
   }
 
+  template <typename CellMeansView>
   KOKKOS_INLINE_FUNCTION static void fill_cell_means_gs (
     KernelVariables& kv, const ExecViewUnmanaged<Real[_ppm_consts::DPO_PHYSICAL_LEV]>& dpo,
-    const ExecViewUnmanaged<Real[_ppm_consts::AO_PHYSICAL_LEV]>& ao)
+    const CellMeansView& ao)
   {
     using Kokkos::parallel_reduce;
     using Kokkos::Min;
@@ -170,7 +178,12 @@ struct PpmVertRemap : public VertRemapAlg {
                 "boundary condition");
   const int gs = _ppm_consts::gs;
 
-  explicit PpmVertRemap(const int num_elems, const int num_remap)
+  static constexpr int field_block = _ppm_consts::FIELD_BLOCK;
+
+  // If batched=true, allocate the buffers needed by compute_remap_phase_batched.
+  // On GPU, we prefer one field per team, which exposes more parallelism.
+  explicit PpmVertRemap(const int num_elems, const int num_remap,
+                        const bool batched = !OnGpu<ExecSpace>::value)
       : m_dpo("dpo", num_elems)
       , m_pio("pio", num_elems)
       , m_pin("pin", num_elems)
@@ -183,10 +196,20 @@ struct PpmVertRemap : public VertRemapAlg {
       , m_dma("dma", m_ppm_tu.get_num_ws_slots())
       , m_ai("ai", m_ppm_tu.get_num_ws_slots())
       , m_parabola_coeffs("Coefficients for the interpolating parabola", m_ppm_tu.get_num_ws_slots())
+      , m_batched(batched)
   {
-    // Nothing to do here
+    if (m_batched) {
+      const int num_slots = m_ppm_tu.get_num_ws_slots();
+      m_ao_b = decltype(m_ao_b)("a0 batched", num_slots);
+      m_mass_o_b = decltype(m_mass_o_b)("mass_o batched", num_slots);
+      m_dma_b = decltype(m_dma_b)("dma batched", num_slots);
+      m_ai_b = decltype(m_ai_b)("ai batched", num_slots);
+      m_parabola_coeffs_b = decltype(m_parabola_coeffs_b)("Coefficients for the interpolating parabolas", num_slots);
+    }
   }
 
+  bool is_batched () const { return m_batched; }
+
   KOKKOS_INLINE_FUNCTION
   void compute_grids_phase(
       KernelVariables &kv,
@@ -255,6 +278,86 @@ struct PpmVertRemap : public VertRemapAlg {
     kv.team_barrier();
   }
 
+  // Same as compute_remap_phase, but remaps num_fields<=field_block fields at once.
+  // The grid quantities of each column are loaded once for all the fields, and
+  // the reconstruction loops are vectorized across the fields, which are stored
+  // innermost in the buffers. get_field(i) must return the i-th field to remap.
+  // The result is BFB with compute_remap_phase on CPU.
+  template <typename FieldGetter>
+  KOKKOS_INLINE_FUNCTION
+  void compute_remap_phase_batched(KernelVariables &kv, const int num_fields,
+                                   const FieldGetter& get_field) const {
+    assert(m_batched);
+    assert(num_fields > 0 && num_fields <= field_block);
+
+    ExecViewUnmanaged<Scalar[NP][NP][NUM_LEV]> fields[field_block];
+    for (int i = 0; i < num_fields; ++i) {
+      fields[i] = get_field(i);
+    }
+
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(kv.team, NP * NP),
+                         [&](const int &loop_idx) {
+      using Kokkos::ALL;
+      const int igp = loop_idx / NP;
+      const int jgp = loop_idx % NP;
+      const auto fields_range = Kokkos::ThreadVectorRange(kv.team, num_fields);
+
+      const auto dpo    = Homme::subview(m_dpo, kv.ie, igp, jgp);
+      const auto ao     = Kokkos::subview(m_ao_b, kv.team_idx, igp, jgp, ALL, ALL);
+      const auto mass_o = Kokkos::subview(m_mass_o_b, kv.team_idx, igp, jgp, ALL, ALL);
+      const auto coeffs = Kokkos::subview(m_parabola_coeffs_b, kv.team_idx, igp, jgp, ALL, ALL, ALL);
+
+      // Cell means, and old mass up to old grid cell interface locations
+      Kokkos::parallel_for(fields_range, [&](const int i) {
+        mass_o(0, i) = 0.0;
+      });
+      for (int k = 0; k < NUM_PHYSICAL_LEV; ++k) {
+        const int ilevel = k / VECTOR_SIZE;
+        const int ivector = k % VECTOR_SIZE;
+        const Real dp = dpo(k + _ppm_consts::INITIAL_PADDING);
+        Kokkos::parallel_for(fields_range, [&](const int i) {
+          const Real val = fields[i](igp, jgp, ilevel)[ivector];
+          ao(k + _ppm_consts::INITIAL_PADDING, i) = val / dp;
+          mass_o(k + 1, i) = mass_o(k, i) + val;
+        });
+      }
+
+      for (int i = 0; i < num_fields; ++i) {
+        boundaries::fill_cell_means_gs(kv, dpo, Kokkos::subview(ao, ALL, i));
+      }
+
+      compute_ppm_batched(kv, num_fields, ao,
+                          Homme::subview(m_ppmdx, kv.ie, igp, jgp),
+                          Kokkos::subview(m_dma_b, kv.team_idx, igp, jgp, ALL, ALL),
+                          Kokkos::subview(m_ai_b, kv.team_idx, igp, jgp, ALL, ALL),
+                          coeffs);
+
+      // Integrate the parabolas up to the new interfaces, as in compute_remap
+      const auto k_id = Homme::subview(m_kid, kv.ie, igp, jgp);
+      const auto integral_bounds = Homme::subview(m_z2, kv.ie, igp, jgp);
+      Real mass1[field_block];
+      Kokkos::parallel_for(fields_range, [&](const int i) {
+        mass1[i] = 0;
+      });
+      for (int k = 0; k < NUM_PHYSICAL_LEV; ++k) {
+        const int ilevel = k / VECTOR_SIZE;
+        const int ivector = k % VECTOR_SIZE;
+        const int kk_cur_lev = k_id(k);
+        assert(kk_cur_lev < coeffs.extent_int(1));
+        const Real x2_cur_lev = integral_bounds(k);
+        const Real dp = dpo(kk_cur_lev + _ppm_consts::INITIAL_PADDING);
+        Kokkos::parallel_for(fields_range, [&](const int i) {
+          const Real mass2 = compute_mass(
+              coeffs(2, kk_cur_lev, i), coeffs(1, kk_cur_lev, i),
+              coeffs(0, kk_cur_lev, i), mass_o(kk_cur_lev, i), dp, x2_cur_lev);
+          fields[i](igp, jgp, ilevel)[ivector] = mass2 - mass1[i];
+          mass1[i] = mass2;
+        });
+      }
+    }); // End team thread range
+    kv.team_barrier();
+  }
+
   KOKKOS_FORCEINLINE_FUNCTION
   Real compute_mass(const Real sq_coeff, const Real lin_coeff,
                     const Real const_coeff, const Real prev_mass,
@@ -392,6 +495,53 @@ struct PpmVertRemap : public VertRemapAlg {
     });
   }
 
+  // Monotonized slope at ppm grid point j, given the cell means of the
+  // cells j-2, j-1, j (in padded indexing).
+  KOKKOS_FORCEINLINE_FUNCTION
+  static Real limited_slope(
+      const ExecViewUnmanaged<const Real[10][_ppm_consts::PPMDX_PHYSICAL_LEV]>& dx,
+      const int j, const Real am2, const Real am1, const Real a0) {
+    if ((a0 - am1) * (am1 - am2) > 0.0) {
+      const Real da = dx(0, j) * (dx(1, j) * (a0 - am1) + dx(2, j) * (am1 - am2));
+      return min(fabs(da), 2.0 * fabs(am1 - am2), 2.0 * fabs(a0 - am1)) *
+             copysign(1.0, da);
+    }
+    return 0.0;
+  }
+
+  // Value at the interface j, between the cells with means am1 and a0
+  KOKKOS_FORCEINLINE_FUNCTION
+  static Real interface_value(
+      const ExecViewUnmanaged<const Real[10][_ppm_consts::PPMDX_PHYSICAL_LEV]>& dx,
+      const int j, const Real am1, const Real a0, const Real dma_j, const Real dma_jp1) {
+    return am1 + dx(3, j) * (a0 - am1) +
+           dx(4, j) * (dx(5, j) * (dx(6, j) - dx(7, j)) * (a0 - am1) -
+                       dx(8, j) * dma_jp1 + dx(9, j) * dma_j);
+  }
+
+  // Coefficients of the monotone parabola in a cell with mean a and edge values al, ar
+  KOKKOS_FORCEINLINE_FUNCTION
+  static void compute_parabola(const Real a, Real al, Real ar,
+                               Real& c0, Real& c1, Real& c2) {
+    if ((ar - a) * (a - al) <= 0.) {
+      al = a;
+      ar = a;
+    }
+    if ((ar - al) * (a - (al + ar) / 2.0) > (ar - al) * (ar - al) / 6.0) {
+      al = 3.0 * a - 2.0 * ar;
+    }
+    if ((ar - al) * (a - (al + ar) / 2.0) < -(ar - al) * (ar - al) / 6.0) {
+      ar = 3.0 * a - 2.0 * al;
+    }
+
+    // Computed these coefficients from the edge values
+    // and cell mean in Maple. Assumes normalized
+    // coordinates: xi=(x-x0)/dx
+    c0 = 1.5 * a - (al + ar) / 4.0;
+    c1 = ar - al;
+    c2 = 3.0 * (-2.0 * a + (al + ar));
+  }
+
   KOKKOS_INLINE_FUNCTION
   void compute_ppm(KernelVariables &kv,
       // input  views
@@ -408,72 +558,30 @@ struct PpmVertRemap : public VertRemapAlg {
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team,
                                                    NUM_PHYSICAL_LEV + 2),
                          [&](const int j) {
-      if ((cell_means(j + INITIAL_PADDING) -
-           cell_means(j + INITIAL_PADDING - 1)) *
-              (cell_means(j + INITIAL_PADDING - 1) -
-               cell_means(j + INITIAL_PADDING - gs)) >
-          0.0) {
-        Real da =
-            dx(0, j) * (dx(1, j) * (cell_means(j + INITIAL_PADDING) -
-                                    cell_means(j + INITIAL_PADDING - 1)) +
-                        dx(2, j) * (cell_means(j + INITIAL_PADDING - 1) -
-                                    cell_means(j + INITIAL_PADDING - gs)));
-
-        dma(j) = min(fabs(da), 2.0 * fabs(cell_means(j + INITIAL_PADDING - 1) -
-                                          cell_means(j + INITIAL_PADDING - gs)),
-                     2.0 * fabs(cell_means(j + INITIAL_PADDING) -
-                                cell_means(j + INITIAL_PADDING - 1))) *
-                 copysign(1.0, da);
-      } else {
-        dma(j) = 0.0;
-      }
+      dma(j) = limited_slope(dx, j, cell_means(j + INITIAL_PADDING - gs),
+                             cell_means(j + INITIAL_PADDING - 1),
+                             cell_means(j + INITIAL_PADDING));
     });
 
     Kokkos::parallel_for(
         Kokkos::ThreadVectorRange(kv.team, NUM_PHYSICAL_LEV + 1),
         [&](const int j) {
-          ai(j) = cell_means(j + INITIAL_PADDING - 1) +
-                  dx(3, j) * (cell_means(j + INITIAL_PADDING) -
-                              cell_means(j + INITIAL_PADDING - 1)) +
-                  dx(4, j) * (dx(5, j) * (dx(6, j) - dx(7, j)) *
-                                  (cell_means(j + INITIAL_PADDING) -
-                                   cell_means(j + INITIAL_PADDING - 1)) -
-                              dx(8, j) * dma(j + 1) + dx(9, j) * dma(j));
+          ai(j) = interface_value(dx, j, cell_means(j + INITIAL_PADDING - 1),
+                                  cell_means(j + INITIAL_PADDING),
+                                  dma(j), dma(j + 1));
         });
 
     Kokkos::parallel_for(Kokkos::ThreadVectorRange(kv.team, NUM_PHYSICAL_LEV),
                          [&](const int j_prev) {
       const int j = j_prev + 1;
-      Real al = ai(j - 1);
-      Real ar = ai(j);
-      if ((ar - cell_means(j + INITIAL_PADDING - 1)) *
-              (cell_means(j + INITIAL_PADDING - 1) - al) <=
-          0.) {
-        al = cell_means(j + INITIAL_PADDING - 1);
-        ar = cell_means(j + INITIAL_PADDING - 1);
-      }
-      if ((ar - al) * (cell_means(j + INITIAL_PADDING - 1) - (al + ar) / 2.0) >
-          (ar - al) * (ar - al) / 6.0) {
-        al = 3.0 * cell_means(j + INITIAL_PADDING - 1) - 2.0 * ar;
-      }
-      if ((ar - al) * (cell_means(j + INITIAL_PADDING - 1) - (al + ar) / 2.0) <
-          -(ar - al) * (ar - al) / 6.0) {
-        ar = 3.0 * cell_means(j + INITIAL_PADDING - 1) - 2.0 * al;
-      }
-
-      // Computed these coefficients from the edge values
-      // and cell mean in Maple. Assumes normalized
-      // coordinates: xi=(x-x0)/dx
 
       assert(parabola_coeffs.data() != nullptr);
       assert(j - 1 < parabola_coeffs.extent_int(1));
       assert(2 < parabola_coeffs.extent_int(0));
 
-      parabola_coeffs(0, j - 1) =
-          1.5 * cell_means(j + INITIAL_PADDING - 1) - (al + ar) / 4.0;
-      parabola_coeffs(1, j - 1) = ar - al;
-      parabola_coeffs(2, j - 1) =
-          3.0 * (-2.0 * cell_means(j + INITIAL_PADDING - 1) + (al + ar));
+      compute_parabola(cell_means(j + INITIAL_PADDING - 1), ai(j - 1), ai(j),
+                       parabola_coeffs(0, j - 1), parabola_coeffs(1, j - 1),
+                       parabola_coeffs(2, j - 1));
     });
 
     Kokkos::single(Kokkos::PerThread(kv.team), [&]() {
@@ -481,6 +589,52 @@ struct PpmVertRemap : public VertRemapAlg {
     });
   }
 
+  // Same as compute_ppm, for a block of fields. The field index is the last
+  // one in all views, so that the inner loops are contiguous.
+  template <typename CellMeansView, typename DmaView, typename AiView, typename CoeffsView>
+  KOKKOS_INLINE_FUNCTION
+  void compute_ppm_batched(KernelVariables &kv, const int num_fields,
+      const CellMeansView& cell_means,
+      const ExecViewUnmanaged<const Real[10][_ppm_consts::PPMDX_PHYSICAL_LEV]>& dx,
+      const DmaView& dma, const AiView& ai,
+      const CoeffsView& parabola_coeffs) const
+  {
+    using Kokkos::ALL;
+    const int INITIAL_PADDING = _ppm_consts::INITIAL_PADDING;
+    const auto fields_range = Kokkos::ThreadVectorRange(kv.team, num_fields);
+
+    for (int j = 0; j < NUM_PHYSICAL_LEV + 2; ++j) {
+      Kokkos::parallel_for(fields_range, [&](const int i) {
+        dma(j, i) = limited_slope(dx, j, cell_means(j + INITIAL_PADDING - gs, i),
+                                  cell_means(j + INITIAL_PADDING - 1, i),
+                                  cell_means(j + INITIAL_PADDING, i));
+      });
+    }
+
+    for (int j = 0; j < NUM_PHYSICAL_LEV + 1; ++j) {
+      Kokkos::parallel_for(fields_range, [&](const int i) {
+        ai(j, i) = interface_value(dx, j, cell_means(j + INITIAL_PADDING - 1, i),
+                                   cell_means(j + INITIAL_PADDING, i),
+                                   dma(j, i), dma(j + 1, i));
+      });
+    }
+
+    for (int j = 0; j < NUM_PHYSICAL_LEV; ++j) {
+      Kokkos::parallel_for(fields_range, [&](const int i) {
+        compute_parabola(cell_means(j + INITIAL_PADDING, i), ai(j, i), ai(j + 1, i),
+                         parabola_coeffs(0, j, i), parabola_coeffs(1, j, i),
+                         parabola_coeffs(2, j, i));
+      });
+    }
+
+    Kokkos::single(Kokkos::PerThread(kv.team), [&]() {
+      for (int i = 0; i < num_fields; ++i) {
+        boundaries::apply_ppm_boundary(Kokkos::subview(cell_means, ALL, i),
+                                       Kokkos::subview(parabola_coeffs, ALL, ALL, i));
+      }
+    });
+  }
+
   KOKKOS_INLINE_FUNCTION
   void compute_partitions(
       KernelVariables &kv,
@@ -666,6 +820,15 @@ struct PpmVertRemap : public VertRemapAlg {
   ExecViewManaged<Real * [NP][NP][_ppm_consts::DMA_PHYSICAL_LEV]> m_dma;
   ExecViewManaged<Real * [NP][NP][_ppm_consts::AI_PHYSICAL_LEV]> m_ai;
   ExecViewManaged<Real * [NP][NP][3][NUM_PHYSICAL_LEV]> m_parabola_coeffs;
+
+  // Buffers for the batched remap phase (only allocated if m_batched=true).
+  // The last index is the field index within the block.
+  bool m_batched;
+  ExecViewManaged<Real * [NP][NP][_ppm_consts::AO_PHYSICAL_LEV][_ppm_consts::FIELD_BLOCK]> m_ao_b;
+  ExecViewManaged<Real * [NP][NP][_ppm_consts::MASS_O_PHYSICAL_LEV][_ppm_consts::FIELD_BLOCK]> m_mass_o_b;
+  ExecViewManaged<Real * [NP][NP][_ppm_consts::DMA_PHYSICAL_LEV][_ppm_consts::FIELD_BLOCK]> m_dma_b;
+  ExecViewManaged<Real * [NP][NP][_ppm_consts::AI_PHYSICAL_LEV][_ppm_consts::FIELD_BLOCK]> m_ai_b;
+  ExecViewManaged<Real * [NP][NP][3][NUM_PHYSICAL_LEV][_ppm_consts::FIELD_BLOCK]> m_parabola_coeffs_b;
 };
 
 } // namespace Ppm
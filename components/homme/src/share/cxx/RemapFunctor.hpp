@@ -360,6 +360,8 @@ struct RemapFunctor : public Remapper {
   struct ComputeThicknessTag {};
   struct ComputeGridsTag {};
   struct ComputeRemapTag {};
+  // Remaps a block of fields of an element at once
+  struct ComputeBatchedRemapTag {};
   // Computes the extrinsic values of the states in the initial map
   // i.e. velocity -> momentum
   struct ComputeExtrinsicsTag {};
@@ -421,6 +423,26 @@ struct RemapFunctor : public Remapper {
     this->m_remap.compute_remap_phase(kv, get_remap_val(kv, var));
   }
 
+  KOKKOS_INLINE_FUNCTION
+  int num_remap_blocks() const {
+    return (num_to_remap() + RemapType::field_block - 1) / RemapType::field_block;
+  }
+
+  // This asserts if num_to_remap() == 0
+  KOKKOS_INLINE_FUNCTION
+  void operator()(ComputeBatchedRemapTag, const TeamMember &team) const {
+    KernelVariables kv(team, m_tu_ne_ntr);
+    assert(num_to_remap() != 0);
+    const int block = kv.ie % num_remap_blocks();
+    kv.ie /= num_remap_blocks();
+    assert(kv.ie < m_state.num_elems());
+
+    const int first = block * RemapType::field_block;
+    const int num_fields = min(RemapType::field_block, num_to_remap() - first);
+    this->m_remap.compute_remap_phase_batched(kv, num_fields,
+        [&](const int i) { return get_remap_val(kv, first + i); });
+  }
+
   KOKKOS_INLINE_FUNCTION
   void operator()(ComputeIntrinsicsTag, const TeamMember &team) const {
     KernelVariables kv(team, m_tu_ne_nsr);
@@ -473,8 +495,13 @@ struct RemapFunctor : public Remapper {
       }
       run_functor<ComputeGridsTag>("Remap Compute Grids Functor",
                                    m_state.num_elems());
-      run_functor<ComputeRemapTag>("Remap Compute Remap Functor",
-                                   m_state.num_elems() * num_to_remap());
+      if (m_remap.is_batched()) {
+        run_functor<ComputeBatchedRemapTag>("Remap Compute Remap Functor",
+                                            m_state.num_elems() * num_remap_blocks());
+      } else {
+        run_functor<ComputeRemapTag>("Remap Compute Remap Functor",
+                                     m_state.num_elems() * num_to_remap());
+      }
       if (nonzero_rsplit) {
         run_functor<ComputeIntrinsicsTag>("Remap Rescale States Functor",
                                           m_state.num_elems() * m_fields_provider.num_states_remap());
@@ -69,6 +69,27 @@ struct SimulationParams
   // to >0 for diagnostics.
   int       internal_diagnostics_level = 0;
 
+  // If true, caar computes the boundary elements first, and overlaps the
+  // boundary exchange with the computation on the interior elements.
+  bool      caar_overlap_exchange = false;
+
+  // If true, boundary exchanges use MPI neighborhood collectives over the
+  // connectivity graph, rather than point-to-point messages.
+  bool      be_neighbor_collectives = false;
+
+  // If true, boundary exchanges whose inputs are ready at the same time are
+  // performed in a single message round (see ExchangeScheduler).
+  bool      be_fuse_exchanges = false;
+
+  // If true, the DIRK Newton iteration tracks convergence per column, skips the
+  // converged columns, and reports the iterations histogram with the state output.
+  bool      dirk_adaptive_newton = false;
+
+  // If true, the DIRK Newton iteration reuses the Jacobian factorization
+  // across iterations and steps with the same dt, until the residual stops
+  // decreasing.
+  bool      dirk_reuse_jacobian = false;
+
   // Use this member to check whether the struct has been initialized
   bool      params_set = false;
 };
@@ -113,6 +134,11 @@ inline void SimulationParams::print (std::ostream& out) {
   out << "   dp3d_thresh: " << dp3d_thresh << "\n";
   out << "   vtheta_thresh: " << vtheta_thresh << "\n";
   out << "   internal_diagnostics_level: " << internal_diagnostics_level << "\n";
+  out << "   caar_overlap_exchange: " << (caar_overlap_exchange ? "yes" : "no") << "\n";
+  out << "   be_neighbor_collectives: " << (be_neighbor_collectives ? "yes" : "no") << "\n";
+  out << "   be_fuse_exchanges: " << (be_fuse_exchanges ? "yes" : "no") << "\n";
+  out << "   dirk_adaptive_newton: " << (dirk_adaptive_newton ? "yes" : "no") << "\n";
+  out << "   dirk_reuse_jacobian: " << (dirk_reuse_jacobian ? "yes" : "no") << "\n";
   out << "\n**********************************************************\n";
 }
 
@@ -59,6 +59,11 @@ BoundaryExchange::BoundaryExchange()
   m_cleaned_up = true;
   m_send_pending = false;
   m_recv_pending = false;
+  m_local_pack_pending = false;
+
+  m_neighbor_collectives = false;
+  m_neighbor_collectives_set = false;
+  m_neighbor_request = MPI_REQUEST_NULL;
 
   m_diagnostics_level = 0;
 }
@@ -138,6 +143,21 @@ void BoundaryExchange::set_buffers_manager (std::shared_ptr<MpiBuffersManager> b
   m_buffers_manager->add_customer(this);
 }
 
+void BoundaryExchange::set_neighbor_collectives (const bool use)
+{
+  // Functionality only available before registration is completed
+  assert (!m_registration_completed);
+
+  if (use) {
+    // Creating the neighbor comm is collective, and needs the connections
+    assert (m_connectivity && m_connectivity->is_finalized());
+    m_connectivity->init_neighbor_comm();
+  }
+
+  m_neighbor_collectives = use;
+  m_neighbor_collectives_set = true;
+}
+
 void BoundaryExchange::set_num_fields (const int num_1d_fields, const int num_2d_fields, const int num_3d_fields, const int num_3d_int_fields)
 {
   // We don't allow to call this method twice in a row. If you want to change the number of fields,
@@ -176,6 +196,68 @@ void BoundaryExchange::set_num_fields (const int num_1d_fields, const int num_2d
   m_cleaned_up = false;
 }
 
+template<typename FieldsView>
+static void copy_field_views (const FieldsView& dst, const int dst_offset,
+                              const FieldsView& src, const int num_fields)
+{
+  if (num_fields==0) {
+    return;
+  }
+  Kokkos::parallel_for(MDRangePolicy<ExecSpace, 2>({0, 0}, {src.extent_int(0), num_fields}, {1, 1}),
+                       KOKKOS_LAMBDA(const int ie, const int ifield){
+    dst(ie, dst_offset+ifield) = src(ie, ifield);
+  });
+}
+
+void BoundaryExchange::register_fields_of (const std::vector<std::shared_ptr<BoundaryExchange>>& bes)
+{
+  // Same requirements as in set_num_fields
+  assert (m_cleaned_up);
+  assert (m_connectivity && m_connectivity->is_initialized());
+
+  int num_1d_fields = 0;
+  int num_2d_fields = 0;
+  int num_3d_fields = 0;
+  int num_3d_int_fields = 0;
+  for (const auto& be : bes) {
+    assert (be && be->is_registration_completed());
+    assert (be->m_connectivity==m_connectivity);
+    num_1d_fields     += be->m_num_1d_fields;
+    num_2d_fields     += be->m_num_2d_fields;
+    num_3d_fields     += be->m_num_3d_fields;
+    num_3d_int_fields += be->m_num_3d_int_fields;
+  }
+
+  // Note: if NUM_LEV=NUM_LEV_P, the interface fields of the input BE's are
+  //       already counted as 3d fields, so num_3d_int_fields=0.
+  m_1d_fields = decltype(m_1d_fields)("1d fields", m_num_elems, num_1d_fields);
+  m_2d_fields = decltype(m_2d_fields)("2d fields", m_num_elems, num_2d_fields);
+  alloc3d(m_3d_fields, m_3d_int_fields, m_num_elems, num_3d_fields, num_3d_int_fields);
+
+  m_3d_nlev_pack.clear();
+  for (const auto& be : bes) {
+    copy_field_views(m_1d_fields, m_num_1d_fields, be->m_1d_fields, be->m_num_1d_fields);
+    copy_field_views(m_2d_fields, m_num_2d_fields, be->m_2d_fields, be->m_num_2d_fields);
+    copy_field_views(m_3d_fields, m_num_3d_fields, be->m_3d_fields, be->m_num_3d_fields);
+    copy_field_views(m_3d_int_fields, m_num_3d_int_fields, be->m_3d_int_fields, be->m_num_3d_int_fields);
+
+    // The input BE clears its nlev's if they are all NUM_LEV
+    for (int i = 0; i < be->m_num_3d_fields; ++i) {
+      m_3d_nlev_pack.push_back(be->m_3d_nlev_pack.empty() ? NUM_LEV : be->m_3d_nlev_pack[i]);
+    }
+
+    m_num_1d_fields     += be->m_num_1d_fields;
+    m_num_2d_fields     += be->m_num_2d_fields;
+    m_num_3d_fields     += be->m_num_3d_fields;
+    m_num_3d_int_fields += be->m_num_3d_int_fields;
+  }
+
+  // Registration is done, but the user must still call registration_completed
+  m_registration_started   = true;
+  m_registration_completed = false;
+  m_cleaned_up = false;
+}
+
 void BoundaryExchange::clean_up()
 {
   if (m_cleaned_up) {
@@ -233,8 +315,16 @@ void BoundaryExchange::registration_completed()
   m_elem_buf_size[etoi(ConnectionKind::CORNER)] = m_num_1d_fields*2*NUM_LEV*VECTOR_SIZE + single_ptr_buf_size * 1;
   m_elem_buf_size[etoi(ConnectionKind::EDGE)]   = m_num_1d_fields*2*NUM_LEV*VECTOR_SIZE + single_ptr_buf_size * NP;
 
-  // Determine what kind of BE is this (exchange or exchange_min_max)
-  m_exchange_type = m_num_1d_fields>0 ? MPI_EXCHANGE_MIN_MAX : MPI_EXCHANGE;
+  // Determine what kind of BE is this (exchange or exchange_min_max). BE's with
+  // both min/max and 2d/3d fields (see register_fields_of) use exchange.
+  const bool has_sum_fields = m_num_2d_fields+m_num_3d_fields+m_num_3d_int_fields>0;
+  m_exchange_type = m_num_1d_fields>0 && !has_sum_fields ? MPI_EXCHANGE_MIN_MAX : MPI_EXCHANGE;
+
+  // Unless set explicitly, use the same transport requested in the connectivity
+  if (!m_neighbor_collectives_set) {
+    m_neighbor_collectives = m_connectivity->use_neighbor_collectives();
+  }
+  assert (!m_neighbor_collectives || m_connectivity->has_neighbor_comm());
 
   // Finalize bookkeeping for any exchange on fewer than NUM_LEV levels.
   {
@@ -365,7 +455,8 @@ pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> uco
       const ExecViewUnmanaged<const int*> ucon_ptr,
       const ExecViewUnmanaged<ExecViewManaged<Real[NP][NP]>**> fields_2d,
       const ExecViewUnmanaged<ExecViewUnmanaged<Real*>**> send_2d_buffers,
-      const int num_elems, const int num_2d_fields) {
+      const int num_elems, const int num_2d_fields,
+      const int sharing_filter) {
   HOMMEXX_STATIC const ConnectionHelpers helpers;
   const int nconn = ucon.extent_int(0);
   Kokkos::parallel_for(
@@ -374,6 +465,8 @@ pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> uco
       const int iconn = it / num_2d_fields;
       const int ifield = it % num_2d_fields;
       const auto& info = ucon(iconn);
+      if (sharing_filter >= 0 && info.sharing != sharing_filter)
+        return;
       const int buffer_iconn = (info.sharing == etoi(ConnectionSharing::LOCAL) ?
                                 info.sharing_local_remote_iconn :
                                 iconn);
@@ -392,6 +485,7 @@ pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> uco
       const ExecViewUnmanaged<ExecViewManaged<Scalar[NP][NP][NUM_LEV_PACKS]>**> fields_3d,
       const ExecViewUnmanaged<ExecViewUnmanaged<Scalar**>**> send_3d_buffers,
       const int num_elems, const int num_3d_fields,
+      const int sharing_filter,
       ExecViewManaged<int*>* nlev_packs_ = nullptr) {
   assert(partial_column == (nlev_packs_ != nullptr));
   if (partial_column) assert(nlev_packs_->extent_int(0) == num_3d_fields);
@@ -411,6 +505,8 @@ pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> uco
         }
         const int iconn = it / (num_3d_fields*NUM_LEV_PACKS);
         const auto& info = ucon(iconn);
+        if (sharing_filter >= 0 && info.sharing != sharing_filter)
+          return;
         const int buffer_iconn = (info.sharing == etoi(ConnectionSharing::LOCAL) ?
                                   info.sharing_local_remote_iconn :
                                   iconn);
@@ -442,6 +538,8 @@ pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> uco
         for (int iconn = ucon_ptr(ie); iconn < iconn_end; ++iconn) {
           const auto& info = ucon(iconn);
           assert(info.kind != etoi(ConnectionSharing::MISSING));
+          if (sharing_filter >= 0 && info.sharing != sharing_filter)
+            continue;
           const int buffer_iconn = (info.sharing == etoi(ConnectionSharing::LOCAL) ?
                                     info.sharing_local_remote_iconn :
                                     iconn);
@@ -462,6 +560,78 @@ pack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> uco
 }
 
 void BoundaryExchange::pack_and_send ()
+{
+  pack_and_send_impl(-1);
+}
+
+void BoundaryExchange::pack_and_send_shared ()
+{
+  pack_and_send_impl(etoi(ConnectionSharing::SHARED));
+}
+
+void BoundaryExchange::pack_local ()
+{
+  // pack_and_send_impl does not send anything in this case, so there is nothing to pack
+  if (m_num_2d_fields+m_num_3d_fields+m_num_3d_int_fields==0) {
+    return;
+  }
+
+  // Only makes sense after a call to pack_and_send_shared
+  assert (m_send_pending);
+
+  if (!m_local_pack_pending) {
+    return;
+  }
+
+  tstart("be pack_local");
+  pack_fields(etoi(ConnectionSharing::LOCAL));
+  Kokkos::fence();
+  m_local_pack_pending = false;
+  tstop("be pack_local");
+}
+
+// Defined below, together with the min/max exchange methods
+static void pack_min_max (
+  const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> ucon,
+  const ExecViewUnmanaged<const int*> ucon_ptr,
+  const ExecViewUnmanaged<ExecViewManaged<Scalar[2][NUM_LEV]>**> fields_1d,
+  const ExecViewUnmanaged<ExecViewUnmanaged<Scalar[2][NUM_LEV]>**> send_1d_buffers,
+  const int num_elems, const int num_1d_fields);
+static void unpack_min_max (
+  const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> ucon,
+  const ExecViewUnmanaged<const int*> ucon_ptr,
+  const ExecViewUnmanaged<ExecViewManaged<Scalar[2][NUM_LEV]>**> fields_1d,
+  const ExecViewUnmanaged<ExecViewUnmanaged<Scalar[2][NUM_LEV]>**> recv_1d_buffers,
+  const int num_elems, const int num_1d_fields);
+
+void BoundaryExchange::pack_fields (const int sharing_filter)
+{
+  const auto& ucon = m_connectivity->get_d_ucon();
+  const auto& ucon_ptr = m_connectivity->get_d_ucon_ptr();
+  // Min/max fields are only present if fused with 2d/3d fields (see register_fields_of)...
+  if (m_num_1d_fields > 0)
+    pack_min_max(ucon, ucon_ptr, m_1d_fields, m_send_1d_buffers, m_num_elems, m_num_1d_fields);
+  // ...then pack 2d fields (if any)...
+  if (m_num_2d_fields > 0)
+    pack(ucon, ucon_ptr, m_2d_fields, m_send_2d_buffers, m_num_elems,
+         m_num_2d_fields, sharing_filter);
+  // ...then pack 3d fields (if any)...
+  if (m_num_3d_fields > 0) {
+    if (m_3d_nlev_pack_d.size() > 0)
+      pack<NUM_LEV, true>(ucon, ucon_ptr, m_3d_fields, m_send_3d_buffers,
+                          m_num_elems, m_num_3d_fields, sharing_filter,
+                          &m_3d_nlev_pack_d);
+    else
+      pack<NUM_LEV>(ucon, ucon_ptr, m_3d_fields, m_send_3d_buffers,
+                    m_num_elems, m_num_3d_fields, sharing_filter);
+  }
+  // ...then pack 3d interface fields (if any)
+  if (m_num_3d_int_fields > 0)
+    pack<NUM_LEV_P>(ucon, ucon_ptr, m_3d_int_fields, m_send_3d_int_buffers,
+                    m_num_elems, m_num_3d_int_fields, sharing_filter);
+}
+
+void BoundaryExchange::pack_and_send_impl (const int sharing_filter)
 {
   tstart("be pack_and_send");
   // The registration MUST be completed by now
@@ -471,6 +641,13 @@ void BoundaryExchange::pack_and_send ()
   // Check that this object is setup to perform exchange and not exchange_min_max
   assert (m_exchange_type==MPI_EXCHANGE);
 
+  // We can only restrict the pack to shared connections (the local ones are
+  // packed later via pack_local)
+  assert (sharing_filter==-1 || sharing_filter==etoi(ConnectionSharing::SHARED));
+
+  // The min/max pack cannot be restricted to shared connections
+  assert (sharing_filter==-1 || m_num_1d_fields==0);
+
   // I am not sure why and if we could have this scenario, but just in case. I think MPI *may* go bananas in this case
   if (m_num_2d_fields+m_num_3d_fields+m_num_3d_int_fields==0) {
     return;
@@ -489,26 +666,17 @@ void BoundaryExchange::pack_and_send ()
     tstop("be build_buffer_views_and_requests");
   }
 
-  // ---- Pack ---- //
-  const auto& ucon = m_connectivity->get_d_ucon();
-  const auto& ucon_ptr = m_connectivity->get_d_ucon_ptr();
-  // First, pack 2d fields (if any)...
-  if (m_num_2d_fields > 0)
-    pack(ucon, ucon_ptr, m_2d_fields, m_send_2d_buffers, m_num_elems,
-         m_num_2d_fields);
-  // ...then pack 3d fields (if any)...
-  if (m_num_3d_fields > 0) {
-    if (m_3d_nlev_pack_d.size() > 0)
-      pack<NUM_LEV, true>(ucon, ucon_ptr, m_3d_fields, m_send_3d_buffers,
-                          m_num_elems, m_num_3d_fields, &m_3d_nlev_pack_d);
-    else
-      pack<NUM_LEV>(ucon, ucon_ptr, m_3d_fields, m_send_3d_buffers,
-                    m_num_elems, m_num_3d_fields);
+  if (sharing_filter>=0 && !m_recv_pending) {
+    // The caller wants to do some work between the send and the recv, so
+    // start receiving now, so that remote data can arrive in the meantime
+    if ( ! m_recv_requests.empty())
+      HOMMEXX_MPI_CHECK_ERROR(MPI_Startall(m_recv_requests.size(), m_recv_requests.data()),
+                              m_connectivity->get_comm().mpi_comm());
+    m_recv_pending = true;
   }
-  // ...then pack 3d interface fields (if any)
-  if (m_num_3d_int_fields > 0)
-    pack<NUM_LEV_P>(ucon, ucon_ptr, m_3d_int_fields, m_send_3d_int_buffers,
-                    m_num_elems, m_num_3d_int_fields);
+
+  // ---- Pack ---- //
+  pack_fields(sharing_filter);
   Kokkos::fence();
 
   // ---- Send ---- //
@@ -516,12 +684,16 @@ void BoundaryExchange::pack_and_send ()
   m_buffers_manager->sync_send_buffer(this); // Deep copy send_buffer into mpi_send_buffer (no op if MPI is on device)
   tstop("be sync_send_buffer");
   tstart("be send");
-  if ( ! m_send_requests.empty())
+  if (m_neighbor_collectives)
+    start_neighbor_exchange();
+  else if ( ! m_send_requests.empty())
     HOMMEXX_MPI_CHECK_ERROR(MPI_Startall(m_send_requests.size(), m_send_requests.data()),
                             m_connectivity->get_comm().mpi_comm());
+  tstop("be send");
 
-  // Notify a send is ongoing
+  // Notify a send is ongoing, and whether local connections still need packing
   m_send_pending = true;
+  m_local_pack_pending = (sharing_filter>=0);
   tstop("be pack_and_send");
 }
 
@@ -529,6 +701,10 @@ void BoundaryExchange::recv_and_unpack () {
   recv_and_unpack(nullptr);
 }
 
+void BoundaryExchange::recv_and_unpack (ExecViewUnmanaged<const Real * [NP][NP]> rspheremp) {
+  recv_and_unpack(&rspheremp);
+}
+
 // assume:conn-edges-snwe
 static void
 unpack (const ExecViewUnmanaged<const HaloExchangeUnstructuredConnectionInfo*> ucon,
@@ -693,6 +869,12 @@ void BoundaryExchange::recv_and_unpack (const ExecViewUnmanaged<const Real * [NP
     return;
   }
 
+  // If pack_and_send_shared was used, the local connections must be packed
+  // before we can unpack
+  if (m_local_pack_pending) {
+    pack_local();
+  }
+
   // If I am doing pack_and_send and recv_and_unpack manually (rather than
   // through 'exchange'), then I need to start receiving now (otherwise it is
   // done already inside 'exchange')
@@ -710,7 +892,9 @@ void BoundaryExchange::recv_and_unpack (const ExecViewUnmanaged<const Real * [NP
 
   // ---- Recv ---- //
   tstart("be recv waitall");
-  if ( ! m_recv_requests.empty())
+  if (m_neighbor_collectives)
+    wait_neighbor_exchange();
+  else if ( ! m_recv_requests.empty())
     HOMMEXX_MPI_CHECK_ERROR(MPI_Waitall(m_recv_requests.size(), m_recv_requests.data(), MPI_STATUSES_IGNORE),
                             m_connectivity->get_comm().mpi_comm()); // Wait for all data to arrive
   m_recv_pending = false;
@@ -724,7 +908,11 @@ void BoundaryExchange::recv_and_unpack (const ExecViewUnmanaged<const Real * [NP
   // --- Unpack --- //
   const auto& ucon = m_connectivity->get_d_ucon();
   const auto& ucon_ptr = m_connectivity->get_d_ucon_ptr();
-  // First, unpack 2d fields (if any)...
+  // Min/max fields are only present if fused with 2d/3d fields (see register_fields_of)...
+  if (m_num_1d_fields>0)
+    unpack_min_max(ucon, ucon_ptr, m_1d_fields, m_recv_1d_buffers, m_num_elems,
+                   m_num_1d_fields);
+  // ...then unpack 2d fields (if any)...
   if (m_num_2d_fields>0)
     unpack(ucon, ucon_ptr, m_2d_fields, m_recv_2d_buffers, rspheremp, m_num_elems,
            m_num_2d_fields);
@@ -863,7 +1051,9 @@ void BoundaryExchange::pack_and_send_min_max ()
 
   // ---- Send ---- //
   m_buffers_manager->sync_send_buffer(this);
-  if ( ! m_send_requests.empty())
+  if (m_neighbor_collectives)
+    start_neighbor_exchange();
+  else if ( ! m_send_requests.empty())
     HOMMEXX_MPI_CHECK_ERROR(MPI_Startall(m_send_requests.size(), m_send_requests.data()),
                             m_connectivity->get_comm().mpi_comm());
 
@@ -965,7 +1155,9 @@ void BoundaryExchange::recv_and_unpack_min_max ()
   }
 
   // ---- Recv ---- //
-  if ( ! m_recv_requests.empty())
+  if (m_neighbor_collectives)
+    wait_neighbor_exchange();
+  else if ( ! m_recv_requests.empty())
     HOMMEXX_MPI_CHECK_ERROR(MPI_Waitall(m_recv_requests.size(), m_recv_requests.data(), MPI_STATUSES_IGNORE),
                             m_connectivity->get_comm().mpi_comm()); // Wait for all data to arrive
 
@@ -1146,8 +1338,15 @@ void BoundaryExchange::build_buffer_views_and_requests()
     const auto mpi_comm = m_connectivity->get_comm().mpi_comm();
     const size_t npids = pids.size();
     free_requests();
-    m_send_requests.resize(npids);
-    m_recv_requests.resize(npids);
+    if (m_neighbor_collectives) {
+      // The neighbors of the graph comm are these same pids, in the same (ascending) order
+      assert (pids==m_connectivity->get_neighbor_pids());
+      m_neighbor_counts.resize(npids);
+      m_neighbor_displs.resize(npids);
+    } else {
+      m_send_requests.resize(npids);
+      m_recv_requests.resize(npids);
+    }
     MPIViewManaged<Real*>::pointer_type send_ptr = buffers_manager->get_mpi_send_buffer().data();
     MPIViewManaged<Real*>::pointer_type recv_ptr = buffers_manager->get_mpi_recv_buffer().data();
     int offset = 0;
@@ -1158,6 +1357,12 @@ void BoundaryExchange::build_buffer_views_and_requests()
         const auto& info = ucon(i);
         count += m_elem_buf_size[info.kind];
       }
+      if (m_neighbor_collectives) {
+        m_neighbor_counts[ip] = count;
+        m_neighbor_displs[ip] = offset;
+        offset += count;
+        continue;
+      }
       HOMMEXX_MPI_CHECK_ERROR(MPI_Send_init(send_ptr + offset, count, MPI_DOUBLE,
                                             pids[ip], m_exchange_type, mpi_comm,
                                             &m_send_requests[ip]),
@@ -1184,6 +1389,27 @@ void BoundaryExchange
     HOMMEXX_MPI_CHECK_ERROR(MPI_Request_free(&m_recv_requests[i]),
                             m_connectivity->get_comm().mpi_comm());
   m_recv_requests.clear();
+  m_neighbor_counts.clear();
+  m_neighbor_displs.clear();
+}
+
+void BoundaryExchange::start_neighbor_exchange ()
+{
+  // Note: this is collective over the neighbor comm, so it must be called
+  //       also by processes with no neighbors.
+  MPIViewManaged<Real*>::pointer_type send_ptr = m_buffers_manager->get_mpi_send_buffer().data();
+  MPIViewManaged<Real*>::pointer_type recv_ptr = m_buffers_manager->get_mpi_recv_buffer().data();
+  HOMMEXX_MPI_CHECK_ERROR(MPI_Ineighbor_alltoallv(send_ptr, m_neighbor_counts.data(), m_neighbor_displs.data(), MPI_DOUBLE,
+                                                  recv_ptr, m_neighbor_counts.data(), m_neighbor_displs.data(), MPI_DOUBLE,
+                                                  m_connectivity->get_neighbor_comm(), &m_neighbor_request),
+                          m_connectivity->get_comm().mpi_comm());
+}
+
+void BoundaryExchange::wait_neighbor_exchange ()
+{
+  // Note: waiting on MPI_REQUEST_NULL returns immediately
+  HOMMEXX_MPI_CHECK_ERROR(MPI_Wait(&m_neighbor_request, MPI_STATUS_IGNORE),
+                          m_connectivity->get_comm().mpi_comm());
 }
 
 // A slot is the space in a communication buffer for an (element, connection)
@@ -1298,8 +1524,11 @@ void BoundaryExchange::waitall()
   if ( ! m_recv_requests.empty())
     HOMMEXX_MPI_CHECK_ERROR(MPI_Waitall(m_recv_requests.size(), m_recv_requests.data(), MPI_STATUSES_IGNORE),
                             m_connectivity->get_comm().mpi_comm());
+  if (m_neighbor_collectives)
+    wait_neighbor_exchange();
 
   m_buffers_manager->unlock_buffers();
+  m_local_pack_pending = false;
 }
 
 } // namespace Homme
@@ -185,6 +185,14 @@ public:
   template<int DIM, typename... Properties>
   void register_min_max_fields (ExecView<Scalar*[DIM][2][NUM_LEV], Properties...> field_min_max, int num_dims, int start_dim);
 
+  // Register all the fields of the given BE's, so that one exchange handles all of
+  // them, with a single message per neighbor. Like set_num_fields, this must be called
+  // on a clean BE, and be followed by registration_completed. The input BE's must
+  // have completed their registration. Unlike set_num_fields, min/max (1d) fields can
+  // be mixed with 2d/3d fields: the exchange method combines the former with min/max,
+  // and accumulates the latter (see ExchangeScheduler).
+  void register_fields_of (const std::vector<std::shared_ptr<BoundaryExchange>>& bes);
+
   // Size the buffers, and initialize the MPI types
   void registration_completed();
 
@@ -218,6 +226,16 @@ public:
   // Perform the pack_and_send and recv_and_unpack for boundary exchange of 2d/3d fields
   void pack_and_send ();
   void recv_and_unpack ();
+  void recv_and_unpack (ExecViewUnmanaged<const Real * [NP][NP]> rspheremp);
+
+  // Split version of pack_and_send, to overlap communication with computation:
+  // pack_and_send_shared only packs (and sends) the connections shared with other
+  // processes, so it only needs the fields on the boundary elements (see
+  // Connectivity::get_d_boundary_elems) to be up to date. pack_local packs the
+  // remaining (on-process) connections, and must be called once all the fields
+  // are up to date. If not called explicitly, recv_and_unpack calls it.
+  void pack_and_send_shared ();
+  void pack_local ();
 
   // Perform the pack_and_send and recv_and_unpack for min/max boundary exchange of 1d fields
   void pack_and_send_min_max ();
@@ -226,6 +244,14 @@ public:
   // If you are really not sure whether we are still transmitting, you can make sure we're done by calling this
   void waitall ();
 
+  // Whether the messages to/from other processes are exchanged with one MPI
+  // neighborhood collective (MPI_Ineighbor_alltoallv on the neighbor comm of the
+  // connectivity) rather than with point-to-point messages. If not set, the
+  // connectivity setting is used. The setter must be called on all ranks, before
+  // registration_completed.
+  void set_neighbor_collectives (const bool use);
+  bool use_neighbor_collectives () const { return m_neighbor_collectives; }
+
   // Set an optional string label for this object. If present, it is used in
   // optional diagnostic output.
   void set_label (const std::string& label);
@@ -251,6 +277,15 @@ private:
   std::vector<MPI_Request>  m_send_requests;
   std::vector<MPI_Request>  m_recv_requests;
 
+  // If m_neighbor_collectives=true, the requests above are empty, and the shared
+  // connections are exchanged with one neighborhood collective. Counts and
+  // displacements are the same for send and recv.
+  bool                      m_neighbor_collectives;
+  bool                      m_neighbor_collectives_set;
+  std::vector<int>          m_neighbor_counts;
+  std::vector<int>          m_neighbor_displs;
+  MPI_Request               m_neighbor_request;
+
   ExecViewManaged<ExecViewManaged<Scalar[2][NUM_LEV]>**>            m_1d_fields;
   ExecViewManaged<ExecViewManaged<Real[NP][NP]>**>                  m_2d_fields;
   ExecViewManaged<ExecViewManaged<Scalar[NP][NP][NUM_LEV]>**>       m_3d_fields;
@@ -301,6 +336,7 @@ private:
   bool        m_cleaned_up;
   bool        m_send_pending;
   bool        m_recv_pending;
+  bool        m_local_pack_pending;
 
   int         m_num_elems;
 
@@ -311,6 +347,11 @@ private:
     std::vector<int>& h_slot_idx_to_elem_conn_pair,
     std::vector<int>& pids, std::vector<int>& pids_os);
   void free_requests();
+  void start_neighbor_exchange();
+  void wait_neighbor_exchange();
+  // Pack all connections (sharing_filter=-1), or only those with the given sharing
+  void pack_fields (const int sharing_filter);
+  void pack_and_send_impl (const int sharing_filter);
   // Only the impl knows about the raw pointer.
   void exchange(const ExecViewUnmanaged<const Real * [NP][NP]>* rspheremp);
 public: // This is semantically private but must be public for nvcc.
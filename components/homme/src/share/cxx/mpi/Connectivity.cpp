@@ -6,9 +6,11 @@
 
 #include "Connectivity.hpp"
 #include "ErrorDefs.hpp"
+#include "Hommexx_Debug.hpp"
 
 #include <array>
 #include <algorithm>
+#include <vector>
 
 namespace Homme
 {
@@ -18,6 +20,7 @@ Connectivity::Connectivity ()
  , m_initialized  (false)
  , m_num_local_elements (-1)
  , m_max_corner_elements(-1)
+ , m_use_neighbor_collectives(false)
 {
   // Nothing to be done here
 }
@@ -136,6 +139,7 @@ void Connectivity::finalize(const bool sanity_check)
   }
 
   setup_ucon();
+  setup_elem_classification();
 
   m_finalized = true;
 }
@@ -313,6 +317,88 @@ void Connectivity::setup_ucon () {
   }
 }
 
+void Connectivity::setup_elem_classification () {
+  // An element is a boundary element if at least one of its connections is
+  // shared with another process; otherwise it is an interior element.
+  std::vector<int> boundary, interior;
+  const bool has_conn = h_ucon.extent(0)>0;
+  for (int ie = 0; ie < m_num_local_elements; ++ie) {
+    bool is_boundary = false;
+    if (has_conn) {
+      for (int k = h_ucon_ptr(ie); k < h_ucon_ptr(ie+1); ++k) {
+        if (h_ucon(k).sharing == etoi(ConnectionSharing::SHARED)) {
+          is_boundary = true;
+          break;
+        }
+      }
+    }
+    (is_boundary ? boundary : interior).push_back(ie);
+  }
+
+  d_boundary_elems = decltype(d_boundary_elems)("Boundary elements", boundary.size());
+  d_interior_elems = decltype(d_interior_elems)("Interior elements", interior.size());
+  h_boundary_elems = Kokkos::create_mirror_view(d_boundary_elems);
+  h_interior_elems = Kokkos::create_mirror_view(d_interior_elems);
+  std::copy(boundary.begin(), boundary.end(), h_boundary_elems.data());
+  std::copy(interior.begin(), interior.end(), h_interior_elems.data());
+  Kokkos::deep_copy(d_boundary_elems, h_boundary_elems);
+  Kokkos::deep_copy(d_interior_elems, h_interior_elems);
+}
+
+void Connectivity::init_neighbor_comm ()
+{
+  // We need the connections to be set up
+  assert (m_finalized);
+
+  if (m_neighbor_comm) {
+    return;
+  }
+
+  // The neighbors are the (unique) remote pids of the shared connections.
+  // Shared connections are symmetric, so sources and destinations coincide.
+  m_neighbor_pids.clear();
+  for (int i=0; i<h_ucon.extent_int(0); ++i) {
+    if (h_ucon(i).sharing==etoi(ConnectionSharing::SHARED)) {
+      m_neighbor_pids.push_back(h_ucon(i).remote_pid);
+    }
+  }
+  std::sort(m_neighbor_pids.begin(),m_neighbor_pids.end());
+  m_neighbor_pids.erase(std::unique(m_neighbor_pids.begin(),m_neighbor_pids.end()),m_neighbor_pids.end());
+
+  // Do not reorder ranks: the pids stored in the connections must stay valid
+  const int num_neighbors = m_neighbor_pids.size();
+  MPI_Comm* graph_comm = new MPI_Comm(MPI_COMM_NULL);
+  HOMMEXX_MPI_CHECK_ERROR(MPI_Dist_graph_create_adjacent(m_comm.mpi_comm(),
+                                                         num_neighbors, m_neighbor_pids.data(), MPI_UNWEIGHTED,
+                                                         num_neighbors, m_neighbor_pids.data(), MPI_UNWEIGHTED,
+                                                         MPI_INFO_NULL, 0, graph_comm),
+                          m_comm.mpi_comm());
+
+  m_neighbor_comm.reset(graph_comm,[](MPI_Comm* c) {
+    // This may be destroyed at exit, after MPI is finalized
+    int finalized;
+    MPI_Finalized(&finalized);
+    if (!finalized && *c!=MPI_COMM_NULL) {
+      MPI_Comm_free(c);
+    }
+    delete c;
+  });
+}
+
+MPI_Comm Connectivity::get_neighbor_comm () const
+{
+  assert (m_neighbor_comm);
+  return *m_neighbor_comm;
+}
+
+void Connectivity::set_neighbor_collectives (const bool use)
+{
+  if (use) {
+    init_neighbor_comm();
+  }
+  m_use_neighbor_collectives = use;
+}
+
 void Connectivity::clean_up()
 {
   // Cleaning the elements counter
@@ -323,6 +409,15 @@ void Connectivity::clean_up()
   d_ucon_ptr = decltype(d_ucon_ptr)("", 0);
   h_ucon_ptr = decltype(h_ucon_ptr)("", 0);
 
+  d_boundary_elems = decltype(d_boundary_elems)("", 0);
+  h_boundary_elems = decltype(h_boundary_elems)("", 0);
+  d_interior_elems = decltype(d_interior_elems)("", 0);
+  h_interior_elems = decltype(h_interior_elems)("", 0);
+
+  m_neighbor_comm = nullptr;
+  m_neighbor_pids.clear();
+  m_use_neighbor_collectives = false;
+
   m_initialized = false;
   m_finalized   = false;
 }
@@ -11,6 +11,9 @@
 #include "Comm.hpp"
 #include "Types.hpp"
 
+#include <memory>
+#include <vector>
+
 namespace Homme
 {
 struct LidGidPos
@@ -100,6 +103,16 @@ public:
   HostViewUnmanaged<const ConnectionInfo*> get_h_ucon () const { return h_ucon; }
   HostViewUnmanaged<const int*> get_h_ucon_ptr () const { return h_ucon_ptr; }
 
+  // Local IDs of the elements with at least one connection shared with another
+  // process (boundary elements), and of all the other elements (interior
+  // elements). Both lists are sorted, and together they cover all local elements.
+  ExecViewUnmanaged<const int*> get_d_boundary_elems () const { return d_boundary_elems; }
+  ExecViewUnmanaged<const int*> get_d_interior_elems () const { return d_interior_elems; }
+  HostViewUnmanaged<const int*> get_h_boundary_elems () const { return h_boundary_elems; }
+  HostViewUnmanaged<const int*> get_h_interior_elems () const { return h_interior_elems; }
+  int get_num_boundary_elements  () const { return d_boundary_elems.extent_int(0); }
+  int get_num_interior_elements  () const { return d_interior_elems.extent_int(0); }
+
   // Get number of connections with given kind and sharing
   template<typename MemSpace>
   KOKKOS_INLINE_FUNCTION
@@ -129,6 +142,21 @@ public:
   bool is_finalized   () const { return m_finalized;   }
 
   const Comm& get_comm () const { return m_comm; }
+
+  // Distributed graph comm for MPI neighborhood collectives. Each process sharing
+  // at least one connection with this process is both a source and a destination,
+  // and neighbors are sorted by rank (see get_neighbor_pids). The comm is created
+  // by init_neighbor_comm, which is collective, and must be called after finalize.
+  void init_neighbor_comm ();
+  bool has_neighbor_comm () const { return static_cast<bool>(m_neighbor_comm); }
+  MPI_Comm get_neighbor_comm () const;
+  const std::vector<int>& get_neighbor_pids () const { return m_neighbor_pids; }
+
+  // Whether BoundaryExchange objects built on this connectivity should use neighborhood
+  // collectives rather than point-to-point messages (BE's can override this setting).
+  // Setting it to true creates the neighbor comm, so it must be called on all ranks.
+  void set_neighbor_collectives (const bool use);
+  bool use_neighbor_collectives () const { return m_use_neighbor_collectives; }
   //@}
 
 private:
@@ -167,6 +195,19 @@ private:
   // In finalize call, construct the unstructured connectivity data using
   // ucon_info.
   void setup_ucon();
+
+  ExecViewManaged<int*>             d_boundary_elems;
+  ExecViewManaged<int*>::HostMirror h_boundary_elems;
+  ExecViewManaged<int*>             d_interior_elems;
+  ExecViewManaged<int*>::HostMirror h_interior_elems;
+  // In finalize call, after setup_ucon, split local elements into boundary
+  // and interior elements.
+  void setup_elem_classification();
+
+  // The comm is shared by copies of this object, and freed when the last one goes away
+  std::shared_ptr<MPI_Comm> m_neighbor_comm;
+  std::vector<int>          m_neighbor_pids;
+  bool                      m_use_neighbor_collectives;
 };
 
 } // namespace Homme
@@ -0,0 +1,106 @@
+/********************************************************************************
+ * HOMMEXX 1.0: Copyright of Sandia Corporation
+ * This software is released under the BSD license
+ * See the file 'COPYRIGHT' in the HOMMEXX/src/share/cxx directory
+ *******************************************************************************/
+
+#include "ExchangeScheduler.hpp"
+
+#include "BoundaryExchange.hpp"
+#include "MpiBuffersManager.hpp"
+
+namespace Homme
+{
+
+void ExchangeScheduler::set_buffers_manager (std::shared_ptr<MpiBuffersManager> buffers_manager)
+{
+  assert (buffers_manager);
+  assert (m_deferred.empty());
+
+  clear();
+  m_buffers_manager = buffers_manager;
+}
+
+void ExchangeScheduler::defer (const std::shared_ptr<BoundaryExchange>& be, const bool scale_by_rspheremp)
+{
+  assert (be && be->is_registration_completed());
+
+  m_deferred.emplace_back(be,scale_by_rspheremp);
+}
+
+void ExchangeScheduler::flush (ExecViewUnmanaged<const Real * [NP][NP]> rspheremp)
+{
+  if (m_deferred.empty()) {
+    return;
+  }
+
+  // Split the BE's in two groups: those whose fields are scaled by rspheremp, and
+  // those whose fields are not. The min/max BE's go with the first non-empty group.
+  std::vector<std::shared_ptr<BoundaryExchange>> scaled, unscaled, min_max;
+  for (const auto& it : m_deferred) {
+    const auto& be = it.first;
+    if (be->get_num_1d_fields()>0) {
+      min_max.push_back(be);
+    } else if (it.second) {
+      scaled.push_back(be);
+    } else {
+      unscaled.push_back(be);
+    }
+  }
+  auto& min_max_group = scaled.empty() ? unscaled : scaled;
+  min_max_group.insert(min_max_group.end(),min_max.begin(),min_max.end());
+  m_deferred.clear();
+
+  for (const bool scale : {true, false}) {
+    const auto& group = scale ? scaled : unscaled;
+    if (group.empty()) {
+      continue;
+    }
+
+    auto be = group.size()==1 ? group[0] : get_fused(group);
+    const int num_sum_fields = be->get_num_2d_fields() + be->get_num_3d_fields() + be->get_num_3d_int_fields();
+    if (num_sum_fields==0) {
+      be->exchange_min_max();
+    } else if (scale) {
+      assert (rspheremp.size()>0);
+      be->exchange(rspheremp);
+    } else {
+      be->exchange();
+    }
+  }
+}
+
+void ExchangeScheduler::clear ()
+{
+  assert (m_deferred.empty());
+
+  m_fused.clear();
+}
+
+std::shared_ptr<BoundaryExchange>
+ExchangeScheduler::get_fused (const std::vector<std::shared_ptr<BoundaryExchange>>& bes)
+{
+  std::vector<const BoundaryExchange*> key;
+  for (const auto& be : bes) {
+    key.push_back(be.get());
+  }
+
+  auto& fused = m_fused[key];
+  if (!fused) {
+    assert (m_buffers_manager);
+
+    std::string label = "fused";
+    for (const auto& be : bes) {
+      label += "-" + be->get_label();
+    }
+
+    fused = std::make_shared<BoundaryExchange>();
+    fused->set_label(label);
+    fused->set_buffers_manager(m_buffers_manager);
+    fused->register_fields_of(bes);
+    fused->registration_completed();
+  }
+  return fused;
+}
+
+} // namespace Homme
@@ -0,0 +1,79 @@
+/********************************************************************************
+ * HOMMEXX 1.0: Copyright of Sandia Corporation
+ * This software is released under the BSD license
+ * See the file 'COPYRIGHT' in the HOMMEXX/src/share/cxx directory
+ *******************************************************************************/
+
+#ifndef HOMMEXX_EXCHANGE_SCHEDULER_HPP
+#define HOMMEXX_EXCHANGE_SCHEDULER_HPP
+
+#include "Types.hpp"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace Homme
+{
+
+// Forward declarations
+class BoundaryExchange;
+class MpiBuffersManager;
+
+/*
+ * ExchangeScheduler: a class to coalesce several boundary exchanges in one message round
+ *
+ * Each BoundaryExchange (BE) object performs its own message round, which, in
+ * latency-bound runs, costs a full network round trip. If the inputs of several BE's
+ * are ready at the same time, their exchanges can be deferred, and then performed
+ * together, with a single pack/send/recv/unpack, via a BE that holds all their
+ * fields (see BoundaryExchange::register_fields_of).
+ *
+ * The fused BE's are built the first time a given sequence of BE's is flushed, and
+ * cached for later use. Min/max BE's are fused with the others, since they do not
+ * use rspheremp. BE's that scale the accumulated fields by rspheremp cannot be
+ * fused with BE's that do not, so a flush may still need two rounds.
+ *
+ * NOTE: the cached fused BE's store the fields of the deferred BE's. If the latter
+ *       are cleaned up or re-registered, clear must be called.
+ */
+
+class ExchangeScheduler
+{
+public:
+
+  ExchangeScheduler () = default;
+
+  // The buffers manager of the fused BE's. Since these may contain 2d/3d fields,
+  // it should be the one used for MPI_EXCHANGE. Clears the cached BE's.
+  void set_buffers_manager (std::shared_ptr<MpiBuffersManager> buffers_manager);
+
+  // Request the exchange of the fields of be. The exchange is done at the next
+  // flush. If scale_by_rspheremp=true, the accumulated (2d/3d) fields are scaled
+  // by the rspheremp passed to flush.
+  void defer (const std::shared_ptr<BoundaryExchange>& be, const bool scale_by_rspheremp = false);
+
+  // Exchange the fields of all the deferred BE's, with as few message rounds as possible.
+  // Must be called in the same order on all ranks, with the same deferred BE's.
+  void flush (ExecViewUnmanaged<const Real * [NP][NP]> rspheremp = {});
+
+  bool empty () const { return m_deferred.empty(); }
+
+  // Release the cached fused BE's
+  void clear ();
+
+private:
+
+  std::shared_ptr<BoundaryExchange>
+  get_fused (const std::vector<std::shared_ptr<BoundaryExchange>>& bes);
+
+  std::shared_ptr<MpiBuffersManager> m_buffers_manager;
+
+  std::vector<std::pair<std::shared_ptr<BoundaryExchange>,bool>> m_deferred;
+
+  std::map<std::vector<const BoundaryExchange*>,std::shared_ptr<BoundaryExchange>> m_fused;
+};
+
+} // namespace Homme
+
+#endif // HOMMEXX_EXCHANGE_SCHEDULER_HPP
@@ -0,0 +1,164 @@
+/********************************************************************************
+ * HOMMEXX 1.0: Copyright of Sandia Corporation
+ * This software is released under the BSD license
+ * See the file 'COPYRIGHT' in the HOMMEXX/src/share/cxx directory
+ *******************************************************************************/
+
+#ifndef HOMMEXX_BATCHED_TRIDIAG_HPP
+#define HOMMEXX_BATCHED_TRIDIAG_HPP
+
+#include "Types.hpp"
+#include "ExecSpaceDefs.hpp"
+
+#include <cassert>
+
+namespace Homme {
+
+/*
+ * Solve a batch of independent tridiagonal systems, vectorized across the systems.
+ *
+ * The team solvers in scream_tridiag.hpp solve the systems of one element per team,
+ * and, on GPU, parallelize along the vertical (cyclic reduction). Here, instead,
+ * the systems of many columns are stored interleaved (SoA): views have extents
+ * (nrow, ncol), and row k of all systems is contiguous in memory. Each thread
+ * runs the Thomas algorithm on a chunk of consecutive (pack) columns, sweeping the
+ * rows in the outer loop, so that the inner loop is a contiguous, vectorizable
+ * loop over the systems. With Scalar packs, the pack dimension adds to that.
+ *
+ * The matrix format is the same as in scream_tridiag.hpp: the lower diagonal is
+ * in dl(1:n-1,:), the diagonal in d(0:n-1,:), and the upper diagonal in du(0:n-2,:).
+ * On input x is the RHS, on output the solution.
+ *
+ * There are two algorithms:
+ *  - solve: a single pass of the Thomas algorithm. It overwrites d and x.
+ *  - factorize + solve_factored: the same sequence of operations as in
+ *    scream::tridiag::bfb, so the result is BFB with that solver. factorize
+ *    overwrites dl and d with the LU factors, which can then be used by
+ *    solve_factored for several RHS (e.g., across Newton iterations).
+ *
+ * The column-range kernels (*_cols) can be called from within other kernels,
+ * to solve a subset of the columns.
+ */
+
+struct BatchedTridiag {
+
+  // Number of (pack) columns processed by a single thread in the top-level solvers.
+  // On GPU, each thread processes one column, so that accesses are coalesced.
+  enum : int { default_chunk = OnGpu<ExecSpace>::value ? 1 : 8 };
+
+  template <typename DiagView, typename DataView>
+  KOKKOS_INLINE_FUNCTION
+  static void solve_cols (const DiagView& dl, const DiagView& d, const DiagView& du,
+                          const DataView& x, const int col_beg, const int col_end) {
+    const int nrow = d.extent_int(0);
+    for (int k = 1; k < nrow; ++k) {
+      for (int c = col_beg; c < col_end; ++c) {
+        const auto dlk = dl(k,c) / d(k-1,c);
+        d(k,c) -= dlk * du(k-1,c);
+        x(k,c) -= dlk * x(k-1,c);
+      }
+    }
+    back_substitute_cols(d, du, x, col_beg, col_end);
+  }
+
+  template <typename DiagView>
+  KOKKOS_INLINE_FUNCTION
+  static void factorize_cols (const DiagView& dl, const DiagView& d, const DiagView& du,
+                              const int col_beg, const int col_end) {
+    const int nrow = d.extent_int(0);
+    for (int k = 1; k < nrow; ++k) {
+      for (int c = col_beg; c < col_end; ++c) {
+        dl(k,c) /= d(k-1,c);
+        d (k,c) -= dl(k,c) * du(k-1,c);
+      }
+    }
+  }
+
+  template <typename DiagView, typename DataView>
+  KOKKOS_INLINE_FUNCTION
+  static void solve_factored_cols (const DiagView& dl, const DiagView& d, const DiagView& du,
+                                   const DataView& x, const int col_beg, const int col_end) {
+    const int nrow = d.extent_int(0);
+    for (int k = 1; k < nrow; ++k) {
+      for (int c = col_beg; c < col_end; ++c) {
+        x(k,c) -= dl(k,c) * x(k-1,c);
+      }
+    }
+    back_substitute_cols(d, du, x, col_beg, col_end);
+  }
+
+  template <typename DiagView, typename DataView>
+  static void solve (const DiagView& dl, const DiagView& d, const DiagView& du,
+                     const DataView& x, const int chunk = default_chunk) {
+    check_extents(dl, d, du, x);
+    const int ncol = d.extent_int(1);
+    Kokkos::parallel_for(Kokkos::RangePolicy<ExecSpace>(0, num_chunks(ncol,chunk)),
+                         KOKKOS_LAMBDA(const int ic) {
+      solve_cols(dl, d, du, x, ic*chunk, chunk_end(ic,chunk,ncol));
+    });
+  }
+
+  template <typename DiagView>
+  static void factorize (const DiagView& dl, const DiagView& d, const DiagView& du,
+                         const int chunk = default_chunk) {
+    check_extents(dl, d, du, d);
+    const int ncol = d.extent_int(1);
+    Kokkos::parallel_for(Kokkos::RangePolicy<ExecSpace>(0, num_chunks(ncol,chunk)),
+                         KOKKOS_LAMBDA(const int ic) {
+      factorize_cols(dl, d, du, ic*chunk, chunk_end(ic,chunk,ncol));
+    });
+  }
+
+  template <typename DiagView, typename DataView>
+  static void solve_factored (const DiagView& dl, const DiagView& d, const DiagView& du,
+                              const DataView& x, const int chunk = default_chunk) {
+    check_extents(dl, d, du, x);
+    const int ncol = d.extent_int(1);
+    Kokkos::parallel_for(Kokkos::RangePolicy<ExecSpace>(0, num_chunks(ncol,chunk)),
+                         KOKKOS_LAMBDA(const int ic) {
+      solve_factored_cols(dl, d, du, x, ic*chunk, chunk_end(ic,chunk,ncol));
+    });
+  }
+
+private:
+
+  template <typename DiagView, typename DataView>
+  KOKKOS_INLINE_FUNCTION
+  static void back_substitute_cols (const DiagView& d, const DiagView& du, const DataView& x,
+                                    const int col_beg, const int col_end) {
+    const int nrow = d.extent_int(0);
+    for (int c = col_beg; c < col_end; ++c) {
+      x(nrow-1,c) /= d(nrow-1,c);
+    }
+    for (int k = nrow-1; k > 0; --k) {
+      for (int c = col_beg; c < col_end; ++c) {
+        x(k-1,c) = (x(k-1,c) - du(k-1,c) * x(k,c)) / d(k-1,c);
+      }
+    }
+  }
+
+  static int num_chunks (const int ncol, const int chunk) {
+    assert (chunk > 0);
+    return (ncol + chunk - 1) / chunk;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  static int chunk_end (const int ic, const int chunk, const int ncol) {
+    return (ic+1)*chunk < ncol ? (ic+1)*chunk : ncol;
+  }
+
+  template <typename DiagView, typename DataView>
+  static void check_extents (const DiagView& dl, const DiagView& d, const DiagView& du,
+                             const DataView& x) {
+    static_assert(DiagView::rank == 2 && DataView::rank == 2,
+                  "BatchedTridiag expects views of extents (nrow, ncol).");
+    assert(dl.extent_int(0) == d.extent_int(0) && dl.extent_int(1) == d.extent_int(1));
+    assert(du.extent_int(0) == d.extent_int(0) && du.extent_int(1) == d.extent_int(1));
+    assert( x.extent_int(0) == d.extent_int(0) &&  x.extent_int(1) == d.extent_int(1));
+    (void) dl; (void) du; (void) x;
+  }
+};
+
+} // namespace Homme
+
+#endif // HOMMEXX_BATCHED_TRIDIAG_HPP
@@ -92,6 +92,7 @@ struct CaarFunctorImpl {
   const bool          m_theta_hydrostatic_mode;
   const AdvectionForm m_theta_advection_form;
   const bool          m_pgrad_correction;
+  const bool          m_overlap_exchange;
 
   HybridVCoord          m_hvcoord;
   ElementsState         m_state;
@@ -117,6 +118,16 @@ struct CaarFunctorImpl {
 
   TeamPolicyType<TagPreExchange>   m_policy_pre;
 
+  // If m_overlap_exchange=true, the pre-exchange loop is split in two: first the
+  // boundary elements (whose data is sent to other ranks), then the interior ones.
+  // The element ids of the current sub-loop are stored in m_elem_ids, which is
+  // empty when looping over all elements.
+  TeamPolicyType<TagPreExchange>   m_policy_pre_boundary;
+  TeamPolicyType<TagPreExchange>   m_policy_pre_interior;
+  ExecViewUnmanaged<const int*>    m_boundary_elems;
+  ExecViewUnmanaged<const int*>    m_interior_elems;
+  ExecViewUnmanaged<const int*>    m_elem_ids;
+
   Kokkos::RangePolicy<ExecSpace, TagPostExchange> m_policy_post;
 
   TeamUtils<ExecSpace> m_tu;
@@ -131,6 +142,7 @@ struct CaarFunctorImpl {
       , m_theta_hydrostatic_mode(params.theta_hydrostatic_mode)
       , m_theta_advection_form(params.theta_adv_form)
       , m_pgrad_correction(params.pgrad_correction)
+      , m_overlap_exchange(params.caar_overlap_exchange)
       , m_hvcoord(hvcoord)
       , m_state(elements.m_state)
       , m_derived(elements.m_derived)
@@ -154,6 +166,7 @@ struct CaarFunctorImpl {
       , m_theta_hydrostatic_mode(params.theta_hydrostatic_mode)
       , m_theta_advection_form(params.theta_adv_form)
       , m_pgrad_correction(params.pgrad_correction)
+      , m_overlap_exchange(params.caar_overlap_exchange)
       , m_policy_pre (Homme::get_default_team_policy<ExecSpace,TagPreExchange>(m_num_elems))
       , m_policy_post (0,num_elems*NP*NP)
       , m_tu(m_policy_pre)
@@ -323,6 +336,20 @@ struct CaarFunctorImpl {
       }
       be.registration_completed();
     }
+
+    if (m_overlap_exchange) {
+      // Use the same team configuration of the full loop, so that the
+      // workspace slots in m_tu are still valid.
+      const auto& conn = *bm_exchange->get_connectivity();
+      m_boundary_elems = conn.get_d_boundary_elems();
+      m_interior_elems = conn.get_d_interior_elems();
+      const int team_size = m_policy_pre.team_size();
+      const int vector_length = m_policy_pre.impl_vector_length();
+      m_policy_pre_boundary = TeamPolicyType<TagPreExchange>(conn.get_num_boundary_elements(),team_size,vector_length);
+      m_policy_pre_interior = TeamPolicyType<TagPreExchange>(conn.get_num_interior_elements(),team_size,vector_length);
+      m_policy_pre_boundary.set_chunk_size(1);
+      m_policy_pre_interior.set_chunk_size(1);
+    }
   }
 
   void set_rk_stage_data (const RKStageData& data) {
@@ -345,18 +372,22 @@ struct CaarFunctorImpl {
 
     profiling_resume();
 
-    GPTLstart("caar compute");
-    int nerr;
-    Kokkos::parallel_reduce("caar loop pre-boundary exchange", m_policy_pre, *this, nerr);
-    Kokkos::fence();
-    GPTLstop("caar compute");
-    if (nerr > 0)
-      check_print_abort_on_bad_elems("CaarFunctorImpl::run TagPreExchange", data.n0);
+    if (m_overlap_exchange) {
+      run_pre_exchange_overlapped(data);
+    } else {
+      GPTLstart("caar compute");
+      int nerr;
+      Kokkos::parallel_reduce("caar loop pre-boundary exchange", m_policy_pre, *this, nerr);
+      Kokkos::fence();
+      GPTLstop("caar compute");
+      if (nerr > 0)
+        check_print_abort_on_bad_elems("CaarFunctorImpl::run TagPreExchange", data.n0);
 
-    GPTLstart("caar_bexchV");
-    m_bes[data.np1]->exchange(m_geometry.m_rspheremp);
-    Kokkos::fence();
-    GPTLstop("caar_bexchV");
+      GPTLstart("caar_bexchV");
+      m_bes[data.np1]->exchange(m_geometry.m_rspheremp);
+      Kokkos::fence();
+      GPTLstop("caar_bexchV");
+    }
 
     if (!m_theta_hydrostatic_mode) {
       GPTLstart("caar compute");
@@ -370,12 +401,58 @@ struct CaarFunctorImpl {
     profiling_pause();
   }
 
+  // Compute boundary elements, start sending their data, and compute the
+  // interior elements while the messages are in flight.
+  void run_pre_exchange_overlapped (const RKStageData& data)
+  {
+    auto& be = *m_bes[data.np1];
+    int nerr = 0;
+
+    GPTLstart("caar compute");
+    if (m_policy_pre_boundary.league_size()>0) {
+      int nerr_b;
+      m_elem_ids = m_boundary_elems;
+      Kokkos::parallel_reduce("caar loop pre-boundary exchange (boundary elems)", m_policy_pre_boundary, *this, nerr_b);
+      Kokkos::fence();
+      nerr += nerr_b;
+    }
+    GPTLstop("caar compute");
+
+    GPTLstart("caar_bexchV");
+    be.pack_and_send_shared();
+    GPTLstop("caar_bexchV");
+
+    GPTLstart("caar compute");
+    if (m_policy_pre_interior.league_size()>0) {
+      int nerr_i;
+      m_elem_ids = m_interior_elems;
+      Kokkos::parallel_reduce("caar loop pre-boundary exchange (interior elems)", m_policy_pre_interior, *this, nerr_i);
+      Kokkos::fence();
+      nerr += nerr_i;
+    }
+    m_elem_ids = ExecViewUnmanaged<const int*>();
+    GPTLstop("caar compute");
+
+    GPTLstart("caar_bexchV");
+    be.pack_local();
+    be.recv_and_unpack(m_geometry.m_rspheremp);
+    Kokkos::fence();
+    GPTLstop("caar_bexchV");
+
+    if (nerr > 0)
+      check_print_abort_on_bad_elems("CaarFunctorImpl::run TagPreExchange", data.n0);
+  }
+
   KOKKOS_INLINE_FUNCTION
   void operator()(const TagPreExchange&, const TeamMember &team, int& nerr) const {
     // In this body, we use '====' to separate sync epochs (delimited by barriers)
     // Note: make sure the same temp is not used within each epoch!
 
     KernelVariables kv(team, m_tu);
+    if (m_elem_ids.extent_int(0)>0) {
+      // We are looping over a subset of the elements (see run_pre_exchange_overlapped)
+      kv.ie = m_elem_ids(kv.ie);
+    }
 
     // =========== EPOCH 1 =========== //
     compute_div_vdp(kv);
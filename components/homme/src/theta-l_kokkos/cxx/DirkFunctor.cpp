@@ -7,11 +7,13 @@
 #include "DirkFunctor.hpp"
 #include "DirkFunctorImpl.hpp"
 #include "Context.hpp"
+#include "mpi/Comm.hpp"
 
 #include "profiling.hpp"
 
 #include <assert.h>
 #include <type_traits>
+#include <vector>
 
 namespace Homme {
 
@@ -41,4 +43,38 @@ void DirkFunctor::run (int nm1, Real alphadt_nm1, int n0, Real alphadt_n0, int n
   GPTLstop("compute_stage_value_dirk");
 }
 
+void DirkFunctor::set_newton_options (const bool adaptive, const bool reuse_jacobian) {
+  m_dirk_impl->set_newton_options(adaptive, reuse_jacobian);
+}
+
+void DirkFunctor::print_newton_stats (std::ostream& out) {
+  if ( ! (m_dirk_impl->m_adaptive_newton || m_dirk_impl->m_reuse_jacobian)) return;
+
+  const auto stats = m_dirk_impl->get_newton_stats();
+  m_dirk_impl->reset_newton_stats();
+
+  const auto& comm = Context::singleton().get<Comm>();
+  const int n = stats.iter_hist.size();
+  std::vector<int> hist(n);
+  int num_factorizations;
+  MPI_Reduce(stats.iter_hist.data(), hist.data(), n, MPI_INT, MPI_SUM, 0, comm.mpi_comm());
+  MPI_Reduce(&stats.num_factorizations, &num_factorizations, 1, MPI_INT, MPI_SUM, 0, comm.mpi_comm());
+  if ( ! comm.root()) return;
+
+  long long ncols = 0, niters = 0;
+  for (int it = 0; it < n; ++it) {
+    ncols  += hist[it];
+    niters += static_cast<long long>(it)*hist[it];
+  }
+  if (ncols > 0) {
+    out << "DIRK Newton iterations per column:\n";
+    for (int it = 0; it < n; ++it) {
+      if (hist[it] == 0) continue;
+      out << "  " << it << (it == n-1 ? "+" : "") << ": " << hist[it] << "\n";
+    }
+    out << "  avg: " << static_cast<double>(niters)/ncols << "\n";
+  }
+  out << "DIRK Jacobian factorizations: " << num_factorizations << "\n";
+}
+
 } // Namespace Homme
@@ -9,6 +9,7 @@
 
 #include "Types.hpp"
 #include <memory>
+#include <ostream>
 
 namespace Homme {
 
@@ -32,6 +33,16 @@ public:
   void run(int nm1, Real alphadt_nm1, int n0, Real alphadt_n0, int np1, Real dt2,
            const Elements& elements, const HybridVCoord& hvcoord);
 
+  // Enable per-column convergence tracking in the Newton iteration, and/or
+  // the reuse of the Jacobian factorization across iterations and calls.
+  void set_newton_options(const bool adaptive, const bool reuse_jacobian);
+
+  // Print the histogram of the Newton iterations of all the columns (adaptive
+  // mode) and the number of Jacobian factorizations since the last call, and
+  // reset them. Collective on the Context's Comm; only root prints. Does nothing
+  // if neither the adaptive Newton iteration nor the Jacobian reuse is enabled.
+  void print_newton_stats(std::ostream& out);
+
 private:
   std::unique_ptr<DirkFunctorImpl> m_dirk_impl;
 };
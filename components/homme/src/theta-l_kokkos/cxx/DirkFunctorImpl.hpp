@@ -18,8 +18,10 @@
 #include "profiling.hpp"
 #include "ErrorDefs.hpp"
 #include "utilities/scream_tridiag.hpp"
+#include "utilities/BatchedTridiag.hpp"
 
 #include <cassert>
+#include <vector>
 
 namespace Homme {
 
@@ -32,6 +34,7 @@ struct DirkFunctorImpl {
   enum : int { num_phys_lev = NUM_PHYSICAL_LEV };
   enum : int { num_work = 12 };
   enum : bool { calc_initial_guess_in_newton_kernel = false };
+  enum : int { newton_maxiter = 20 };
 
   enum : int {
 #ifdef HOMMEXX_BFB_TESTING
@@ -66,6 +69,11 @@ struct DirkFunctorImpl {
                    Kokkos::LayoutRight, ExecSpace,
                    Kokkos::MemoryTraits<Kokkos::Unmanaged> >;
 
+  // Jacobian factors of each element, stored across calls if reuse is enabled.
+  using JacobianFactors
+    = Kokkos::View<Scalar*[3][num_phys_lev][npack],
+                   Kokkos::LayoutRight, ExecSpace>;
+
   KOKKOS_INLINE_FUNCTION
   static WorkSlot get_work_slot (const Work& w, const int& wi, const int& si) {
     using Kokkos::subview;
@@ -83,11 +91,53 @@ struct DirkFunctorImpl {
     return subview(w, wi, si, a, a);
   }
 
+  KOKKOS_INLINE_FUNCTION
+  static LinearSystemSlot get_jac_slot (const JacobianFactors& j, const int& ie,
+                                        const int& si) {
+    using Kokkos::subview;
+    using Kokkos::ALL;
+    const auto a = ALL();
+    return subview(j, ie, si, a, a);
+  }
+
+  // Pack mask that selects all the packs. The Newton iteration kernels take a
+  // pack mask, to skip the packs whose columns have all converged.
+  struct AllPacks {
+    KOKKOS_INLINE_FUNCTION bool operator() (const int) const { return true; }
+  };
+
+  // Newton iteration counts of the columns (adaptive mode only). Entry it
+  // is the number of columns that converged in it iterations, while entry
+  // newton_maxiter also counts the columns that did not converge. The
+  // factorizations are counted in adaptive and Jacobian-reuse modes.
+  struct NewtonStats {
+    std::vector<int> iter_hist;
+    int num_factorizations = 0;
+  };
+
   Work m_work;
   LinearSystem m_ls;
   TeamPolicy m_policy, m_ig_policy;
   TeamUtils<ExecSpace> m_tu, m_tu_ig;
   int nslot;
+  int m_nelem;
+
+  // In adaptive mode, each column is retired from the Newton iteration as soon
+  // as its own increment is below tolerance, rather than when the increments of
+  // all the columns of the element are. The packs whose columns are all retired
+  // are skipped in the rest of the iteration.
+  bool m_adaptive_newton = false;
+  // If true, the Jacobian factorization is kept across Newton iterations and
+  // calls with the same dt2, and recomputed only if the residual does not
+  // decrease enough.
+  bool m_reuse_jacobian = false;
+  // Max number of Newton iterations. Unit tests lower it to stop the iteration early.
+  int m_maxiter = newton_maxiter;
+  JacobianFactors m_jac;
+  Real m_jac_dt2 = 0;
+  Kokkos::View<int*, ExecSpace> m_jac_valid;
+  Kokkos::View<int*, ExecSpace> m_iter_hist;
+  Kokkos::View<int, ExecSpace> m_num_factorizations;
 
   DirkFunctorImpl (const int nelem)
     : m_policy(1,1,1), m_ig_policy(1,1,1), m_tu(m_policy), m_tu_ig(m_ig_policy) // throwaway settings
@@ -96,6 +146,7 @@ struct DirkFunctorImpl {
   }
 
   void init (const int nelem) {
+    m_nelem = nelem;
     if (OnGpu<ExecSpace>::value) {
       ThreadPreferences tp;
       tp.max_threads_usable = NUM_PHYSICAL_LEV;
@@ -136,6 +187,43 @@ struct DirkFunctorImpl {
     m_ls = LinearSystem(mem, nslot);
   }
 
+  void set_newton_options (const bool adaptive, const bool reuse_jacobian) {
+    m_adaptive_newton = adaptive;
+    m_reuse_jacobian = reuse_jacobian;
+    if ((m_adaptive_newton || m_reuse_jacobian) && m_iter_hist.size() == 0) {
+      m_iter_hist = decltype(m_iter_hist)("DIRK Newton iterations histogram", newton_maxiter+1);
+      m_num_factorizations = decltype(m_num_factorizations)("DIRK Jacobian factorizations");
+    }
+    // The factors must persist across calls, so they cannot live in the
+    // functors buffers, which are shared with other functors.
+    if (m_reuse_jacobian && m_jac.size() == 0) {
+      m_jac = JacobianFactors("DIRK Jacobian factors", m_nelem);
+      m_jac_valid = decltype(m_jac_valid)("DIRK Jacobian factors valid", m_nelem);
+    }
+    if (m_reuse_jacobian) {
+      // Elements' states may have been reset
+      Kokkos::deep_copy(m_jac_valid, 0);
+    }
+  }
+
+  // Retrieve the Newton stats accumulated since the last reset (adaptive and
+  // Jacobian-reuse modes only).
+  NewtonStats get_newton_stats () const {
+    NewtonStats stats;
+    if ( ! (m_adaptive_newton || m_reuse_jacobian)) return stats;
+    const auto hist = Kokkos::create_mirror_view(m_iter_hist);
+    Kokkos::deep_copy(hist, m_iter_hist);
+    stats.iter_hist.assign(hist.data(), hist.data()+hist.size());
+    Kokkos::deep_copy(stats.num_factorizations, m_num_factorizations);
+    return stats;
+  }
+
+  void reset_newton_stats () {
+    if ( ! (m_adaptive_newton || m_reuse_jacobian)) return;
+    Kokkos::deep_copy(m_iter_hist, 0);
+    Kokkos::deep_copy(m_num_factorizations, 0);
+  }
+
   void run (int nm1, Real alphadt_nm1, int n0, Real alphadt_n0, int np1, Real dt2,
             const Elements& e, const HybridVCoord& hvcoord,
             const bool bfb_solver = default_bfb_solver) {
@@ -207,7 +295,8 @@ struct DirkFunctorImpl {
 
     const auto grav = PhysicalConstants::g;
     const int nvec = npack;
-    const int maxiter = 20;
+    const int maxiter = m_maxiter;
+    assert(maxiter > 0 && maxiter <= newton_maxiter);
 #ifdef HOMMEXX_BFB_TESTING
     const Real deltatol = 1e-6; // In bfb testing, use coarse tolerance, due to zeroulp calls
 #else
@@ -226,6 +315,19 @@ struct DirkFunctorImpl {
     const auto e_initial_guess = e.m_derived.m_divdp_proj;
     const auto hybi = hvcoord.hybrid_bi;
     const auto tu   = m_tu;
+    const bool adaptive = m_adaptive_newton;
+    const bool reuse_jac = m_reuse_jacobian;
+    const auto jac = m_jac;
+    const auto jac_valid = m_jac_valid;
+    const auto iter_hist = m_iter_hist;
+    const auto num_factorizations = m_num_factorizations;
+
+    if (reuse_jac && dt2 != m_jac_dt2) {
+      // The Jacobian scales with dt2^2: factors computed for another dt2 cannot
+      // be used, not even for the first iteration.
+      Kokkos::deep_copy(m_jac_valid, 0);
+      m_jac_dt2 = dt2;
+    }
 
     const auto toplevel = KOKKOS_LAMBDA (const MT& team, int& nerr) {
       KernelVariables kv(team, tu);
@@ -339,30 +441,85 @@ struct DirkFunctorImpl {
 
       loop_ki(kv, nlev, nvec, [&] (int k, int i) { dphi_n0(k,i) = phi_n0(k+1,i) - phi_n0(k,i); });
 
+      // In adaptive mode, active(0,i)[s] is 1 if column s of pack i is still
+      // iterating, 0 otherwise, and active(1,i)[0] is 1 if any column of pack i
+      // is. The packs with no active column are skipped.
+      const auto active = get_ls_slot(ls, kv.team_idx, 3);
+      if (adaptive) {
+        loop_ki(kv, 2, nvec, [&] (int k, int i) { active(k,i) = 1; });
+        kv.team_barrier();
+      }
+      const auto pack_on = [&] (const int i) { return ! adaptive || active(1,i)[0] != 0; };
+      Real rnorm_prev = 0;
+
       int it = 0;
       Real deltaerr;
       for (; it < maxiter; ++it) { // Newton iteration
         const bool ok = pnh_and_exner_from_eos(kv, hvcoord, vtheta_dp, dp3d,
-                                               dphi, pnh, wrk, dpnh_dp_i);
+                                               dphi, pnh, wrk, dpnh_dp_i, nlev, pack_on);
         if ( ! ok) nerr = 1;
         kv.team_barrier();
         loop_ki(kv, nlev, nvec, [&] (const int k, const int i) {
+          if ( ! pack_on(i)) return;
           x(k,i) = -(w_np1(k,i) - (w_n0(k,i) + grav*dt2*(dpnh_dp_i(k,i) - 1))); // -residual
+          // Retired columns of an active pack have a zero RHS, hence a zero increment.
+          if (adaptive) x(k,i) *= active(0,i);
         });
 
-        calc_jacobian(kv, dt2, dp3d, dphi, pnh, dl, d, du);
-        kv.team_barrier();
-        if (bfb_solver) solvebfb(kv, dl, d, du, x); else solve(kv, dl, d, du, x);
+        if (reuse_jac) {
+          // Use the stored factors, unless there are none, or the residual did
+          // not decrease enough with them.
+          const auto jdl = get_jac_slot(jac, ie, 0),
+                     jd  = get_jac_slot(jac, ie, 1),
+                     jdu = get_jac_slot(jac, ie, 2);
+          kv.team_barrier();
+          const Real rnorm = calc_maxabs(kv, nlev, nvec, x);
+          const bool refactor = jac_valid(ie) == 0 ||
+                                (it > 0 && rnorm > jacobian_refactor_ratio*rnorm_prev);
+          rnorm_prev = rnorm;
+          kv.team_barrier();
+          if (refactor) {
+            calc_jacobian(kv, dt2, dp3d, dphi, pnh, jdl, jd, jdu, nlev, pack_on);
+            kv.team_barrier();
+            factorize(kv, jdl, jd, jdu, pack_on);
+            kv.team_barrier();
+            Kokkos::single(Kokkos::PerTeam(kv.team), [&] () {
+              jac_valid(ie) = 1;
+              Kokkos::atomic_add(&num_factorizations(), 1);
+            });
+          }
+          solve_factored(kv, jdl, jd, jdu, x, pack_on);
+        } else {
+          calc_jacobian(kv, dt2, dp3d, dphi, pnh, dl, d, du, nlev, pack_on);
+          kv.team_barrier();
+          if (adaptive) {
+            // Solve pack by pack, skipping the retired ones. This is BFB with solvebfb.
+            factorize(kv, dl, d, du, pack_on);
+            kv.team_barrier();
+            solve_factored(kv, dl, d, du, x, pack_on);
+          } else if (bfb_solver) {
+            solvebfb(kv, dl, d, du, x);
+          } else {
+            solve(kv, dl, d, du, x);
+          }
+          if (adaptive) {
+            Kokkos::single(Kokkos::PerTeam(kv.team), [&] () {
+              Kokkos::atomic_add(&num_factorizations(), 1);
+            });
+          }
+        }
         kv.team_barrier();
 
         loop_ki(kv, 1, nvec, [&] (int k, int i) { wrk(2,i) = 1; });
         kv.team_barrier();
         for (int nsafe = 0; nsafe < 2; ++nsafe) {
           loop_ki(kv, nlev-1, nvec, [&] (int k, int i) {
+            if ( ! pack_on(i)) return;
             dphi(k,i) = dphi_n0(k,i) + dt2*grav*(         (w_np1(k+1,i) - w_np1(k,i)) +
                                                  wrk(2,i)*(    x(k+1,i) -     x(k,i)));
           });
           loop_ki(kv, 1, nvec, [&] (int, int i) {
+            if ( ! pack_on(i)) return;
             const auto k = nlev-1;
             dphi(k,i) = dphi_n0(k,i) - dt2*grav*(w_np1(k,i) + wrk(2,i)*x(k,i));
           });
@@ -375,12 +532,24 @@ struct DirkFunctorImpl {
         }
         kv.team_barrier();
 
-        loop_ki(kv, nlev, nvec, [&] (int k, int i) { w_np1(k,i) += wrk(2,i)*x(k,i); });
+        loop_ki(kv, nlev, nvec, [&] (int k, int i) {
+          if ( ! pack_on(i)) return;
+          w_np1(k,i) += wrk(2,i)*x(k,i);
+        });
 
+        if (adaptive) {
+          retire_converged_columns(kv, nlev, wmax, deltatol, x, it+1, active, iter_hist);
+          kv.team_barrier();
+        }
         if (exit_on_step(kv, nlev, nvec, wmax, deltatol, x, deltaerr)) break;
       } // Newton iteration
       kv.team_barrier();
 
+      if (adaptive && it >= maxiter) {
+        // Count the columns that did not converge in the last bin.
+        retire_converged_columns(kv, nlev, wmax, -1, x, maxiter, active, iter_hist);
+      }
+
       if (it >= maxiter) {
         Kokkos::printf("[DIRK] WARNING! Newton reached max iteration count,"
                        " with deltaerr = %3.17f\n", deltaerr);
@@ -553,7 +722,7 @@ struct DirkFunctorImpl {
     parallel_for(TeamThreadRange(kv.team, nlev-1), f2);
   }
 
-  template <typename R, typename W, typename Wi>
+  template <typename R, typename W, typename Wi, typename PackMask = AllPacks>
   KOKKOS_INLINE_FUNCTION
   static bool pnh_and_exner_from_eos (
     const KernelVariables& kv, const HybridVCoord& hvcoord,
@@ -561,7 +730,9 @@ struct DirkFunctorImpl {
     const R& vtheta_dp, const R& dp3d, const R& dphi,
     // exner is workspace. dpnh_dp_i(nlevp,:) is not computed.
     const W& pnh, const W& exner, const Wi& dpnh_dp_i,
-    const int nlev = NUM_PHYSICAL_LEV)
+    const int nlev = NUM_PHYSICAL_LEV,
+    // Packs i for which pack_on(i) is false are skipped.
+    const PackMask& pack_on = PackMask())
   {
     using Kokkos::parallel_for;
 
@@ -572,6 +743,7 @@ struct DirkFunctorImpl {
     // Compute pnh(1:nlev,:). pnh(nlevp,:) is not needed.
     const auto f1 = [&] (const int k) {
       const auto g = [&] (const int i) {
+        if ( ! pack_on(i)) return;
         for (int s = 0; s < ns; ++s)
           if (vtheta_dp(k,i)[s] < 0 || dphi(k,i)[s] > 0) ok = false;
         EquationOfState::compute_pnh_and_exner(
@@ -586,6 +758,7 @@ struct DirkFunctorImpl {
     kv.team_barrier(); // wait for pnh
     const auto f2 = [&] (const int) {
       const auto k0 = [&] (const int i) {
+        if ( ! pack_on(i)) return;
         const auto pnh_i_0 = hvcoord.hybrid_ai0*hvcoord.ps0; // hydrostatic ptop
         dpnh_dp_i(0,i) = 2*(pnh(0,i) - pnh_i_0)/dp3d(0,i);
       };
@@ -597,6 +770,7 @@ struct DirkFunctorImpl {
       // gnu and std=c++14. The macro ConstExceptGnu is defined in share/cxx/Config.hpp.
       ConstExceptGnu auto k = km1 + 1;
       const auto kr = [&] (const int i) {
+        if ( ! pack_on(i)) return;
         dpnh_dp_i(k,i) = ((pnh(k,i) - pnh(k-1,i))/
                           ((dp3d(k-1,i) + dp3d(k,i))/2));
       };
@@ -651,16 +825,18 @@ struct DirkFunctorImpl {
     }    
   }
 
+  // Max of |a(k,i)[s]| over the first nlev levels of all the columns.
+  template <typename V>
   KOKKOS_INLINE_FUNCTION
-  static Real calc_wmax (const KernelVariables& kv, const int nlev, const int nvec,
-                         const WorkSlot& w) {
+  static Real calc_maxabs (const KernelVariables& kv, const int nlev, const int nvec,
+                           const V& a) {
     using Kokkos::parallel_reduce;
     using Kokkos::TeamThreadRange;
     using Kokkos::ThreadVectorRange;
 
     const auto f = [&] (int k, Real& maxval) {
       const auto g = [&] (int i, Real& lmaxval) {
-        const auto v = w(k,i);
+        const auto v = a(k,i);
         for (int s = 0; s < packn; ++s) {
           if (scaln % packn != 0 && i*packn + s >= scaln) break;
           lmaxval = max(lmaxval, std::abs(v[s]));
@@ -671,36 +847,24 @@ struct DirkFunctorImpl {
       parallel_reduce(vr, g, Kokkos::Max<Real>(lmaxval));
       maxval = max(maxval, lmaxval); // benign write race
     };
-    Real wmax;
+    Real maxabs;
     const auto tr = TeamThreadRange(kv.team, nlev);
-    parallel_reduce(tr, f, Kokkos::Max<Real>(wmax));
-    return max(1.0, wmax);
+    parallel_reduce(tr, f, Kokkos::Max<Real>(maxabs));
+    return maxabs;
+  }
+
+  KOKKOS_INLINE_FUNCTION
+  static Real calc_wmax (const KernelVariables& kv, const int nlev, const int nvec,
+                         const WorkSlot& w) {
+    return max(1.0, calc_maxabs(kv, nlev, nvec, w));
   }
 
   KOKKOS_INLINE_FUNCTION
   static bool exit_on_step (const KernelVariables& kv, const int nlev, const int nvec,
                             const Real& wmax, const Real& deltatol,
                             const LinearSystemSlot& x, Real& deltaerr) {
-    using Kokkos::parallel_reduce;
-    using Kokkos::TeamThreadRange;
-    using Kokkos::ThreadVectorRange;
-
     // deltaerr = maxval(abs(x) / wmax
-    const auto f = [&] (int k, Real& maxval) {
-      const auto g = [&] (int i, Real& lmaxval) {
-        const auto v = x(k,i);
-        for (int s = 0; s < packn; ++s) {
-          if (scaln % packn != 0 && i*packn + s >= scaln) break;
-          lmaxval = max(lmaxval, std::abs(v[s]));
-        }
-      };
-      Real lmaxval;
-      const auto vr = ThreadVectorRange(kv.team, nvec);
-      parallel_reduce(vr, g, Kokkos::Max<Real>(lmaxval));
-      maxval = max(maxval, lmaxval); // benign write race
-    };
-    const auto tr = TeamThreadRange(kv.team, nlev);
-    parallel_reduce(tr, f, Kokkos::Max<Real>(deltaerr));
+    deltaerr = calc_maxabs(kv, nlev, nvec, x);
     return deltaerr/wmax < deltatol;
   }
 
@@ -710,13 +874,15 @@ struct DirkFunctorImpl {
 
      This code will need to change when the equation of state is changed.
   */
-  template <typename R, typename W>
+  template <typename R, typename W, typename PackMask = AllPacks>
   KOKKOS_INLINE_FUNCTION
   static void calc_jacobian (const KernelVariables& kv, const Real& dt2,
                              // All arrays are in DIRK format.
                              const R& dp3d, const R& dphi, const R& pnh,
                              const W& dl, const W& d, const W& du,
-                             const int nlev = NUM_PHYSICAL_LEV) {
+                             const int nlev = NUM_PHYSICAL_LEV,
+                             // Packs i for which pack_on(i) is false are skipped.
+                             const PackMask& pack_on = PackMask()) {
     using Kokkos::parallel_for;
 
     const int n = npack;
@@ -727,6 +893,7 @@ struct DirkFunctorImpl {
 
     const auto f1 = [&] (const int) {
       const auto ks = [&] (const int i) { // first Jacobian row
+        if ( ! pack_on(i)) return;
         const int k = 0;
         const auto b = a/dp3d(k,i);
         du(k,i) = 2*b*(pnh(k,i)/dphi(k,i));
@@ -740,6 +907,7 @@ struct DirkFunctorImpl {
       // gnu and std=c++14. The macro ConstExceptGnu is defined in share/cxx/Config.hpp.
       ConstExceptGnu  auto k = km1 + 1;
       const auto kmid = [&] (const int i) { // middle Jacobian rows
+        if ( ! pack_on(i)) return;
         const auto b = 2*a/(dp3d(k-1,i) + dp3d(k,i));
         dl(k,i) = b*(pnh(k-1,i)/dphi(k-1,i));
         du(k,i) = b*(pnh(k  ,i)/dphi(k  ,i));
@@ -756,6 +924,7 @@ struct DirkFunctorImpl {
     parallel_for(Kokkos::TeamThreadRange(kv.team, nlev-2), f2);
     const auto f3 = [&] (const int) {
       const auto ke = [&] (const int i) { // last Jacobian row
+        if ( ! pack_on(i)) return;
         const int k = nlev-1;
         const auto b = 2*a/(dp3d(k-1,i) + dp3d(k,i));
         dl(k,i) = b*(pnh(k-1,i)/dphi(k-1,i));
@@ -787,6 +956,76 @@ struct DirkFunctorImpl {
     scream::tridiag::bfb(kv.team, dl, d, du, x);
   }
 
+  // Factorize the Jacobian in place, and solve with the factors. These perform
+  // the same operations as solvebfb. Packs i for which pack_on(i) is false are
+  // skipped.
+  template <typename W, typename PackMask = AllPacks>
+  KOKKOS_INLINE_FUNCTION
+  static void factorize (const KernelVariables& kv,
+                         const W& dl, const W& d, const W& du,
+                         const PackMask& pack_on = PackMask()) {
+    assert(d.extent_int(0) == num_phys_lev);
+    const auto f = [&] (const int i) {
+      if (pack_on(i)) BatchedTridiag::factorize_cols(dl, d, du, i, i+1);
+    };
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(kv.team, npack), f);
+  }
+
+  template <typename W, typename PackMask = AllPacks>
+  KOKKOS_INLINE_FUNCTION
+  static void solve_factored (const KernelVariables& kv,
+                              const W& dl, const W& d, const W& du, const W& x,
+                              const PackMask& pack_on = PackMask()) {
+    assert(d.extent_int(0) == num_phys_lev);
+    const auto f = [&] (const int i) {
+      if (pack_on(i)) BatchedTridiag::solve_factored_cols(dl, d, du, x, i, i+1);
+    };
+    Kokkos::parallel_for(Kokkos::TeamVectorRange(kv.team, npack), f);
+  }
+
+  // Reusing the Jacobian, refactorize if the residual norm is not reduced by at
+  // least this factor in one Newton iteration.
+  static constexpr Real jacobian_refactor_ratio = 0.25;
+
+  // Retire the active columns whose increment satisfies the exit criterion,
+  // and count them in the iterations histogram. Then flag the packs that still
+  // have an active column in active(1,:).
+  KOKKOS_INLINE_FUNCTION
+  static void retire_converged_columns (const KernelVariables& kv, const int nlev,
+                                        const Real& wmax, const Real& deltatol,
+                                        const LinearSystemSlot& x, const int niter,
+                                        const LinearSystemSlot& active,
+                                        const Kokkos::View<int*, ExecSpace>& iter_hist) {
+    using Kokkos::parallel_for;
+    using Kokkos::parallel_reduce;
+    using Kokkos::TeamThreadRange;
+    using Kokkos::ThreadVectorRange;
+
+    const auto f = [&] (int idx) {
+      const int i = idx / packn, s = idx % packn;
+      if (active(0,i)[s] == 0) return;
+      const auto g = [&] (int k, Real& lmaxval) { lmaxval = max(lmaxval, std::abs(x(k,i)[s])); };
+      Real colerr;
+      parallel_reduce(ThreadVectorRange(kv.team, nlev), g, Kokkos::Max<Real>(colerr));
+      if (colerr/wmax < deltatol || deltatol < 0) {
+        Kokkos::single(Kokkos::PerThread(kv.team), [&] () {
+          active(0,i)[s] = 0;
+          Kokkos::atomic_add(&iter_hist(niter), 1);
+        });
+      }
+    };
+    parallel_for(TeamThreadRange(kv.team, static_cast<int>(scaln)), f);
+    kv.team_barrier();
+    loop_ki(kv, 1, npack, [&] (int, int i) {
+      Real on = 0;
+      for (int s = 0; s < packn; ++s) {
+        if (scaln % packn != 0 && i*packn + s >= scaln) break;
+        on = max(on, active(0,i)[s]);
+      }
+      active(1,i)[0] = on;
+    });
+  }
+
   // Determine a step length 0 < alpha <= 1.
   KOKKOS_INLINE_FUNCTION static void
   calc_step_size (const KernelVariables& kv, const int nlev, const int nvec,
@@ -47,7 +47,10 @@ void init_simulation_params_c (const int& remap_alg, const int& limiter_option,
                                const int& use_cpstar, const int& transport_alg, const int& theta_hydrostatic_mode, const char** test_case,
                                const int& dt_remap_factor, const int& dt_tracer_factor,
                                const double& scale_factor, const double& laplacian_rigid_factor, const int& nsplit, const int& pgrad_correction,
-                               const double& dp3d_thresh, const double& vtheta_thresh, const int& internal_diagnostics_level)
+                               const double& dp3d_thresh, const double& vtheta_thresh, const int& internal_diagnostics_level,
+                               const int& caar_overlap_exchange, const int& be_neighbor_collectives,
+                               const int& be_fuse_exchanges,
+                               const int& dirk_adaptive_newton, const int& dirk_reuse_jacobian)
 {
 
   // Check that the simulation options are supported. This helps us in the future, since we
@@ -125,6 +128,11 @@ void init_simulation_params_c (const int& remap_alg, const int& limiter_option,
   params.dp3d_thresh                   = dp3d_thresh;
   params.vtheta_thresh                 = vtheta_thresh;
   params.internal_diagnostics_level    = internal_diagnostics_level;
+  params.caar_overlap_exchange         = (bool)caar_overlap_exchange;
+  params.be_neighbor_collectives       = (bool)be_neighbor_collectives;
+  params.be_fuse_exchanges             = (bool)be_fuse_exchanges;
+  params.dirk_adaptive_newton          = (bool)dirk_adaptive_newton;
+  params.dirk_reuse_jacobian           = (bool)dirk_reuse_jacobian;
 
   if (time_step_type==5) {
     //5 stage, 3rd order, explicit
@@ -399,6 +407,7 @@ void init_functors_c (const int& allocate_buffer)
   if (need_dirk) {
     // Create dirk functor only if needed
     c.create_if_not_there<DirkFunctor>(elems.num_elems());
+    c.get<DirkFunctor>().set_newton_options(params.dirk_adaptive_newton, params.dirk_reuse_jacobian);
   }
 
   // If memory in the buffer manager was previously allocated, skip allocation here
@@ -582,6 +591,9 @@ void init_boundary_exchanges_c ()
     bmm[MPI_EXCHANGE_MIN_MAX]->set_connectivity(connectivity);
   }
 
+  // Transport used by all BEs registered below
+  connectivity->set_neighbor_collectives(params.be_neighbor_collectives);
+
   if (params.qsize > 0) {
     if (params.transport_alg == 0) {
       // Euler BEs
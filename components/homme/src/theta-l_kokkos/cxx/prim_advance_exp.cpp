@@ -17,6 +17,8 @@
 
 #include "profiling.hpp"
 
+#include <iostream>
+
 namespace Homme
 {
 
@@ -109,6 +111,10 @@ void prim_advance_exp (TimeLevel& tl, const Real dt, const bool compute_diagnost
   if (compute_diagnostics) {
     auto& diags = context.get<Diagnostics>();
     diags.run_diagnostics(false,4);
+    if ((params.dirk_adaptive_newton || params.dirk_reuse_jacobian) &&
+        context.has<DirkFunctor>()) {
+      context.get<DirkFunctor>().print_newton_stats(std::cout);
+    }
   }
 
   //// case nu=0 but nu_top>0?  
@@ -43,7 +43,7 @@ class ppm_remap_functor_test {
 
 public:
   ppm_remap_functor_test(const int num_elems, const int num_remap)
-      : ne(num_elems), num_remap(num_remap), remap(num_elems, num_remap),
+      : ne(num_elems), num_remap(num_remap), remap(num_elems, num_remap, true),
         src_layer_thickness_kokkos("source layer thickness", num_elems),
         tgt_layer_thickness_kokkos("target layer thickness", num_elems),
         remap_vals("values to remap", num_elems, num_remap) {}
@@ -51,6 +51,7 @@ public:
   struct TagGridTest {};
   struct TagPPMTest {};
   struct TagRemapTest {};
+  struct TagRemapBatchedTest {};
 
   static bool nan_boundaries(
       HostViewUnmanaged<Real * [NP][NP][_ppm_consts::DPO_PHYSICAL_LEV]> host) {
@@ -287,7 +288,7 @@ public:
         generate_grid_intervals(engine, top, "kokkos target layer thickness");
   }
 
-  void test_remap() {
+  void test_remap(const bool batched = false) {
     std::random_device rd;
     const unsigned int catchRngSeed = Catch::rngSeed();
     const unsigned int seed = catchRngSeed==0 ? rd() : catchRngSeed;
@@ -318,8 +319,13 @@ public:
 
     initialize_layers(engine);
 
-    Kokkos::parallel_for(
-        Homme::get_default_team_policy<ExecSpace, TagRemapTest>(ne), *this);
+    if (batched) {
+      Kokkos::parallel_for(
+          Homme::get_default_team_policy<ExecSpace, TagRemapBatchedTest>(ne), *this);
+    } else {
+      Kokkos::parallel_for(
+          Homme::get_default_team_policy<ExecSpace, TagRemapTest>(ne), *this);
+    }
     Kokkos::fence();
 
     const int remap_alg = boundary_cond::fortran_remap_alg;
@@ -376,6 +382,21 @@ public:
     }
   }
 
+  KOKKOS_INLINE_FUNCTION
+  void operator()(const TagRemapBatchedTest &, const TeamMember& team) const {
+    KernelVariables kv(team);
+    remap.compute_grids_phase(
+        kv, Homme::subview(src_layer_thickness_kokkos, kv.ie),
+        Homme::subview(tgt_layer_thickness_kokkos, kv.ie));
+    constexpr int block = _ppm_consts::FIELD_BLOCK;
+    for (int first = 0; first < num_remap; first += block) {
+      const int num_fields = num_remap - first < block ? num_remap - first : block;
+      remap.compute_remap_phase_batched(kv, num_fields, [&](const int i) {
+        return Homme::subview(remap_vals, kv.ie, first + i);
+      });
+    }
+  }
+
   const int ne, num_remap;
   PpmVertRemap<boundary_cond> remap;
   ExecViewManaged<Scalar * [NP][NP][NUM_LEV]> src_layer_thickness_kokkos;
@@ -392,6 +413,14 @@ TEST_CASE("ppm_mirrored", "vertical remap") {
   SECTION("remap") { remap_test_mirrored.test_remap(); }
 }
 
+TEST_CASE("ppm_mirrored_batched", "vertical remap") {
+  // Span more than one block of fields, with a partial last block
+  constexpr int num_elems = 2;
+  constexpr int num_remap = _ppm_consts::FIELD_BLOCK + 3;
+  ppm_remap_functor_test<PpmMirrored> remap_test_mirrored(num_elems, num_remap);
+  remap_test_mirrored.test_remap(true);
+}
+
 
 TEST_CASE("binary_search","binary_search")
 {
@@ -220,6 +220,9 @@ TEST_CASE("caar", "caar_testing") {
   const int rank = comm.rank();
 
   SECTION ("caar_run") {
+    // Alternate between the plain and the overlapped boundary exchange,
+    // so that both code paths are tested (results must be the same).
+    bool overlap_exchange = false;
     for (const bool hydrostatic : {true,false}) {
       if (comm.root()) {
         std::cout << " -> " << (hydrostatic ? "Hydrostatic\n" : "Non-Hydrostatic\n");
@@ -242,6 +245,11 @@ TEST_CASE("caar", "caar_testing") {
             params.theta_adv_form = adv_form;
             params.rsplit = rsplit;
             params.pgrad_correction = (pgrad != 0);
+            params.caar_overlap_exchange = overlap_exchange;
+            overlap_exchange = !overlap_exchange;
+            if (comm.root()) {
+              std::cout << "     -> caar_overlap_exchange = " << params.caar_overlap_exchange << "\n";
+            }
 
             // Generate RK stage data
             Real dt = RPDF(1.0,10.0)(engine);
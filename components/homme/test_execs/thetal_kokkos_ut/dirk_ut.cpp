@@ -2,6 +2,8 @@
 
 #include "DirkFunctorImpl.hpp"
 
+#include <chrono>
+#include <functional>
 #include <random>
 
 #include "Types.hpp"
@@ -15,6 +17,7 @@
 #include "utilities/TestUtils.hpp"
 #include "utilities/SyncUtils.hpp"
 #include "utilities/ViewUtils.hpp"
+#include "utilities/BatchedTridiag.hpp"
 
 using namespace Homme;
 
@@ -580,6 +583,179 @@ TEST_CASE ("dirk_pieces_testing") {
   }
 }
 
+// Fill (dl, d, du) with a random, diagonally dominant, batch of systems, and x with
+// a random RHS. The views have extents (nlev, ncol), as in BatchedTridiag.
+template <typename V>
+static void fill_batched_system (Random& r, const V& dl, const V& d, const V& du, const V& x) {
+  const auto dlm = Kokkos::create_mirror_view(dl);
+  const auto dm  = Kokkos::create_mirror_view(d);
+  const auto dum = Kokkos::create_mirror_view(du);
+  const auto xm  = Kokkos::create_mirror_view(x);
+  for (int k = 0; k < d.extent_int(0); ++k)
+    for (int c = 0; c < d.extent_int(1); ++c)
+      for (int s = 0; s < dfi::packn; ++s) {
+        dlm(k,c)[s] = r.urrng(-1,1);
+        dum(k,c)[s] = r.urrng(-1,1);
+        dm (k,c)[s] = r.urrng(2.5,3);
+        xm (k,c)[s] = r.urrng(-1,1);
+      }
+  Kokkos::deep_copy(dl, dlm); Kokkos::deep_copy(d, dm);
+  Kokkos::deep_copy(du, dum); Kokkos::deep_copy(x, xm);
+}
+
+TEST_CASE ("dirk_batched_tridiag") {
+  using Kokkos::subview;
+  using Kokkos::deep_copy;
+  using Kokkos::ALL;
+  using BV = ExecView<Scalar**>;
+
+  auto& r = Session::singleton().r;
+  const auto eps = std::numeric_limits<Real>::epsilon();
+  const int nlev = dfi::num_phys_lev, npack = dfi::npack;
+
+  // A few elements, and a chunk size that does not divide the number of columns.
+  const int nelem = 3, ncol = nelem*npack, chunk = 2;
+  BV dl("dl",nlev,ncol), d("d",nlev,ncol), du("du",nlev,ncol), x("x",nlev,ncol);
+  fill_batched_system(r, dl, d, du, x);
+
+  BV dl1("dl1",nlev,ncol), d1("d1",nlev,ncol), du1("du1",nlev,ncol), x1("x1",nlev,ncol);
+  BV dl2("dl2",nlev,ncol), d2("d2",nlev,ncol), du2("du2",nlev,ncol), x2("x2",nlev,ncol);
+  for (auto v : {std::make_pair(dl1,dl), std::make_pair(d1,d), std::make_pair(du1,du), std::make_pair(x1,x),
+                 std::make_pair(dl2,dl), std::make_pair(d2,d), std::make_pair(du2,du), std::make_pair(x2,x)}) {
+    deep_copy(v.first, v.second);
+  }
+  BatchedTridiag::solve(dl1, d1, du1, x1, chunk);
+  BatchedTridiag::factorize(dl2, d2, du2, chunk);
+  BatchedTridiag::solve_factored(dl2, d2, du2, x2, chunk);
+  Kokkos::fence();
+  const auto x1m = cmvdc(x1);
+  const auto x2m = cmvdc(x2);
+
+  // Solve each element's systems with the DIRK team solver.
+  dfi dfi1(1);
+  FunctorsBuffersManager fbm;
+  init(dfi1, fbm);
+  const auto ls = dfi1.m_ls;
+  const auto
+    dle = dfi::get_ls_slot(ls, 0, 0),
+    de  = dfi::get_ls_slot(ls, 0, 1),
+    due = dfi::get_ls_slot(ls, 0, 2),
+    xe  = dfi::get_ls_slot(ls, 0, 3);
+  for (int ie = 0; ie < nelem; ++ie) {
+    const auto cols = Kokkos::make_pair(ie*npack, (ie+1)*npack);
+    deep_copy(dle, subview(dl, ALL(), cols));
+    deep_copy(de , subview(d , ALL(), cols));
+    deep_copy(due, subview(du, ALL(), cols));
+    deep_copy(xe , subview(x , ALL(), cols));
+    const auto f = KOKKOS_LAMBDA(const dfi::MT& t) {
+      KernelVariables kv(t);
+      dfi::solvebfb(kv, dle, de, due, xe);
+    };
+    Kokkos::parallel_for(dfi1.m_policy, f); Kokkos::fence();
+    const auto xem = cmvdc(xe);
+
+    // The factored solver performs the same operations as the BFB team solver,
+    // while the single-pass solver is only close to it.
+    for (int k = 0; k < nlev; ++k)
+      for (int p = 0; p < npack; ++p)
+        for (int s = 0; s < dfi::packn; ++s) {
+          REQUIRE(equal(x2m(k,ie*npack+p)[s], xem(k,p)[s], 1e3*eps));
+          REQUIRE(almost_equal(x1m(k,ie*npack+p)[s], xem(k,p)[s], 1e4*eps));
+        }
+  }
+
+  // Reuse the factorization for several RHS.
+  fill_batched_system(r, dl, d, du, x);
+  deep_copy(dl2, dl); deep_copy(d2, d); deep_copy(du2, du);
+  BatchedTridiag::factorize(dl2, d2, du2);
+  for (int irhs = 0; irhs < 2; ++irhs) {
+    if (irhs > 0) fill_batched_system(r, dl1, d1, du1, x);
+    deep_copy(dl1, dl); deep_copy(d1, d); deep_copy(du1, du);
+    deep_copy(x1, x); deep_copy(x2, x);
+    BatchedTridiag::solve(dl1, d1, du1, x1);
+    BatchedTridiag::solve_factored(dl2, d2, du2, x2);
+    Kokkos::fence();
+    const auto x1r = cmvdc(x1);
+    const auto x2r = cmvdc(x2);
+    for (int k = 0; k < nlev; ++k)
+      for (int c = 0; c < ncol; ++c)
+        for (int s = 0; s < dfi::packn; ++s)
+          REQUIRE(almost_equal(x1r(k,c)[s], x2r(k,c)[s], 1e4*eps));
+  }
+}
+
+// Solve the batch of systems (dl, d, du, x), with one DIRK team per element.
+// Element ie's systems are the columns [ie*npack,(ie+1)*npack) of the batch.
+static void team_solve (const dfi::TeamPolicy& policy, const dfi::LinearSystem& ls,
+                        const ExecView<Scalar**>& dl, const ExecView<Scalar**>& d,
+                        const ExecView<Scalar**>& du, const ExecView<Scalar**>& x,
+                        const bool bfb) {
+  const int nlev = dfi::num_phys_lev, npack = dfi::npack;
+  const auto f = KOKKOS_LAMBDA(const dfi::MT& t) {
+    KernelVariables kv(t);
+    const int ie = t.league_rank();
+    Kokkos::parallel_for(Kokkos::TeamThreadRange(t, nlev), [&] (const int k) {
+      for (int p = 0; p < npack; ++p) {
+        ls(ie,0,k,p) = dl(k,ie*npack+p);
+        ls(ie,1,k,p) = d (k,ie*npack+p);
+        ls(ie,2,k,p) = du(k,ie*npack+p);
+        ls(ie,3,k,p) = x (k,ie*npack+p);
+      }
+    });
+    kv.team_barrier();
+    const auto
+      dle = dfi::get_ls_slot(ls, ie, 0),
+      de  = dfi::get_ls_slot(ls, ie, 1),
+      due = dfi::get_ls_slot(ls, ie, 2),
+      xe  = dfi::get_ls_slot(ls, ie, 3);
+    if (bfb) dfi::solvebfb(kv, dle, de, due, xe); else dfi::solve(kv, dle, de, due, xe);
+  };
+  Kokkos::parallel_for(policy, f);
+}
+
+// Compare the cost of the DIRK team solver and of the batched solver. This test
+// is hidden: run it explicitly, e.g. with ./dirk_ut "[batched_tridiag_bench]"
+TEST_CASE ("dirk_batched_tridiag_bench", "[.][batched_tridiag_bench]") {
+  using BV = ExecView<Scalar**>;
+
+  auto& r = Session::singleton().r;
+  const int nlev = dfi::num_phys_lev, npack = dfi::npack;
+  const int nelem = 1000, ncol = nelem*npack, nruns = 20;
+
+  BV dl("dl",nlev,ncol), d("d",nlev,ncol), du("du",nlev,ncol), x("x",nlev,ncol);
+  BV dl0("dl0",nlev,ncol), d0("d0",nlev,ncol), du0("du0",nlev,ncol), x0("x0",nlev,ncol);
+  fill_batched_system(r, dl0, d0, du0, x0);
+
+  dfi de(nelem);
+  const dfi::LinearSystem ls("ls", nelem);
+
+  const auto reset = [&] () {
+    Kokkos::deep_copy(dl, dl0); Kokkos::deep_copy(d, d0);
+    Kokkos::deep_copy(du, du0); Kokkos::deep_copy(x, x0);
+  };
+  const auto time_it = [&] (const char* name, const std::function<void()>& f) {
+    double elapsed = 0;
+    for (int irun = 0; irun < nruns; ++irun) {
+      reset();
+      Kokkos::fence();
+      const auto start = std::chrono::steady_clock::now();
+      f();
+      Kokkos::fence();
+      const auto finish = std::chrono::steady_clock::now();
+      elapsed += std::chrono::duration<double,std::milli>(finish-start).count();
+    }
+    printf(" %-24s: avg time %10.4f ms\n", name, elapsed/nruns);
+  };
+
+  printf(" nelem: %d, nlev: %d, pack size: %d, nruns: %d\n", nelem, nlev, dfi::packn, nruns);
+  // The team solvers timings include copying the batch into the team layout.
+  time_it("team solve",        [&] () { team_solve(de.m_policy, ls, dl, d, du, x, false); });
+  time_it("team solvebfb",     [&] () { team_solve(de.m_policy, ls, dl, d, du, x, true); });
+  time_it("batched solve",     [&] () { BatchedTridiag::solve(dl, d, du, x); });
+  time_it("batched bfb solve", [&] () { BatchedTridiag::factorize(dl, d, du);
+                                        BatchedTridiag::solve_factored(dl, d, du, x); });
+}
+
 static void c2f (const Elements& e) {
   const auto dp3d = cmvdc(e.m_state.m_dp3d);
   const auto w_i = cmvdc(e.m_state.m_w_i);
@@ -848,6 +1024,109 @@ TEST_CASE ("dirk_toplevel_testing") {
                 REQUIRE(almost_equal(p1[k], p2[k], 1e6*eps));
             }
 
+      { // Run C++ with per-column convergence and Jacobian reuse. The second
+        // run starts from the factors of the first one.
+#ifdef HOMMEXX_BFB_TESTING
+        const Real tol = 1e-4; // the Newton tolerance is coarse in BFB testing
+#else
+        const Real tol = 1e-8;
+#endif
+        d.set_newton_options(true, true);
+        d.reset_newton_stats();
+        for (int irun = 0; irun < 2; ++irun) {
+          d.run(nm1, alphadtwt_nm1*dt2, n0, alphadtwt_n0*dt2, np1, dt2,
+                e, hvcoord, false /* non-BFB solver */);
+          fence();
+          const auto w3m = cmvdc(e.m_state.m_w_i);
+          const auto phinh3m = cmvdc(e.m_state.m_phinh_i);
+          deep_copy(e.m_state.m_w_i, w_i);
+          deep_copy(e.m_state.m_phinh_i, phinh_i);
+          for (int ie = 0; ie < nelemd; ++ie)
+            for (int i = 0; i < np; ++i)
+              for (int j = 0; j < np; ++j)
+                for (int f = 0; f < 2; ++f) {
+                  Real* p1 = f == 0 ? &w1m(ie,np1,i,j,0)[0] : &phinh1m(ie,np1,i,j,0)[0];
+                  Real* p3 = f == 0 ? &w3m(ie,np1,i,j,0)[0] : &phinh3m(ie,np1,i,j,0)[0];
+                  for (int k = 0; k < nlev+1; ++k)
+                    REQUIRE(almost_equal(p1[k], p3[k], tol));
+                }
+        }
+        // Each column is counted once per run.
+        const auto stats = d.get_newton_stats();
+        int ncols = 0;
+        for (const auto c : stats.iter_hist) ncols += c;
+        REQUIRE(ncols == 2*nelemd*NP*NP);
+        REQUIRE(stats.num_factorizations >= 1);
+        d.set_newton_options(false, false);
+      }
+
+      { // In adaptive mode, a column that converged keeps its value while the
+        // other columns of its element iterate. Thus, stopping the iteration
+        // after n iterations reproduces exactly at least the columns that
+        // converged in at most n iterations. (The other columns may match, too,
+        // if their last increments are below roundoff.)
+        const auto run_w = [&] () {
+          d.run(nm1, alphadtwt_nm1*dt2, n0, alphadtwt_n0*dt2, np1, dt2,
+                e, hvcoord, false /* non-BFB solver */);
+          fence();
+          const auto wm = cmvdc(e.m_state.m_w_i);
+          deep_copy(e.m_state.m_w_i, w_i);
+          deep_copy(e.m_state.m_phinh_i, phinh_i);
+          return wm;
+        };
+        d.set_newton_options(true, false);
+        d.reset_newton_stats();
+        const auto wfull = run_w();
+        const auto hist = d.get_newton_stats().iter_hist;
+        int nlast = 0;
+        for (int it = 0; it < int(hist.size()); ++it)
+          if (hist[it] > 0) nlast = it;
+        int nconv = 0, nsame_prev = 0;
+        for (int n = 1; n < nlast; ++n) {
+          nconv += hist[n];
+          // Lowering the max iteration count triggers the non-convergence warning.
+          d.m_maxiter = n;
+          const auto wn = run_w();
+          int nsame = 0;
+          for (int ie = 0; ie < nelemd; ++ie)
+            for (int i = 0; i < np; ++i)
+              for (int j = 0; j < np; ++j) {
+                const Real* p1 = &wfull(ie,np1,i,j,0)[0];
+                const Real* pn = &wn(ie,np1,i,j,0)[0];
+                bool same = true;
+                for (int k = 0; k < nlev+1; ++k)
+                  if (p1[k] != pn[k]) same = false;
+                if (same) ++nsame;
+              }
+          REQUIRE(nsame >= nconv);
+          REQUIRE(nsame >= nsame_prev);
+          nsame_prev = nsame;
+        }
+        d.m_maxiter = dfi::newton_maxiter;
+        d.set_newton_options(false, false);
+      }
+
+      { // Reusing the Jacobian, the factors are kept across calls with the same
+        // dt2, and recomputed if dt2 changes. Do one Newton iteration per call,
+        // so that factorizations can occur only in the first iteration.
+        const auto num_factorizations = [&] (const Real dt) {
+          d.reset_newton_stats();
+          d.run(nm1, alphadtwt_nm1*dt, n0, alphadtwt_n0*dt, np1, dt,
+                e, hvcoord, false /* non-BFB solver */);
+          fence();
+          deep_copy(e.m_state.m_w_i, w_i);
+          deep_copy(e.m_state.m_phinh_i, phinh_i);
+          return d.get_newton_stats().num_factorizations;
+        };
+        d.set_newton_options(false, true);
+        d.m_maxiter = 1;
+        REQUIRE(num_factorizations(dt2) == nelemd);
+        REQUIRE(num_factorizations(dt2) == 0);
+        REQUIRE(num_factorizations(0.9*dt2) == nelemd);
+        d.m_maxiter = dfi::newton_maxiter;
+        d.set_newton_options(false, false);
+      }
+
       // Run F90 with BFB solver.
       c2f(e);
       compute_stage_value_dirk_f90(nm1+1, alphadtwt_nm1*dt2, n0+1, alphadtwt_n0*dt2, np1+1, dt2);